@@ -6,6 +6,20 @@ g++ -o instrument-panel -w -DNoKnobs -I . -I instruments \
     globals.cpp \
     knobs.cpp \
     instrument.cpp \
+    softBlend.cpp \
+    softBlendKernels.cpp \
+    rotationCache.cpp \
+    qualityGovernor.cpp \
+    instrumentFactory.cpp \
+    alerts.cpp \
+    derivedVars.cpp \
+    aircraftRegistry.cpp \
+    numericDisplay.cpp \
+    calibration.cpp \
+    calibrationTables.cpp \
+    smoother.cpp \
+    latency.cpp \
+    jsonParser.cpp \
     instruments/adf.cpp \
     instruments/adi.cpp \
     instruments/alt.cpp \
@@ -21,7 +35,7 @@ g++ -o instrument-panel -w -DNoKnobs -I . -I instruments \
     instruments/rpm.cpp \
     instruments/tc.cpp \
     instruments/trimFlaps.cpp \
-    instruments/vac.cpp \
+    instruments/gauge.cpp \
     instruments/vor1.cpp \
     instruments/vor2.cpp \
     instruments/vsi.cpp \
@@ -29,7 +43,6 @@ g++ -o instrument-panel -w -DNoKnobs -I . -I instruments \
     instruments/alternate/altFast.cpp \
     instruments/alternate/asiFast.cpp \
     instruments/alternate/asiSupersonic.cpp \
-    instruments/alternate/gForce.cpp \
     instruments/alternate/rpmPercent.cpp \
     instruments/alternate/vsiExtreme.cpp \
     instruments/learjet/adiLearjet.cpp \
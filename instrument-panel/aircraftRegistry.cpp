@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aircraftRegistry.h"
+#include "jsonParser.h"
+
+extern globalVars globals;
+
+void showError(const char* msg);
+
+/// <summary>
+/// Aircraft names in the aircraft file that have their own id (same
+/// order as the Aircraft enum). Any other name is OTHER_AIRCRAFT.
+/// </summary>
+static const char* AircraftIds[] = {
+    "Undefined",
+    "No Aircraft",
+    "Cessna 152",
+    "Cessna 172",
+    "Cessna CJ4",
+    "Savage Cub",
+    "Shock Ultra",
+    "Airbus A310",
+    "FBW",
+    "Boeing 747",
+    "Boeing 787",
+    "Spitfire",
+    "F15 Eagle",
+    "F18 Hornet",
+    "Hawker Hunter",
+    "JustFlight PA28",
+    "Kodiak 100",
+    "H135",
+    "Glider",
+    "Ornithopter",
+    NULL
+};
+
+/// <summary>
+/// Returns true if this aircraft should use the fast versions of instruments
+/// </summary>
+bool AircraftTraits::isFast(double cruiseSpeed) const
+{
+    switch (fast) {
+    case FAST_ALWAYS:
+        return true;
+    case FAST_NEVER:
+        return false;
+    default:
+        return cruiseSpeed >= globals.FastAircraftSpeed;
+    }
+}
+
+/// <summary>
+/// Returns the name of the variant the instrument should switch to
+/// for this aircraft or an empty string to use the normal instrument.
+/// </summary>
+const char* AircraftTraits::variant(const char* instrument) const
+{
+    for (auto const& variant : variants) {
+        if (strcmp(variant.instrument, instrument) == 0) {
+            return variant.variant;
+        }
+    }
+
+    return "";
+}
+
+/// <summary>
+/// Each aircraft is a group at level 1 and its traits are at level 2.
+/// Titles and Contains are arrays of strings and Variants is an object
+/// of instrument name to variant name.
+/// </summary>
+class aircraftHandler : public jsonHandler
+{
+private:
+    aircraftRegistry* thisPtr;
+    int traits = -1;
+    char arrayKey[64] = { '\0' };
+    bool inVariants = false;
+
+public:
+    char error[256] = { '\0' };
+
+    aircraftHandler(aircraftRegistry* thisPtr)
+    {
+        this->thisPtr = thisPtr;
+    }
+
+    void startObject(int level, const char* key)
+    {
+        if (level == 1) {
+            traits = thisPtr->addAircraft(key);
+        }
+        else if (level == 2 && traits != -1 && _stricmp(key, "Variants") == 0) {
+            inVariants = true;
+        }
+    }
+
+    void endObject(int level, const char* key)
+    {
+        if (level == 1) {
+            traits = -1;
+        }
+        else if (level == 2) {
+            inVariants = false;
+        }
+    }
+
+    void startArray(int level, const char* key)
+    {
+        if (level == 2) {
+            strncpy(arrayKey, key, 63);
+            arrayKey[63] = '\0';
+        }
+    }
+
+    void endArray(int level, const char* key)
+    {
+        if (level == 2) {
+            arrayKey[0] = '\0';
+        }
+    }
+
+    void value(int level, const char* key, const char* value, JsonType type)
+    {
+        if (traits == -1) {
+            return;
+        }
+
+        AircraftTraits* aircraft = &thisPtr->aircraft[traits];
+
+        if (level == 3 && inVariants) {
+            if (strlen(key) > 63 || strlen(value) > 63) {
+                fail(aircraft->name, "variant name is too long");
+                return;
+            }
+            AircraftVariant variant;
+            strcpy(variant.instrument, key);
+            strcpy(variant.variant, value);
+            aircraft->variants.push_back(variant);
+        }
+        else if (level == 3 && arrayKey[0] != '\0') {
+            if (strlen(value) > 63) {
+                fail(aircraft->name, "title is too long");
+            }
+            else if (_stricmp(arrayKey, "Titles") == 0) {
+                thisPtr->addTitle(value, traits);
+            }
+            else if (_stricmp(arrayKey, "Contains") == 0) {
+                thisPtr->addContains(value, traits);
+            }
+        }
+        else if (level == 2) {
+            if (_stricmp(key, "Fast") == 0) {
+                aircraft->fast = (type != JSON_BOOL) ? FAST_CRUISE_SPEED : (strcmp(value, "true") == 0) ? FAST_ALWAYS : FAST_NEVER;
+            }
+            else if (_stricmp(key, "Supersonic") == 0) {
+                aircraft->supersonic = (strcmp(value, "true") == 0);
+            }
+            else if (_stricmp(key, "Electrics") == 0) {
+                if (_stricmp(value, "Main Bus") == 0) {
+                    aircraft->electrics = ELECTRICS_MAIN_BUS;
+                }
+                else if (_stricmp(value, "Battery Load") == 0) {
+                    aircraft->electrics = ELECTRICS_BATTERY_LOAD;
+                }
+                else {
+                    aircraft->electrics = ELECTRICS_DC_VOLTS;
+                }
+            }
+        }
+    }
+
+private:
+    void fail(const char* name, const char* msg)
+    {
+        // Keep the first error
+        if (error[0] == '\0') {
+            snprintf(error, sizeof(error), "Aircraft %s: %s", name, msg);
+        }
+    }
+};
+
+aircraftRegistry::aircraftRegistry(const char* filename)
+{
+    initTraits(&noAircraft, AircraftIds[NO_AIRCRAFT]);
+    noAircraft.id = NO_AIRCRAFT;
+    noAircraft.fast = FAST_NEVER;
+    initTraits(&otherAircraft, "Other");
+
+    // Root of trie
+    TrieNode root = { '\0', -1, -1, -1 };
+    trie.push_back(root);
+
+    load(filename);
+    globals.aircraftTraits = &noAircraft;
+}
+
+void aircraftRegistry::load(const char* filename)
+{
+    jsonParser parser;
+    aircraftHandler handler(this);
+    char msg[256];
+    int len;
+
+    if (!parser.parse(filename, &handler)) {
+        len = snprintf(msg, sizeof(msg), "Aircraft file %s line %d column %d: %s", filename, parser.line, parser.column, parser.error);
+    }
+    else if (handler.error[0] != '\0') {
+        len = snprintf(msg, sizeof(msg), "Aircraft file %s %s", filename, handler.error);
+    }
+    else {
+        return;
+    }
+
+    if (len >= (int)sizeof(msg)) {
+        // Show that the message has been cut short
+        strcpy(&msg[sizeof(msg) - 4], "...");
+    }
+
+    showError(msg);
+}
+
+void aircraftRegistry::initTraits(AircraftTraits* traits, const char* name)
+{
+    strncpy(traits->name, name, 63);
+    traits->name[63] = '\0';
+    traits->id = OTHER_AIRCRAFT;
+    traits->fast = FAST_CRUISE_SPEED;
+    traits->supersonic = false;
+    traits->electrics = ELECTRICS_DC_VOLTS;
+    traits->variants.clear();
+}
+
+/// <summary>
+/// Adds an aircraft with default traits and returns its index
+/// </summary>
+int aircraftRegistry::addAircraft(const char* name)
+{
+    AircraftTraits traits;
+    initTraits(&traits, name);
+
+    for (int i = CESSNA_152; AircraftIds[i] != NULL; i++) {
+        if (_stricmp(name, AircraftIds[i]) == 0) {
+            traits.id = (Aircraft)i;
+            break;
+        }
+    }
+
+    aircraft.push_back(traits);
+    return (int)aircraft.size() - 1;
+}
+
+void aircraftRegistry::addTitle(const char* title, int traits)
+{
+    int node = 0;
+    for (const char* ch = title; *ch != '\0'; ch++) {
+        int child = trie[node].child;
+        while (child != -1 && trie[child].ch != *ch) {
+            child = trie[child].sibling;
+        }
+
+        if (child == -1) {
+            TrieNode newNode = { *ch, -1, trie[node].child, -1 };
+            trie.push_back(newNode);
+            child = (int)trie.size() - 1;
+            trie[node].child = child;
+        }
+
+        node = child;
+    }
+
+    trie[node].traits = traits;
+}
+
+void aircraftRegistry::addContains(const char* text, int traits)
+{
+    Contains entry;
+    strcpy(entry.text, text);
+    entry.traits = traits;
+    contains.push_back(entry);
+}
+
+/// <summary>
+/// Returns the aircraft with the longest title that the
+/// aircraft title starts with or -1 if there isn't one.
+/// </summary>
+int aircraftRegistry::findTitle(const char* title)
+{
+    int found = -1;
+    int node = 0;
+
+    for (const char* ch = title; *ch != '\0'; ch++) {
+        node = trie[node].child;
+        while (node != -1 && trie[node].ch != *ch) {
+            node = trie[node].sibling;
+        }
+
+        if (node == -1) {
+            break;
+        }
+
+        if (trie[node].traits != -1) {
+            found = trie[node].traits;
+        }
+    }
+
+    return found;
+}
+
+/// <summary>
+/// Returns the traits of the aircraft with the given title. Aircraft
+/// identified by part of their title are checked first so that, for
+/// example, every A320 variant is found regardless of publisher.
+/// </summary>
+const AircraftTraits* aircraftRegistry::identify(const char* title)
+{
+    for (auto const& entry : contains) {
+        if (strstr(title, entry.text) != NULL) {
+            return &aircraft[entry.traits];
+        }
+    }
+
+    int traits = findTitle(title);
+    if (traits == -1) {
+        return &otherAircraft;
+    }
+
+    return &aircraft[traits];
+}
+
+/// <summary>
+/// Traits to use when no aircraft is loaded
+/// </summary>
+const AircraftTraits* aircraftRegistry::none()
+{
+    return &noAircraft;
+}
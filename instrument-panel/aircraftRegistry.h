@@ -0,0 +1,87 @@
+#ifndef _AIRCRAFT_REGISTRY_H_
+#define _AIRCRAFT_REGISTRY_H_
+
+#include <vector>
+#include "globals.h"
+
+enum FastRule {
+    FAST_CRUISE_SPEED,
+    FAST_ALWAYS,
+    FAST_NEVER
+};
+
+enum ElectricsRule {
+    ELECTRICS_DC_VOLTS,
+    ELECTRICS_MAIN_BUS,
+    ELECTRICS_BATTERY_LOAD
+};
+
+struct AircraftVariant
+{
+    char instrument[64];
+    char variant[64];
+};
+
+/// <summary>
+/// Everything instruments need to know about the loaded aircraft.
+/// Aircraft that have no special code use OTHER_AIRCRAFT as their
+/// id but can still have their own traits.
+/// </summary>
+struct AircraftTraits
+{
+    char name[64];
+    Aircraft id;
+    FastRule fast;
+    bool supersonic;
+    ElectricsRule electrics;
+    std::vector<AircraftVariant> variants;
+
+    bool isFast(double cruiseSpeed) const;
+    const char* variant(const char* instrument) const;
+};
+
+/// <summary>
+/// Identifies the aircraft from its title using the aircraft file in
+/// the settings directory. Titles are matched by longest prefix using
+/// a trie so adding aircraft doesn't slow down identification.
+/// </summary>
+class aircraftRegistry
+{
+private:
+    struct TrieNode
+    {
+        char ch;
+        int child;
+        int sibling;
+        int traits;
+    };
+
+    struct Contains
+    {
+        char text[64];
+        int traits;
+    };
+
+    std::vector<AircraftTraits> aircraft;
+    std::vector<TrieNode> trie;
+    std::vector<Contains> contains;
+    AircraftTraits noAircraft;
+    AircraftTraits otherAircraft;
+
+public:
+    aircraftRegistry(const char* filename);
+    const AircraftTraits* identify(const char* title);
+    const AircraftTraits* none();
+
+private:
+    void load(const char* filename);
+    int addAircraft(const char* name);
+    void addTitle(const char* title, int traits);
+    void addContains(const char* text, int traits);
+    int findTitle(const char* title);
+    static void initTraits(AircraftTraits* traits, const char* name);
+
+    friend class aircraftHandler;
+};
+
+#endif // _AIRCRAFT_REGISTRY_H_
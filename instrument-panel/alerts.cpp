@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include "alerts.h"
+#include "aircraftRegistry.h"
+
+extern globalVars globals;
+
+struct AlertRule
+{
+    // Message shown while active or NULL if only shown by an instrument.
+    // Can include %d for the value of the first input.
+    const char* message;
+    AlertPriority priority;
+    int inputCount;
+    int inputs[MaxAlertInputs];
+    bool (*condition)(const double* in, bool active);
+    double onDelay;
+    double offDelay;
+    double flashPeriod;
+    double flashTime;
+};
+
+// Index of a SimVars member when SimVars is treated as an array of doubles
+#define SLOT(field) (int)(offsetof(SimVars, field) / sizeof(double))
+
+// Derived values are inputs too (stored as negative slots)
+#define DERIVED(var) (-1 - (var))
+
+static double fuelWarnPercent(double cruiseSpeed)
+{
+    if (globals.aircraft == AIRBUS_A310 || globals.aircraft == BOEING_747) {
+        // Long haul
+        return 3;
+    }
+    else if (globals.aircraftTraits->isFast(cruiseSpeed)) {
+        return 6;
+    }
+
+    return 12;
+}
+
+/// <summary>
+/// Inputs are tank percent and cruise speed. A level of zero
+/// means there is no fuel data. Clears 1% above the warning
+/// level so fuel sloshing about doesn't make it flicker.
+/// </summary>
+static bool lowFuel(const double* in, bool active)
+{
+    if (globals.aircraft == GLIDER || in[0] == 0) {
+        return false;
+    }
+
+    double warnPercent = fuelWarnPercent(in[1]);
+    return in[0] <= (active ? warnPercent + 1 : warnPercent);
+}
+
+/// <summary>
+/// Suction below 1 inHg
+/// </summary>
+static bool lowVacuum(const double* in, bool active)
+{
+    if (globals.aircraft == GLIDER || globals.aircraft == KODIAK_100) {
+        return false;
+    }
+
+    return in[0] < (active ? 1.1 : 1);
+}
+
+/// <summary>
+/// Oil pressure below 20 PSI
+/// </summary>
+static bool lowOilPressure(const double* in, bool active)
+{
+    if (globals.aircraft == GLIDER || globals.aircraft == ORNITHOPTER) {
+        return false;
+    }
+
+    return in[0] < (active ? 22 : 20);
+}
+
+/// <summary>
+/// Battery load too high, i.e. alternator off or not charging quick enough
+/// </summary>
+static bool highBatteryLoad(const double* in, bool active)
+{
+    if (globals.aircraft == GLIDER) {
+        return false;
+    }
+
+    return in[0] > (active ? 16 : 18);
+}
+
+/// <summary>
+/// Low altitude and flaps down but gear is up. Inputs are flaps index,
+/// altitude above ground, gear retractable, gear position and vertical
+/// speed. No warning between 100 and 300 feet.
+/// </summary>
+static bool gearUp(const double* in, bool active)
+{
+    if (in[0] > 0 && in[1] < 400 && in[1] > 30 && in[2] != 0 && in[3] < 20 && in[4] < 0) {
+        return in[1] > 300 || in[1] < 100;
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Logger not running but pushing back or running engines. Inputs are
+/// logger state, pushback state and RPM percent. Once raised the alert
+/// stays until the logger state changes.
+/// </summary>
+static bool loggerNotStarted(const double* in, bool active, int state)
+{
+    if (active) {
+        return in[0] == state;
+    }
+
+    return in[0] == state && (in[1] < 3 || in[2] > 10);
+}
+
+static bool skytrackNotStarted(const double* in, bool active)
+{
+    return loggerNotStarted(in, active, 1);
+}
+
+static bool cixLoggerNotStarted(const double* in, bool active)
+{
+    return loggerNotStarted(in, active, 3);
+}
+
+/// <summary>
+/// Show touchdown vertical speed while on the ground. Inputs are landing
+/// rate in FPM, landing rate from sim, on ground and electrics.
+/// </summary>
+static bool landed(const double* in, bool active)
+{
+    return globals.connected && in[3] == 1 && in[2] != 0 && in[1] != -999;
+}
+
+static const AlertRule AlertRules[] = {
+    { NULL, PRIORITY_CAUTION, 2, { DERIVED(DERIVED_FUEL_LEFT_PERCENT), SLOT(cruiseSpeed) }, lowFuel, 0, 0, 0.5, 10 },
+    { NULL, PRIORITY_CAUTION, 2, { DERIVED(DERIVED_FUEL_RIGHT_PERCENT), SLOT(cruiseSpeed) }, lowFuel, 0, 0, 0.5, 10 },
+    { NULL, PRIORITY_CAUTION, 1, { SLOT(suctionPressure) }, lowVacuum, 0, 0, 0, 0 },
+    { NULL, PRIORITY_CAUTION, 1, { DERIVED(DERIVED_OIL_PRESSURE) }, lowOilPressure, 0, 0, 0, 0 },
+    { NULL, PRIORITY_CAUTION, 1, { SLOT(batteryLoad) }, highBatteryLoad, 2, 0, 0, 0 },
+    { NULL, PRIORITY_WARNING, 5, { SLOT(tfFlapsIndex), SLOT(altAboveGround), SLOT(gearRetractable), SLOT(gearLeftPos), SLOT(vsiVerticalSpeed) }, gearUp, 0, 0, 0.15, 0 },
+    { "SkyTrack not started", PRIORITY_WARNING, 3, { SLOT(skytrackState), SLOT(pushbackState), SLOT(rpmPercent) }, skytrackNotStarted, 0, 0, 0, 0 },
+    { "CIX Logger not started", PRIORITY_WARNING, 3, { SLOT(skytrackState), SLOT(pushbackState), SLOT(rpmPercent) }, cixLoggerNotStarted, 0, 0, 0, 0 },
+    { "Landing Rate: %d FPM", PRIORITY_INFO, 4, { DERIVED(DERIVED_LANDING_RATE_FPM), SLOT(landingRate), SLOT(onGround), DERIVED(DERIVED_ELECTRICS) }, landed, 1, 0, 0, 0 }
+};
+
+static_assert(sizeof(AlertRules) / sizeof(AlertRule) == ALERT_COUNT, "AlertRules must match AlertId");
+
+alertEngine::alertEngine()
+{
+    memset(alerts, 0, sizeof(alerts));
+}
+
+/// <summary>
+/// Re-evaluate any alerts whose inputs have changed since the last update
+/// and raise or clear alerts whose delay has expired. Should be called
+/// once per frame after the derived values have been updated.
+/// </summary>
+void alertEngine::update(const SimVars* simVars, const derivedVars* derived)
+{
+    const double* slots = (const double*)simVars;
+    double now = globals.frameTime;
+
+    // Conditions depend on the aircraft and connection so start again if either changes
+    bool reset = (lastAircraft != globals.aircraft || lastConnected != globals.connected);
+    lastAircraft = globals.aircraft;
+    lastConnected = globals.connected;
+
+    for (int i = 0; i < ALERT_COUNT; i++) {
+        const AlertRule* rule = &AlertRules[i];
+        Alert* alert = &alerts[i];
+
+        if (reset) {
+            clear(i);
+            alert->evaluated = false;
+        }
+
+        bool changed = !alert->evaluated;
+
+        for (int j = 0; j < rule->inputCount; j++) {
+            int input = rule->inputs[j];
+            double val = input >= 0 ? slots[input] : derived->get((DerivedVar)(-1 - input));
+            if (val != alert->inputs[j]) {
+                alert->inputs[j] = val;
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            bool condition = rule->condition(alert->inputs, alert->active);
+            if (!alert->evaluated || condition != alert->condition) {
+                alert->condition = condition;
+                alert->conditionTime = now;
+            }
+            alert->evaluated = true;
+
+            if (alert->active) {
+                formatText(i);
+            }
+        }
+
+        // Only pending alerts need checking if inputs haven't changed
+        if (alert->condition != alert->active) {
+            double delay = alert->condition ? rule->onDelay : rule->offDelay;
+            if (now - alert->conditionTime >= delay) {
+                if (alert->condition) {
+                    raise(i, now);
+                }
+                else {
+                    clear(i);
+                }
+            }
+        }
+    }
+}
+
+void alertEngine::raise(int alert, double now)
+{
+    alerts[alert].active = true;
+    alerts[alert].raisedTime = now;
+
+    if (AlertRules[alert].message == NULL) {
+        return;
+    }
+
+    formatText(alert);
+
+    // Keep messages in priority order (oldest first if same priority)
+    AlertPriority priority = AlertRules[alert].priority;
+    auto pos = messages.begin();
+    while (pos != messages.end() && AlertRules[*pos].priority >= priority) {
+        pos++;
+    }
+    messages.insert(pos, alert);
+}
+
+void alertEngine::clear(int alert)
+{
+    if (!alerts[alert].active) {
+        return;
+    }
+
+    alerts[alert].active = false;
+
+    for (auto pos = messages.begin(); pos != messages.end(); pos++) {
+        if (*pos == alert) {
+            messages.erase(pos);
+            break;
+        }
+    }
+}
+
+void alertEngine::formatText(int alert)
+{
+    const char* message = AlertRules[alert].message;
+    if (message != NULL) {
+        snprintf(alerts[alert].text, sizeof(alerts[alert].text), message, (int)alerts[alert].inputs[0]);
+    }
+}
+
+bool alertEngine::isActive(AlertId alert) const
+{
+    return alerts[alert].active;
+}
+
+/// <summary>
+/// Returns true if the alert is active and not in the off
+/// part of a flash so instruments can just draw it or not.
+/// </summary>
+bool alertEngine::isShowing(AlertId alert) const
+{
+    if (!alerts[alert].active) {
+        return false;
+    }
+
+    const AlertRule* rule = &AlertRules[alert];
+    if (rule->flashPeriod == 0) {
+        return true;
+    }
+
+    // Flash for flashTime seconds or for as long as active if zero
+    double elapsed = globals.frameTime - alerts[alert].raisedTime;
+    if (rule->flashTime > 0 && elapsed >= rule->flashTime) {
+        return true;
+    }
+
+    return (int)(elapsed / rule->flashPeriod) % 2 == 0;
+}
+
+/// <summary>
+/// Returns the message of the highest priority active alert
+/// or NULL if there isn't one.
+/// </summary>
+const char* alertEngine::topMessage(AlertPriority* priority) const
+{
+    if (messages.empty()) {
+        return NULL;
+    }
+
+    int alert = messages.front();
+    *priority = AlertRules[alert].priority;
+    return alerts[alert].text;
+}
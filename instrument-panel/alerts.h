@@ -0,0 +1,76 @@
+#ifndef _ALERTS_H_
+#define _ALERTS_H_
+
+#include <vector>
+#include "globals.h"
+#include "simvarDefs.h"
+#include "derivedVars.h"
+
+// Handles of the alerts (same order as AlertRules)
+enum AlertId {
+    ALERT_FUEL_LEFT,
+    ALERT_FUEL_RIGHT,
+    ALERT_VAC,
+    ALERT_OIL_PRESSURE,
+    ALERT_VOLTS,
+    ALERT_GEAR_UP,
+    ALERT_SKYTRACK,
+    ALERT_CIX_LOGGER,
+    ALERT_LANDING_RATE,
+    ALERT_COUNT
+};
+
+// Higher priority messages are shown first
+enum AlertPriority {
+    PRIORITY_INFO,
+    PRIORITY_CAUTION,
+    PRIORITY_WARNING
+};
+
+const int MaxAlertInputs = 5;
+
+/// <summary>
+/// Warnings and messages raised from FlightSim variables. Each alert is
+/// declared once with the SimVars (or derived values) it depends on and
+/// its condition is only evaluated when one of those has changed (or the
+/// aircraft or connection has changed). Conditions are given the current
+/// state so they can use different thresholds to raise and clear the
+/// alert, and an alert can wait for its condition to hold for a while
+/// before it is raised or cleared.
+///
+/// Instruments ask whether an alert is showing and active alerts with
+/// a message are queued by priority for the message area.
+/// </summary>
+class alertEngine
+{
+private:
+    struct Alert
+    {
+        double inputs[MaxAlertInputs];
+        bool evaluated;
+        bool condition;
+        double conditionTime;
+        bool active;
+        double raisedTime;
+        char text[64];
+    };
+
+    Alert alerts[ALERT_COUNT];
+    std::vector<int> messages;
+    Aircraft lastAircraft = UNDEFINED;
+    bool lastConnected = false;
+
+public:
+    alertEngine();
+    void update(const SimVars* simVars, const derivedVars* derived);
+    bool isActive(AlertId alert) const;
+    bool isShowing(AlertId alert) const;
+    const char* topMessage(AlertPriority* priority) const;
+
+private:
+    void raise(int alert, double now);
+    void clear(int alert);
+    void formatText(int alert);
+};
+
+#endif // _ALERTS_H_
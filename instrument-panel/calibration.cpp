@@ -0,0 +1,40 @@
+#include <algorithm>
+#include "calibration.h"
+
+/// <summary>
+/// Builds the lookup table. Points must be in ascending order of input.
+/// </summary>
+calibration::calibration(const CalPoint* points, int count)
+{
+    minIn = points[0].in;
+    double maxIn = points[count - 1].in;
+    scale = TableSize / (maxIn - minIn);
+
+    int seg = 0;
+    for (int i = 0; i <= TableSize; i++) {
+        double in = minIn + i / scale;
+        while (seg < count - 2 && in > points[seg + 1].in) {
+            seg++;
+        }
+
+        const CalPoint* p = &points[seg];
+        double frac = (in - p[0].in) / (p[1].in - p[0].in);
+        table[i] = p[0].out + (p[1].out - p[0].out) * std::min(frac, 1.0);
+    }
+
+    // Spare entry so the top of the table needs no special case
+    table[TableSize + 1] = table[TableSize];
+}
+
+/// <summary>
+/// Returns the calibrated output for the given input
+/// </summary>
+double calibration::lookup(double in) const
+{
+    // NaN clamps to the bottom of the scale
+    double pos = std::min(std::max(0.0, (in - minIn) * scale), (double)TableSize);
+    int i = (int)pos;
+    double frac = pos - i;
+
+    return table[i] + (table[i + 1] - table[i]) * frac;
+}
@@ -0,0 +1,32 @@
+#ifndef _CALIBRATION_H_
+#define _CALIBRATION_H_
+
+struct CalPoint
+{
+    double in;
+    double out;
+};
+
+/// <summary>
+/// Converts a sim value to a needle position for a gauge with a
+/// non-linear scale. The scale is a table of control points in
+/// ascending order of input, resampled once into an evenly spaced
+/// lookup table so that each conversion is an index calculation and
+/// a linear interpolation. Inputs outside the table are clamped to
+/// the first or last point.
+/// </summary>
+class calibration
+{
+private:
+    static const int TableSize = 512;
+
+    double minIn;
+    double scale;
+    double table[TableSize + 2];
+
+public:
+    calibration(const CalPoint* points, int count);
+    double lookup(double in) const;
+};
+
+#endif // _CALIBRATION_H_
@@ -0,0 +1,67 @@
+#include "calibrationTables.h"
+
+#define POINTS(points) points, sizeof(points) / sizeof(CalPoint)
+
+// The dial markings step where the old formula's pieces met (40, 90, 120
+// and 160 knots) so each join has a point either side of it.
+static const CalPoint AsiAirspeedPoints[] = {
+    { 0, 0.0000 }, { 5, 0.0650 }, { 10, 0.1300 }, { 15, 0.1950 }, { 20, 0.2600 }, { 25, 0.3250 },
+    { 30, 0.3900 }, { 35, 0.4550 }, { 39.99, 0.5199 }, { 40, 0.5354 }, { 45, 0.6867 }, { 50, 0.8485 },
+    { 55, 1.0200 }, { 60, 1.2006 }, { 65, 1.3895 }, { 70, 1.5866 }, { 75, 1.7912 }, { 80, 2.0031 },
+    { 85, 2.2220 }, { 89.99, 2.4471 }, { 90, 2.4460 }, { 95, 2.6322 }, { 100, 2.8229 }, { 105, 3.0181 },
+    { 110, 3.2174 }, { 115, 3.4209 }, { 119.99, 3.6280 }, { 120, 3.6077 }, { 125, 3.7356 }, { 130, 3.8654 },
+    { 135, 3.9969 }, { 140, 4.1301 }, { 145, 4.2650 }, { 150, 4.4015 }, { 155, 4.5396 }, { 159.99, 4.6790 },
+    { 160, 4.6688 }, { 165, 4.7730 }, { 170, 4.8782 }, { 175, 4.9843 },
+    { 180, 5.0913 }, { 185, 5.1993 }, { 190, 5.3081 }, { 195, 5.4177 }, { 200, 5.5282 }, { 205, 5.6396 },
+    { 210, 5.7517 }, { 215, 5.8646 }, { 220, 5.9784 }, { 225, 6.0928 }, { 230, 6.2081 }, { 235, 6.3241 },
+    { 240, 6.4408 }, { 245, 6.5582 }, { 250, 6.6763 }
+};
+
+// The old formula held the needle at 0 until it reached 3 degrees (at
+// about 42.8 knots) and then jumped. The table ramps from 0 at 40 knots
+// to 3.52 at 45 knots instead. The ASI smooths needle moves below 5
+// degrees anyway so the jump was never visible.
+static const CalPoint AsiFastAirspeedPoints[] = {
+    { 0, 0.00 }, { 40, 0.00 }, { 45, 3.52 }, { 50, 4.89 }, { 55, 6.46 },
+    { 60, 8.22 }, { 65, 10.17 }, { 70, 12.30 }, { 75, 14.61 }, { 80, 17.09 }, { 85, 19.72 },
+    { 90, 22.51 }, { 95, 25.44 }, { 100, 28.50 }, { 105, 31.70 }, { 110, 35.02 }, { 115, 38.45 },
+    { 120, 41.99 }, { 125, 45.62 }, { 130, 49.34 }, { 135, 53.14 }, { 140, 57.02 }, { 145, 60.95 },
+    { 150, 64.95 }, { 155, 68.99 }, { 160, 73.07 }, { 165, 77.18 }, { 170, 81.31 }, { 175, 85.47 },
+    { 180, 89.63 }, { 185, 93.79 }, { 190, 97.95 }, { 195, 102.09 }, { 200, 106.22 }, { 205, 110.32 },
+    { 210, 114.39 }, { 215, 118.42 }, { 220, 122.42 }, { 225, 126.36 }, { 230, 130.26 }, { 235, 134.09 },
+    { 240, 137.87 }, { 245, 141.59 }, { 250, 145.24 }, { 255, 148.82 }, { 260, 152.34 }, { 265, 155.78 },
+    { 270, 159.15 }, { 275, 162.44 }, { 280, 165.67 }, { 285, 168.82 }, { 290, 171.90 }, { 295, 174.91 },
+    { 300, 177.86 }, { 305, 180.75 }, { 310, 183.57 }, { 315, 186.35 }, { 320, 189.07 }, { 325, 191.75 },
+    { 330, 194.40 }, { 335, 197.02 }, { 340, 199.62 }, { 345, 202.21 }, { 350, 204.80 }, { 355, 207.41 },
+    { 360, 210.03 }, { 365, 212.70 }, { 370, 215.41 }, { 375, 218.19 }, { 380, 221.05 }, { 385, 224.01 },
+    { 390, 227.08 }, { 395, 230.29 }, { 400, 233.65 }
+};
+
+static const CalPoint AsiSupersonicAirspeedPoints[] = {
+    { 0, 0 }, { 50, 20 }, { 200, 140 }, { 300, 180 }, { 600, 270 }, { 1000, 340 }
+};
+
+static const CalPoint AsiGliderAirspeedPoints[] = {
+    { 20, 170 }, { 100, 354 }, { 150, 454 }, { 300, 691 }
+};
+
+static const CalPoint VsiVertSpeedPoints[] = {
+    { 0, 0 }, { 10, 79.5 }, { 30, 175.5 }
+};
+
+static const CalPoint VsiExtremeVertSpeedPoints[] = {
+    { 0, 0 }, { 2, 79.5 }, { 2 + 96.0 * 4 / 96.5, 175.5 }
+};
+
+// The 0-60% arc spans 135 degrees and the remaining 40% arc (60-100%) spans 181 degrees
+static const CalPoint RpmPercentN1Points[] = {
+    { 0, 0 }, { 60, 135 }, { 110, 361.25 }
+};
+
+const calibration asiAirspeedScale(POINTS(AsiAirspeedPoints));
+const calibration asiFastAirspeedScale(POINTS(AsiFastAirspeedPoints));
+const calibration asiSupersonicAirspeedScale(POINTS(AsiSupersonicAirspeedPoints));
+const calibration asiGliderAirspeedScale(POINTS(AsiGliderAirspeedPoints));
+const calibration vsiVertSpeedScale(POINTS(VsiVertSpeedPoints));
+const calibration vsiExtremeVertSpeedScale(POINTS(VsiExtremeVertSpeedPoints));
+const calibration rpmPercentN1Scale(POINTS(RpmPercentN1Points));
@@ -0,0 +1,31 @@
+#ifndef _CALIBRATION_TABLES_H_
+#define _CALIBRATION_TABLES_H_
+
+#include "calibration.h"
+
+// Dial scales for gauges with non-linear needles. Kept together (and free
+// of Allegro) so checks/calibrationCheck.cpp can compare them with the
+// formulas they replaced.
+
+// Needle angle (radians) for airspeed (knots), asi and asiSavageCub
+extern const calibration asiAirspeedScale;
+
+// Needle angle (degrees) for airspeed (knots)
+extern const calibration asiFastAirspeedScale;
+
+// Needle angle (degrees) for airspeed (knots)
+extern const calibration asiSupersonicAirspeedScale;
+
+// Needle angle (degrees) for airspeed (km/h)
+extern const calibration asiGliderAirspeedScale;
+
+// Needle angle (degrees) for vertical speed (100 feet per minute)
+extern const calibration vsiVertSpeedScale;
+
+// Needle angle (degrees) for vertical speed (1000 feet per minute)
+extern const calibration vsiExtremeVertSpeedScale;
+
+// Needle angle (degrees) for N1 percent
+extern const calibration rpmPercentN1Scale;
+
+#endif // _CALIBRATION_TABLES_H_
@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include "calibrationTables.h"
+
+// Checks each dial scale in calibrationTables.cpp against the formula
+// it replaced, over the whole of the dial. Built and run by make.sh.
+
+/// <summary>
+/// Old asi and asiSavageCub formula (radians)
+/// </summary>
+static double oldAsi(double airspeedKnots)
+{
+    if (airspeedKnots < 40) {
+        return airspeedKnots * 0.013;
+    }
+    else if (airspeedKnots < 90) {
+        return -0.03 + pow(airspeedKnots - 12.1, 1.439) * 0.0047;
+    }
+    else if (airspeedKnots < 120) {
+        return 0.4 + pow(airspeedKnots - 12.1, 1.4) * 0.0046;
+    }
+    else if (airspeedKnots < 160) {
+        return 1.53 + pow(airspeedKnots - 12.0, 1.320) * 0.0043;
+    }
+    else {
+        return 2.27 + pow(airspeedKnots - 12.0, 1.28) * 0.0040;
+    }
+}
+
+/// <summary>
+/// Old asiFast formula (degrees)
+/// </summary>
+static double oldAsiFast(double airspeed)
+{
+    double speed = airspeed / 10.0f;
+    double angle;
+
+    if (speed > 400) {
+        angle = 233.65;
+    }
+    else if (speed > 0) {
+        angle = 0.0000052772 * pow(speed, 5) - 0.0003338205 * pow(speed, 4) - 0.0025509435 * pow(speed, 3) + 0.482328783 * pow(speed, 2) - 1.5416690771 * speed + 1.0500510789;
+        // Angle is not accurate below 3
+        if (angle < 3) {
+            angle = 0;
+        }
+    }
+    else {
+        angle = 0;
+    }
+
+    return angle;
+}
+
+/// <summary>
+/// Old asiSupersonic formula (degrees)
+/// </summary>
+static double oldAsiSupersonic(double airspeed)
+{
+    if (airspeed < 50) {
+        return airspeed * 20.0 / 50.0;
+    }
+    else if (airspeed < 200) {
+        return 20 + (airspeed - 50) * 120.0 / 150.0;
+    }
+    else if (airspeed < 300) {
+        return 140 + (airspeed - 200) * 40.0 / 100.0;
+    }
+    else if (airspeed < 600) {
+        return 180 + (airspeed - 300) * 90.0 / 300.0;
+    }
+    else if (airspeed < 1000) {
+        return 270 + (airspeed - 600) * 70.0 / 400.0;
+    }
+    else {
+        return 340;
+    }
+}
+
+/// <summary>
+/// Old asiGlider formula (degrees)
+/// </summary>
+static double oldAsiGlider(double kmph)
+{
+    if (kmph < 20) {
+        kmph = 20;
+    }
+
+    if (kmph <= 100) {
+        return 124 + kmph * 2.3;
+    }
+    else if (kmph <= 150) {
+        return 154 + kmph * 2.0;
+    }
+    else {
+        return 217 + kmph * 1.58;
+    }
+}
+
+/// <summary>
+/// Old vsi formula (degrees)
+/// </summary>
+static double oldVsi(double vertSpeed)
+{
+    if (vertSpeed > 10) {
+        double angle = 79.5 + (96.0 * (vertSpeed - 10.0)) / 20.0;
+        return angle > 175.5 ? 175.5 : angle;
+    }
+    else {
+        return (79.5 * vertSpeed) / 10.0;
+    }
+}
+
+/// <summary>
+/// Old vsiExtreme formula (degrees)
+/// </summary>
+static double oldVsiExtreme(double vertSpeed)
+{
+    if (vertSpeed > 2) {
+        double angle = 79.5 + (vertSpeed - 2.0) * 96.5 / 4.0;
+        return angle > 175.5 ? 175.5 : angle;
+    }
+    else {
+        return vertSpeed * 79.5 / 2.0;
+    }
+}
+
+/// <summary>
+/// Old rpmPercent formula (degrees)
+/// </summary>
+static double oldRpmPercent(double turbineEngineN1)
+{
+    if (turbineEngineN1 < 60) {
+        return 135 * (turbineEngineN1 / 60);
+    }
+    else {
+        return 135 + (181 * (turbineEngineN1 - 60) / 40.0);
+    }
+}
+
+// Inputs where the old formula stepped from one piece to the next
+static const double AsiJoins[] = { 40, 90, 120, 160 };
+
+struct ScaleCheck
+{
+    const char* name;
+    const calibration* scale;
+    double (*oldFormula)(double);
+    double minIn;
+    double maxIn;
+    double tolerance;
+    const double* joins;
+    int joinCount;
+};
+
+// Each scale is checked over its whole dial to within 0.2 degrees
+// (0.0035 radians for asi).
+static const ScaleCheck Checks[] = {
+    { "asi", &asiAirspeedScale, oldAsi, 0, 250, 0.0035, AsiJoins, 4 },
+    { "asiFast", &asiFastAirspeedScale, oldAsiFast, 45, 400, 0.2, NULL, 0 },
+    { "asiSupersonic", &asiSupersonicAirspeedScale, oldAsiSupersonic, 0, 1000, 0.2, NULL, 0 },
+    { "asiGlider", &asiGliderAirspeedScale, oldAsiGlider, 0, 300, 0.2, NULL, 0 },
+    { "vsi", &vsiVertSpeedScale, oldVsi, 0, 40, 0.2, NULL, 0 },
+    { "vsiExtreme", &vsiExtremeVertSpeedScale, oldVsiExtreme, 0, 8, 0.2, NULL, 0 },
+    { "rpmPercent", &rpmPercentN1Scale, oldRpmPercent, 0, 110, 0.2, NULL, 0 }
+};
+
+const int Steps = 100000;
+
+// calibration resamples each scale into this many lookup entries. A step
+// in the scale is spread over the entry it falls in, so the sweep skips
+// one entry either side of each join.
+const int TableSize = 512;
+
+/// <summary>
+/// Returns true if the input is within one lookup entry of a join
+/// </summary>
+static bool nearJoin(const ScaleCheck& check, double in, double spacing)
+{
+    for (int i = 0; i < check.joinCount; i++) {
+        if (fabs(in - check.joins[i]) < spacing) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main()
+{
+    int failed = 0;
+
+    for (const ScaleCheck& check : Checks) {
+        double spacing = (check.maxIn - check.minIn) / TableSize;
+        double worst = 0;
+        double worstIn = check.minIn;
+
+        for (int i = 0; i <= Steps; i++) {
+            double in = check.minIn + (check.maxIn - check.minIn) * i / Steps;
+            if (nearJoin(check, in, spacing)) {
+                continue;
+            }
+            double diff = fabs(check.scale->lookup(in) - check.oldFormula(in));
+            if (diff > worst) {
+                worst = diff;
+                worstIn = in;
+            }
+        }
+
+        bool ok = worst <= check.tolerance;
+        printf("%-14s worst difference %.4f at %.2f (tolerance %.4f) %s\n", check.name, worst, worstIn, check.tolerance, ok ? "ok" : "FAILED");
+        if (!ok) {
+            failed++;
+        }
+
+        // The needle must still step at each join, not drift across it
+        for (int i = 0; i < check.joinCount; i++) {
+            double below = check.joins[i] - spacing;
+            double above = check.joins[i] + spacing;
+            double step = check.scale->lookup(above) - check.scale->lookup(below);
+            double oldStep = check.oldFormula(above) - check.oldFormula(below);
+            ok = fabs(step - oldStep) <= check.tolerance;
+            printf("%-14s step %.4f at %.0f (old %.4f) %s\n", check.name, step, check.joins[i], oldStep, ok ? "ok" : "FAILED");
+            if (!ok) {
+                failed++;
+            }
+        }
+    }
+
+    // asiFast deliberately ramps up between 40 and 45 knots instead of
+    // jumping (see calibrationTables.cpp). Check it stays at 0 below the
+    // ramp and follows the ramp up to 45 knots, allowing one lookup entry
+    // (0.78 knots) for the corner at 40 knots.
+    for (double in = 0; in <= 39; in += 0.01) {
+        if (asiFastAirspeedScale.lookup(in) != 0 || oldAsiFast(in) != 0) {
+            printf("asiFast needle not at 0 for %.2f knots FAILED\n", in);
+            failed++;
+            break;
+        }
+    }
+
+    double fastSpacing = 400.0 / TableSize;
+    double worst = 0;
+    double worstIn = 40;
+    double last = 0;
+    for (double in = 39; in <= 45; in += 0.01) {
+        double angle = asiFastAirspeedScale.lookup(in);
+        if (angle < last) {
+            printf("asiFast needle moves back at %.2f knots FAILED\n", in);
+            failed++;
+            break;
+        }
+        last = angle;
+
+        if (in > 40 - fastSpacing && in < 40 + fastSpacing) {
+            continue;
+        }
+        double ramp = in < 40 ? 0 : (in - 40) * 3.52 / 5;
+        double diff = fabs(angle - ramp);
+        if (diff > worst) {
+            worst = diff;
+            worstIn = in;
+        }
+    }
+
+    bool rampOk = worst <= 0.2;
+    printf("%-14s worst ramp difference %.4f at %.2f (tolerance %.4f) %s\n", "asiFast", worst, worstIn, 0.2, rampOk ? "ok" : "FAILED");
+    if (!rampOk) {
+        failed++;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "softBlendKernels.h"
+
+// Checks the software compositing kernels (SSE2, NEON or plain C,
+// whichever this machine builds) against a simple per-pixel version
+// on random data. Built and run by make.sh.
+
+const int Iterations = 2000;
+
+static unsigned char random8()
+{
+    return (unsigned char)(rand() & 0xff);
+}
+
+/// <summary>
+/// Blend one pixel the slow way (GL rounding)
+/// </summary>
+static void referencePixel(BlendMode mode, const unsigned char* src, unsigned char* dest)
+{
+    double alpha = src[3];
+    for (int c = 0; c < 4; c++) {
+        switch (mode) {
+        case BLEND_COPY:
+            dest[c] = src[c];
+            break;
+        case BLEND_ALPHA:
+            dest[c] = (unsigned char)lround((src[c] * alpha + dest[c] * (255 - alpha)) / 255.0);
+            break;
+        case BLEND_MULTIPLY:
+            dest[c] = (unsigned char)lround(src[c] * dest[c] / 255.0);
+            break;
+        }
+    }
+}
+
+/// <summary>
+/// Random rows of every length up to a few SIMD blocks so both the
+/// vector loop and the tail are covered.
+/// </summary>
+static int checkRows()
+{
+    int mismatches = 0;
+    unsigned char src[64 * 4];
+    unsigned char dest[64 * 4];
+    unsigned char expected[64 * 4];
+
+    for (int i = 0; i < Iterations; i++) {
+        BlendMode mode = (BlendMode)(i % 3);
+        int pixels = 1 + rand() % 64;
+
+        for (int j = 0; j < pixels * 4; j++) {
+            src[j] = random8();
+            dest[j] = expected[j] = random8();
+        }
+
+        // Plenty of fully opaque and fully transparent pixels as in real sprites
+        if (i % 4 == 0) {
+            for (int j = 0; j < pixels; j++) {
+                src[j * 4 + 3] = (rand() & 1) ? 255 : 0;
+            }
+        }
+
+        for (int j = 0; j < pixels; j++) {
+            referencePixel(mode, &src[j * 4], &expected[j * 4]);
+        }
+
+        softBlendKernels::blendRow(mode, src, dest, pixels);
+
+        for (int j = 0; j < pixels * 4; j++) {
+            if (dest[j] != expected[j]) {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+/// <summary>
+/// Random scales, rotations and positions (including ones hanging off
+/// the edges) compared with sampling every pixel separately.
+/// </summary>
+static int checkSampled()
+{
+    int mismatches = 0;
+
+    for (int i = 0; i < Iterations; i++) {
+        BlendMode mode = (BlendMode)(i % 3);
+        int srcWidth = 1 + rand() % 40;
+        int srcHeight = 1 + rand() % 40;
+        int destWidth = 1 + rand() % 60;
+        int destHeight = 1 + rand() % 60;
+        int srcPitch = srcWidth * 4 + 4 * (rand() % 3);
+        int destPitch = destWidth * 4 + 4 * (rand() % 3);
+
+        std::vector<unsigned char> src(srcPitch * srcHeight);
+        std::vector<unsigned char> dest(destPitch * destHeight);
+        for (auto& byte : src) {
+            byte = random8();
+        }
+        for (auto& byte : dest) {
+            byte = random8();
+        }
+        std::vector<unsigned char> expected = dest;
+
+        double angle = (i % 5 == 0) ? 0 : 2 * M_PI * rand() / RAND_MAX;
+        double xScale = 0.25 + rand() * 3.0 / RAND_MAX;
+        double yScale = (i % 7 == 0) ? -xScale : 0.25 + rand() * 3.0 / RAND_MAX;
+        double x = rand() % 80 - 20 + rand() / (double)RAND_MAX;
+        double y = rand() % 80 - 20 + rand() / (double)RAND_MAX;
+
+        // Reverse of scaling then rotating the source and moving it to x, y
+        double xx = xScale * cos(angle);
+        double xy = -yScale * sin(angle);
+        double yx = xScale * sin(angle);
+        double yy = yScale * cos(angle);
+        double det = xx * yy - xy * yx;
+
+        SampleMap map;
+        map.u0 = (yy * (0.5 - x) - xy * (0.5 - y)) / det;
+        map.v0 = (xx * (0.5 - y) - yx * (0.5 - x)) / det;
+        map.dudx = yy / det;
+        map.dvdx = -yx / det;
+        map.dudy = -xy / det;
+        map.dvdy = xx / det;
+
+        for (int py = 0; py < destHeight; py++) {
+            double uRow = map.u0 + map.dudy * py;
+            double vRow = map.v0 + map.dvdy * py;
+            for (int px = 0; px < destWidth; px++) {
+                double u = uRow + map.dudx * px;
+                double v = vRow + map.dvdx * px;
+                if (u >= 0 && u < srcWidth && v >= 0 && v < srcHeight) {
+                    referencePixel(mode, &src[(int)v * srcPitch + (int)u * 4], &expected[py * destPitch + px * 4]);
+                }
+            }
+        }
+
+        softBlendKernels::blendSampled(mode, src.data(), srcPitch, srcWidth, srcHeight,
+            dest.data(), destPitch, destWidth, destHeight, &map);
+
+        for (int py = 0; py < destHeight; py++) {
+            if (memcmp(&dest[py * destPitch], &expected[py * destPitch], destWidth * 4) != 0) {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+int main()
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    const char* kernels = "SSE2";
+#elif defined(__ARM_NEON)
+    const char* kernels = "NEON";
+#else
+    const char* kernels = "plain C";
+#endif
+
+    srand(1);
+    int rowMismatches = checkRows();
+    int sampledMismatches = checkSampled();
+
+    printf("softBlend (%s): %d row mismatches, %d sampled row mismatches\n", kernels, rowMismatches, sampledMismatches);
+    return (rowMismatches == 0 && sampledMismatches == 0) ? 0 : 1;
+}
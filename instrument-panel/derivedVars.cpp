@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include "derivedVars.h"
+#include "aircraftRegistry.h"
+
+extern globalVars globals;
+
+struct DerivedDef
+{
+    int inputCount;
+    int inputs[MaxDerivedInputs];
+    double (*calc)(const double* in);
+};
+
+// Index of a SimVars member when SimVars is treated as an array of doubles
+#define SLOT(field) (int)(offsetof(SimVars, field) / sizeof(double))
+
+/// <summary>
+/// Average of the per-engine values in[1] to in[4] over
+/// the number of engines in in[0].
+/// </summary>
+static double averageEngines(const double* in)
+{
+    int engines = (int)in[0];
+    if (engines < 1) {
+        engines = 1;
+    }
+    else if (engines > 4) {
+        engines = 4;
+    }
+
+    double total = 0;
+    for (int i = 1; i <= engines; i++) {
+        total += in[i];
+    }
+
+    return total / engines;
+}
+
+/// <summary>
+/// Split fuel from all tanks between left/right
+/// by using main tank percentages as a ratio.
+/// Inputs are quantity, capacity, left % and right %.
+/// </summary>
+static void splitFuel(const double* in, double* leftPercent, double* rightPercent)
+{
+    double fuelPercent = 100 * in[0] / in[1];
+
+    if (in[2] == in[3]) {
+        *leftPercent = fuelPercent;
+        *rightPercent = fuelPercent;
+        return;
+    }
+
+    fuelPercent *= 2;
+    double totalPercent = in[2] + in[3];
+    *leftPercent = fuelPercent * in[2] / totalPercent;
+    *rightPercent = fuelPercent * in[3] / totalPercent;
+
+    // Normalise percentages (maintain overall percent)
+    if (*leftPercent > 100) {
+        *rightPercent += *leftPercent - 100;
+        *leftPercent = 100;
+    }
+
+    if (*rightPercent > 100) {
+        *leftPercent += *rightPercent - 100;
+        *rightPercent = 100;
+    }
+}
+
+static double fuelLeft(const double* in)
+{
+    double left, right;
+    splitFuel(in, &left, &right);
+    return left;
+}
+
+static double fuelRight(const double* in)
+{
+    double left, right;
+    splitFuel(in, &left, &right);
+    return right;
+}
+
+/// <summary>
+/// Whether the instruments have power (if connected).
+/// Inputs are main bus volts and battery load.
+/// </summary>
+static double electrics(const double* in)
+{
+    switch (globals.aircraftTraits->electrics) {
+    case ELECTRICS_MAIN_BUS:
+        // Instruments don't come on if running on batteries only.
+        // Need external power, APU or main engines.
+        return in[0] > 25.4;
+    case ELECTRICS_BATTERY_LOAD:
+        return in[1] < 0;
+    default:
+        return in[0] > 0;
+    }
+}
+
+/// <summary>
+/// Whether the radios have power (if connected).
+/// Inputs are the status of both radios.
+/// </summary>
+static double avionics(const double* in)
+{
+    return in[0] == 0 || in[1] == 0;
+}
+
+/// <summary>
+/// Touchdown vertical speed in feet per minute (feet per second in sim)
+/// </summary>
+static double landingRateFpm(const double* in)
+{
+    return (int)((in[0] * 60) + 0.5);
+}
+
+static const DerivedDef DerivedDefs[] = {
+    { 5, { SLOT(numberOfEngines), SLOT(oilTemp1), SLOT(oilTemp2), SLOT(oilTemp3), SLOT(oilTemp4) }, averageEngines },
+    { 5, { SLOT(numberOfEngines), SLOT(oilPressure1), SLOT(oilPressure2), SLOT(oilPressure3), SLOT(oilPressure4) }, averageEngines },
+    { 5, { SLOT(numberOfEngines), SLOT(exhaustGasTemp1), SLOT(exhaustGasTemp2), SLOT(exhaustGasTemp3), SLOT(exhaustGasTemp4) }, averageEngines },
+    { 5, { SLOT(numberOfEngines), SLOT(engineFuelFlow1), SLOT(engineFuelFlow2), SLOT(engineFuelFlow3), SLOT(engineFuelFlow4) }, averageEngines },
+    { 5, { SLOT(numberOfEngines), SLOT(turbineEngine1N1), SLOT(turbineEngine2N1), SLOT(turbineEngine3N1), SLOT(turbineEngine4N1) }, averageEngines },
+    { 4, { SLOT(fuelQuantity), SLOT(fuelCapacity), SLOT(fuelLeftPercent), SLOT(fuelRightPercent) }, fuelLeft },
+    { 4, { SLOT(fuelQuantity), SLOT(fuelCapacity), SLOT(fuelLeftPercent), SLOT(fuelRightPercent) }, fuelRight },
+    { 2, { SLOT(dcVolts), SLOT(batteryLoad) }, electrics },
+    { 2, { SLOT(com1Status), SLOT(com2Status) }, avionics },
+    { 1, { SLOT(landingRate) }, landingRateFpm }
+};
+
+static_assert(sizeof(DerivedDefs) / sizeof(DerivedDef) == DERIVED_COUNT, "DerivedDefs must match DerivedVar");
+
+derivedVars::derivedVars()
+{
+    memset(vars, 0, sizeof(vars));
+}
+
+/// <summary>
+/// Recalculate any values whose inputs have changed since the last update.
+/// Should be called once per frame before the instruments are updated.
+/// </summary>
+void derivedVars::update(const SimVars* simVars)
+{
+    const double* slots = (const double*)simVars;
+
+    // Some values depend on aircraft traits
+    bool aircraftChanged = (lastAircraft != globals.aircraft);
+    lastAircraft = globals.aircraft;
+
+    for (int i = 0; i < DERIVED_COUNT; i++) {
+        const DerivedDef* def = &DerivedDefs[i];
+        Derived* var = &vars[i];
+        bool changed = !var->valid || aircraftChanged;
+
+        for (int j = 0; j < def->inputCount; j++) {
+            double val = slots[def->inputs[j]];
+            if (val != var->inputs[j]) {
+                var->inputs[j] = val;
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            var->value = def->calc(var->inputs);
+            var->valid = true;
+        }
+    }
+}
+
+double derivedVars::get(DerivedVar var) const
+{
+    return vars[var].value;
+}
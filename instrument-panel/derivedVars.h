@@ -0,0 +1,51 @@
+#ifndef _DERIVED_VARS_H_
+#define _DERIVED_VARS_H_
+
+#include "globals.h"
+#include "simvarDefs.h"
+
+// Handles of the derived variables (same order as DerivedDefs)
+enum DerivedVar {
+    DERIVED_OIL_TEMP,
+    DERIVED_OIL_PRESSURE,
+    DERIVED_EXHAUST_GAS_TEMP,
+    DERIVED_ENGINE_FUEL_FLOW,
+    DERIVED_TURBINE_N1,
+    DERIVED_FUEL_LEFT_PERCENT,
+    DERIVED_FUEL_RIGHT_PERCENT,
+    DERIVED_ELECTRICS,
+    DERIVED_AVIONICS,
+    DERIVED_LANDING_RATE_FPM,
+    DERIVED_COUNT
+};
+
+const int MaxDerivedInputs = 5;
+
+/// <summary>
+/// Values calculated from SimVars that more than one instrument needs,
+/// e.g. oil pressure averaged over the number of engines. Each one is
+/// declared once with the SimVars it depends on and is only recalculated
+/// when one of those has changed (or the aircraft has changed).
+/// Inputs are copied before calculating so a value never mixes data
+/// from two updates.
+/// </summary>
+class derivedVars
+{
+private:
+    struct Derived
+    {
+        double inputs[MaxDerivedInputs];
+        double value;
+        bool valid;
+    };
+
+    Derived vars[DERIVED_COUNT];
+    Aircraft lastAircraft = UNDEFINED;
+
+public:
+    derivedVars();
+    void update(const SimVars* simVars);
+    double get(DerivedVar var) const;
+};
+
+#endif // _DERIVED_VARS_H_
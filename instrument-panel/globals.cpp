@@ -1,99 +1,45 @@
 #include "globals.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 
 extern globalVars globals;
 
 const int deltaDoubleSize = sizeof(DeltaDouble);
 const int deltaStringSize = sizeof(DeltaString);
 
+/// <summary>
+/// Look up the aircraft in the registry whenever the title changes
+/// </summary>
 void identifyAircraft(char* aircraft)
 {
-    // Identify aircraft
-    //sprintf(globals.error, aircraft);
-    if (strcmp(aircraft, globals.lastAircraft) != 0) {
-        bool foundAircraft = false;
+    // A title that fills the whole field has no terminator
+    char title[sizeof(globals.lastAircraft)];
+    strncpy(title, aircraft, sizeof(title) - 1);
+    title[sizeof(title) - 1] = '\0';
 
-        char* pos = strchr(aircraft, '3');
-        if (pos && *(pos - 1) == 'A') {
-            if (*(pos + 1) == '1') {
-                globals.aircraft = AIRBUS_A310;
-                foundAircraft = true;
-            }
-            else if (*(pos + 1) == '2' || *(pos + 1) == '8') {
-                globals.aircraft = FBW;
-                foundAircraft = true;
-            }
-        }
+    if (strcmp(title, globals.lastAircraft) != 0) {
+        const AircraftTraits* traits = globals.registry->identify(title);
 
-        if (!foundAircraft) {
-            if (strncmp(aircraft, globals.Cessna_152_Text, globals.Cessna_152_Len) == 0) {
-                globals.aircraft = CESSNA_152;
-            }
-            else if (strncmp(aircraft, globals.Cessna_172_Text, globals.Cessna_172_Len) == 0) {
-                globals.aircraft = CESSNA_172;
-            }
-            else if (strncmp(aircraft, globals.Cessna_CJ4_Text, globals.Cessna_CJ4_Len) == 0) {
-                globals.aircraft = CESSNA_CJ4;
-            }
-            else if (strncmp(aircraft, globals.Savage_Cub_Text, globals.Savage_Cub_Len) == 0) {
-                globals.aircraft = SAVAGE_CUB;
-            }
-            else if (strncmp(aircraft, globals.Shock_Ultra_Text, globals.Shock_Ultra_Len) == 0) {
-                globals.aircraft = SHOCK_ULTRA;
-            }
-            else if (strncmp(aircraft, globals.Boeing_747_Text, globals.Boeing_747_Len) == 0) {
-                globals.aircraft = BOEING_747;
-            }
-            else if (strncmp(aircraft, globals.Boeing_787_Text, globals.Boeing_787_Len) == 0) {
-                globals.aircraft = BOEING_787;
-            }
-            else if (strncmp(aircraft, globals.Supermarine_Spitfire_Text, globals.Supermarine_Spitfire_Len) == 0) {
-                globals.aircraft = SUPERMARINE_SPITFIRE;
-            }
-            else if (strncmp(aircraft, globals.F15_Eagle_Text, globals.F15_Eagle_Len) == 0) {
-                globals.aircraft = F15_EAGLE;
-            }
-            else if (strncmp(aircraft, globals.F18_Hornet_Text, globals.F18_Hornet_Len) == 0) {
-                globals.aircraft = F18_HORNET;
-            }
-            else if (strncmp(aircraft, globals.Hawker_Hunter_Text, globals.Hawker_Hunter_Len) == 0) {
-                globals.aircraft = HAWKER_HUNTER;
-            }
-            else if (strncmp(aircraft, globals.JustFlight_PA28_Text, globals.JustFlight_PA28_Len) == 0) {
-                globals.aircraft = JUSTFLIGHT_PA28;
-            }
-            else if (strncmp(aircraft, globals.SWS_Kodiak_100_Text, globals.SWS_Kodiak_100_Len) == 0) {
-                globals.aircraft = KODIAK_100;
-            }
-            else if (strncmp(aircraft, globals.Heli_H135_Text, globals.Heli_H135_Len) == 0) {
-                globals.aircraft = HELI_H135;
-            }
-            else if (strncmp(aircraft, globals.Glider_DG_LS8_Text, globals.Glider_DG_LS8_Len) == 0) {
-                globals.aircraft = GLIDER;
-            }
-            else if (strncmp(aircraft, globals.Glider_DG_1001E_Text, globals.Glider_DG_1001E_Len) == 0) {
-                globals.aircraft = GLIDER;
-            }
-            else if (strncmp(aircraft, globals.Ornithopter_Text, globals.Ornithopter_Len) == 0) {
-                globals.aircraft = ORNITHOPTER;
-            }
-            else {
-                // Need to flip between other aircraft so that instruments
-                // can detect the aircraft has changed.
-                if (globals.aircraft == OTHER_AIRCRAFT) {
-                    globals.aircraft = OTHER_AIRCRAFT2;
-                }
-                else {
-                    globals.aircraft = OTHER_AIRCRAFT;
-                }
-            }
+        // Traits must be set before the id as instruments
+        // read them as soon as they see the id change.
+        globals.aircraftTraits = traits;
+
+        if (traits->id == OTHER_AIRCRAFT && globals.aircraft == OTHER_AIRCRAFT) {
+            // Need to flip between other aircraft so that instruments
+            // can detect the aircraft has changed.
+            globals.aircraft = OTHER_AIRCRAFT2;
         }
-        strcpy(globals.lastAircraft, aircraft);
+        else {
+            globals.aircraft = traits->id;
+        }
+        strcpy(globals.lastAircraft, title);
     }
 }
 
 /// <summary>
 /// Server can send us a delta rather than full data so we need to unpack it.
+/// Offsets are checked against the SimVar table so a corrupt or mismatched
+/// packet can't write outside a var.
 /// </summary>
 void receiveDelta(char *deltaData, int deltaSize, char* simVarsPtr)
 {
@@ -104,6 +50,9 @@ void receiveDelta(char *deltaData, int deltaSize, char* simVarsPtr)
         if (deltaDouble->offset & 0x10000) {
             // Must be a string
             DeltaString* deltaString = (DeltaString*)dataPtr;
+            if (deltaSize < deltaStringSize || !isValidDelta(deltaString->offset & 0xffff, true)) {
+                return;
+            }
             char* stringPtr = simVarsPtr + (deltaString->offset & 0xffff);
             strncpy(stringPtr, deltaString->data, 32);
             stringPtr[31] = '\0';
@@ -113,6 +62,9 @@ void receiveDelta(char *deltaData, int deltaSize, char* simVarsPtr)
         }
         else {
             // Must be a double
+            if (deltaSize < deltaDoubleSize || !isValidDelta(deltaDouble->offset, false)) {
+                return;
+            }
             char* doublePos = simVarsPtr + deltaDouble->offset;
             double* doublePtr = (double*)doublePos;
             *doublePtr = deltaDouble->data;
@@ -41,6 +41,13 @@
  * 
  *   settings/instrument-panel.json
  * 
+ * The settings file is reloaded automatically when it is saved so
+ * instruments can be moved, resized, shown or hidden without restarting.
+ * 
+ * The settings file can also contain a "Profiles" section with a
+ * separate layout for each aircraft. The panel switches to the
+ * profile whose name the aircraft title starts with.
+ * 
  * On Raspberry Pi you can configure hardware Rotary Encoders for each
  * instrument. Each rotary encoder is connected to two BCM GPIO pins
  * (+ ground centre pin). See individual instruments for pins used. Not
@@ -62,34 +69,10 @@
 #include <allegro5/allegro_font.h>
 #include "globals.h"
 #include "simvars.h"
-
-// Instruments
-#include "asi.h"
-#include "adi.h"
-#include "alt.h"
-#include "vor1.h"
-#include "tc.h"
-#include "hi.h"
-#include "vsi.h"
-#include "vor2.h"
-#include "trimFlaps.h"
-#include "rpm.h"
-#include "adf.h"
-#include "radCom.h"
-#include "annunciator.h"
-#include "trimFlaps2.h"
-#include "digitalClock.h"
-#include "fuel.h"
-#include "egt.h"
-#include "oil.h"
-#include "vac.h"
-#include "nav.h"
-
-#include "learjet/adiLearjet.h"
-#include "savageCub/asiSavageCub.h"
-#include "savageCub/rpmSavageCub.h"
-#include "savageCub/comSavageCub.h"
-#include "savageCub/xpdrSavageCub.h"
+#include "latency.h"
+#include "aircraftRegistry.h"
+#include "instrumentFactory.h"
+#include "qualityGovernor.h"
 
 // If you don't have any hardware knobs uncomment the next line
 //#define NoKnobs
@@ -110,11 +93,15 @@ struct globalVars globals;
 ALLEGRO_TIMER* timer = NULL;
 ALLEGRO_EVENT_QUEUE* eventQueue = NULL;
 std::list<instrument*> instruments;
+std::list<instrument*> disabledInstruments;
 char lastError[256] = "\0";
-int errorPersist;
+double errorExpires;
+qualityGovernor governor;
 extern const char* versionString;
-int versionPersist = 500;
-int displayLandingRate = 0;
+
+// Seconds to show messages for
+const double ErrorDisplayTime = 7;
+const double VersionDisplayTime = 15;
 
 /// <summary>
 /// Display an error message
@@ -152,6 +139,8 @@ void fatalError(const char* msg)
 /// </summary>
 void init(const char *settingsFile = NULL)
 {
+    // Registry must exist before the data link starts
+    globals.registry = new aircraftRegistry(globals.AircraftFile);
     globals.simVars = new simvars(settingsFile);
 
     if (Debug) {
@@ -221,6 +210,11 @@ void init(const char *settingsFile = NULL)
         al_set_window_position(globals.display, globals.monitorPositionX, globals.monitorPositionY);
     }
 
+    if (globals.softwareCompositing) {
+        // Instruments are composed in system memory (see softBlend)
+        al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    }
+
     al_hide_mouse_cursor(globals.display);
     al_inhibit_screensaver(true);
 
@@ -234,8 +228,9 @@ void init(const char *settingsFile = NULL)
     al_register_event_source(eventQueue, al_get_timer_event_source(timer));
 
 #ifndef _WIN32
-    // Only have hardware knobs on Raspberry Pi
-    if (HaveHardwareKnobs) {
+    // Only have hardware knobs on Raspberry Pi but
+    // virtual knobs can be used anywhere else.
+    if (HaveHardwareKnobs || globals.virtualKnobs[0] != '\0') {
         globals.hardwareKnobs = new knobs();
     }
 #endif
@@ -252,6 +247,13 @@ void cleanup()
         instruments.pop_front();
     }
 
+    while (!disabledInstruments.empty()) {
+        delete disabledInstruments.front();
+        disabledInstruments.pop_front();
+    }
+
+    instrument::destroyBitmapCache();
+
     if (timer) {
         al_destroy_timer(timer);
     }
@@ -287,47 +289,15 @@ void updateCommon()
 {
     SimVars* simVars = &globals.simVars->simVars;
 
-    // Electrics check
-    if (globals.aircraft == FBW) {
-        // Instruments don't come on if running on batteries only.
-        // Need external power, APU or main engines.
-        globals.electrics = globals.connected && simVars->dcVolts > 25.4;
-    }
-    else if (globals.aircraft == AIRBUS_A310) {
-        globals.electrics = globals.connected && simVars->batteryLoad < 0;
-    }
-    else {
-        globals.electrics = globals.connected && simVars->dcVolts > 0;
-    }
+    // Recalculate values shared by instruments
+    derivedVars* derived = &globals.simVars->derived;
+    derived->update(simVars);
 
-    // Avionics check
-    globals.avionics = globals.connected && (simVars->com1Status == 0 || simVars->com2Status == 0);
+    globals.electrics = globals.connected && derived->get(DERIVED_ELECTRICS) == 1;
+    globals.avionics = globals.connected && derived->get(DERIVED_AVIONICS) == 1;
 
-    if (globals.electrics && simVars->onGround && simVars->landingRate != -999) {
-        // Show touchdown vertical speed
-        displayLandingRate++;
-        if (displayLandingRate > 30) {
-            sprintf(globals.info, "Landing Rate: %d FPM", (int)((simVars->landingRate * 60) + 0.5));
-        }
-    }
-    else {
-        displayLandingRate = 0;
-        globals.info[0] = '\0';
-    }
-
-    // Show error if SkyTrack not recording (or CIX Logger not logging) but pushing back or running engines
-    if ((simVars->skytrackState == 1 || simVars->skytrackState == 3) && (simVars->pushbackState < 3 || simVars->rpmPercent > 10)) {
-        if (simVars->skytrackState == 1) {
-            sprintf(globals.error, "SkyTrack not started");
-        }
-        else {
-            sprintf(globals.error, "CIX Logger not started");
-        }
-    }
-    else if ((strcmp(globals.error, "SkyTrack not started") == 0 || strcmp(globals.error, "CIX Logger not started") == 0)
-        && simVars->skytrackState != 1 && simVars->skytrackState != 3) {
-        globals.error[0] = '\0';
-    }
+    // Raise or clear warnings and messages
+    globals.simVars->alerts.update(simVars, derived);
 }
 
 /// <summary>
@@ -335,6 +305,9 @@ void updateCommon()
 /// </summary>
 void doUpdate()
 {
+    globals.frameTime = al_get_time();
+    governor.startFrame();
+
     // Update variables common to all instruments
     updateCommon();
 
@@ -446,6 +419,9 @@ void showMessage(ALLEGRO_COLOR backgroundColour, const char *message)
 /// </summary>
 void doRender()
 {
+    // Count frames actually drawn (updates can run more often under load)
+    globals.frameCount++;
+
     // Clear background
     al_clear_to_color(al_map_rgb(0, 0, 0));
 
@@ -454,39 +430,53 @@ void doRender()
         instrument->render();
     }
 
+    const char* alertMessage;
+    AlertPriority priority;
+
     // Display any error message
     if (globals.error[0] != '\0') {
         showMessage(al_map_rgb(0x50, 0x10, 0x10), globals.error);
 
         if (strcmp(lastError, globals.error) == 0) {
             // Clear error message after a short delay
-            if (errorPersist > 0) {
-                errorPersist--;
-            }
-            else {
+            if (globals.frameTime >= errorExpires) {
                 globals.error[0] = '\0';
                 lastError[0] = '\0';
             }
         }
         else {
             strcpy(lastError, globals.error);
-            errorPersist = 200;
+            errorExpires = globals.frameTime + ErrorDisplayTime;
         }
     }
-    else if (globals.info[0] != '\0') {
-        // Display info message
-        showMessage(al_map_rgb(0x10, 0x10, 0x50), globals.info);
+    else if ((alertMessage = globals.simVars->alerts.topMessage(&priority)) != NULL) {
+        // Display highest priority alert
+        if (priority == PRIORITY_INFO) {
+            showMessage(al_map_rgb(0x10, 0x10, 0x50), alertMessage);
+        }
+        else {
+            showMessage(al_map_rgb(0x50, 0x10, 0x10), alertMessage);
+        }
     }
     else if (globals.arranging || globals.simulating) {
         char* text = globals.simVars->view();
         showMessage(al_map_rgb(0x10, 0x10, 0x50), text);
     }
 
-    if (versionPersist > 0) {
+    // Frame time starts when the program starts
+    if (globals.frameTime < VersionDisplayTime) {
         int x, y, width;
         getMessagePos(&x, &y, &width);
         al_draw_text(globals.font, al_map_rgb(0xa0, 0xa0, 0xa0), x + width - 80, y + 45, 0, versionString);
-        versionPersist--;
+    }
+
+    if (globals.showStats) {
+        char stats[80];
+        governor.getStats(stats, sizeof(stats));
+        al_set_clipping_rectangle(0, 0, 400, 30);
+        al_clear_to_color(al_map_rgb(0, 0, 0));
+        al_set_clipping_rectangle(0, 0, globals.displayWidth, globals.displayHeight);
+        al_draw_text(globals.font, al_map_rgb(0xa0, 0xa0, 0xa0), 10, 8, 0, stats);
     }
 }
 
@@ -523,6 +513,16 @@ void doKeypress(ALLEGRO_EVENT *event)
         globals.enableShadows = !globals.enableShadows;
         break;
 
+    case ALLEGRO_KEY_F:
+        // Show frame stats and quality level
+        globals.showStats = !globals.showStats;
+        break;
+
+    case ALLEGRO_KEY_L:
+        // Show knob latency histograms
+        latency::dump(stdout);
+        break;
+
     case ALLEGRO_KEY_ESCAPE:
         // Quit program
         globals.quit = true;
@@ -535,109 +535,172 @@ void doKeypress(ALLEGRO_EVENT *event)
 }
 
 /// <summary>
-/// Add instruments to panel
+/// Adds an instrument to the panel after any with the same or lower
+/// rank so instruments always stack in the same order.
 /// </summary>
-void addInstruments()
+void insertInstrument(instrument* inst)
 {
-    // Add instruments
-    if (globals.simVars->isEnabled("ASI")) {
-        instruments.push_back(new asi(300, 50, 300));
+    int rank = instrumentFactory::rank(inst->name);
+    auto pos = instruments.begin();
+    while (pos != instruments.end() && instrumentFactory::rank((*pos)->name) <= rank) {
+        pos++;
     }
 
-    if (globals.simVars->isEnabled("ADI")) {
-        instruments.push_back(new adi(700, 50, 300));
-    }
-
-    if (globals.simVars->isEnabled("ALT")) {
-        instruments.push_back(new alt(1100, 50, 300));
-    }
-
-    if (globals.simVars->isEnabled("VOR1")) {
-        instruments.push_back(new vor1(1500, 50, 300));
-    }
-
-    if (globals.simVars->isEnabled("TC")) {
-        instruments.push_back(new tc(300, 400, 300));
-    }
+    instruments.insert(pos, inst);
+}
 
-    if (globals.simVars->isEnabled("HI")) {
-        instruments.push_back(new hi(700, 400, 300));
+/// <summary>
+/// Add the instruments enabled in the settings file to the panel.
+/// Only enabled instruments are constructed so startup time doesn't
+/// depend on how many instruments there are.
+/// </summary>
+void addInstruments()
+{
+    // Make sure every instrument is in the settings file so it can be enabled
+    for (auto const& def : instrumentFactory::all()) {
+        if (def.defaultSize != 0) {
+            globals.simVars->addGroup(def.name);
+        }
     }
 
-    if (globals.simVars->isEnabled("VSI")) {
-        instruments.push_back(new vsi(1100, 400, 300));
-    }
+    std::vector<LayoutSetting> layout;
+    globals.simVars->getLayout(&layout);
 
-    if (globals.simVars->isEnabled("VOR2")) {
-        instruments.push_back(new vor2(1500, 400, 300));
-    }
+    for (auto const& setting : layout) {
+        if (!setting.enabled) {
+            continue;
+        }
 
-    if (globals.simVars->isEnabled("Trim Flaps")) {
-        instruments.push_back(new trimFlaps(700, 750, 300));
+        instrument* newInst = instrumentFactory::create(setting.name);
+        if (newInst) {
+            insertInstrument(newInst);
+        }
+        else {
+            snprintf(globals.error, sizeof(globals.error), "Settings file contains unknown instrument %s", setting.name);
+        }
     }
+}
 
-    if (globals.simVars->isEnabled("RPM")) {
-        instruments.push_back(new rpm(1100, 750, 300));
+/// <summary>
+/// Show an instrument that has been enabled in the settings file.
+/// Instruments that were previously disabled are reused.
+/// </summary>
+void enableInstrument(const char* name)
+{
+    for (auto it = disabledInstruments.begin(); it != disabledInstruments.end(); it++) {
+        if (strcmp((*it)->name, name) == 0) {
+            insertInstrument(*it);
+            disabledInstruments.erase(it);
+            return;
+        }
     }
 
-    if (globals.simVars->isEnabled("ADF")) {
-        instruments.push_back(new adf(1500, 750, 300));
+    instrument* newInst = instrumentFactory::create(name);
+    if (newInst) {
+        insertInstrument(newInst);
     }
-
-    if (globals.simVars->isEnabled("Rad Com")) {
-        instruments.push_back(new radCom(1500, 750, 300));
+    else {
+        snprintf(globals.error, sizeof(globals.error), "Settings file contains unknown instrument %s", name);
     }
+}
 
-    if (globals.simVars->isEnabled("Annunciator")) {
-        instruments.push_back(new annunciator(50, 50, 200));
+/// <summary>
+/// Hide an instrument that has been disabled in the settings file.
+/// It is kept so it can be shown again without reloading its bitmaps.
+/// </summary>
+void disableInstrument(const char* name)
+{
+    for (auto it = instruments.begin(); it != instruments.end(); it++) {
+        if (strcmp((*it)->name, name) == 0) {
+            disabledInstruments.push_back(*it);
+            instruments.erase(it);
+            return;
+        }
     }
+}
 
-    if (globals.simVars->isEnabled("Trim Flaps 2")) {
-        instruments.push_back(new trimFlaps2(50, 250, 200));
-    }
+/// <summary>
+/// Switch to a new layout. Only instruments that have been moved,
+/// resized, enabled or disabled are affected. Instruments that are
+/// not in the new layout are disabled.
+/// </summary>
+void changeLayout(std::vector<LayoutSetting>* layout)
+{
+    // Find instruments that are no longer wanted
+    std::vector<LayoutSetting> unwanted;
+    for (auto const& instrument : instruments) {
+        bool wanted = false;
+        for (auto const& setting : *layout) {
+            if (setting.enabled && strcmp(setting.name, instrument->name) == 0) {
+                wanted = true;
+                break;
+            }
+        }
 
-    if (globals.simVars->isEnabled("Digital Clock")) {
-        instruments.push_back(new digitalClock(250, 250, 200));
+        if (!wanted) {
+            LayoutSetting setting;
+            memset(&setting, 0, sizeof(setting));
+            strcpy(setting.name, instrument->name);
+            unwanted.push_back(setting);
+        }
     }
 
-    if (globals.simVars->isEnabled("Fuel")) {
-        instruments.push_back(new fuel(50, 500, 200));
+    int changes = 0;
+    for (auto const& setting : unwanted) {
+        globals.simVars->applyLayout(&setting);
+        disableInstrument(setting.name);
+        changes++;
     }
 
-    if (globals.simVars->isEnabled("EGT")) {
-        instruments.push_back(new egt(250, 500, 200));
-    }
+    for (auto const& setting : *layout) {
+        bool wasEnabled = globals.simVars->isEnabled(setting.name);
 
-    if (globals.simVars->isEnabled("Oil")) {
-        instruments.push_back(new oil(50, 750, 200));
-    }
+        // Updates the stored settings, adding instruments new to the file
+        if (globals.simVars->applyLayout(&setting)) {
+            changes++;
+        }
 
-    if (globals.simVars->isEnabled("VAC")) {
-        instruments.push_back(new vac(250, 750, 200));
+        if (setting.enabled && !wasEnabled) {
+            enableInstrument(setting.name);
+        }
+        else if (!setting.enabled && wasEnabled) {
+            disableInstrument(setting.name);
+        }
     }
 
-    if (globals.simVars->isEnabled("Nav")) {
-        instruments.push_back(new nav(50, 1000, 600));
-    }
+    printf("Layout changed: %d instruments affected\n", changes);
+    fflush(stdout);
+}
 
-    if (globals.simVars->isEnabled("ADI Learjet")) {
-        instruments.push_back(new adiLearjet(50, 50, 300));
+/// <summary>
+/// Apply any changes made to the settings file while running
+/// </summary>
+void reloadLayout()
+{
+    std::vector<LayoutSetting> layout;
+    if (globals.simVars->getReloadedLayout(&layout)) {
+        changeLayout(&layout);
     }
+}
 
-    if (globals.simVars->isEnabled("ASI Savage Cub")) {
-        instruments.push_back(new asiSavageCub(50, 50, 300));
-    }
+/// <summary>
+/// Switch to the layout profile for the current aircraft if the
+/// settings file has one, otherwise back to the main layout.
+/// </summary>
+void checkProfile()
+{
+    static char profileAircraft[sizeof(globals.lastAircraft)] = "\0";
 
-    if (globals.simVars->isEnabled("RPM Savage Cub")) {
-        instruments.push_back(new rpmSavageCub(350, 50, 300));
+    if (strcmp(profileAircraft, globals.lastAircraft) == 0) {
+        return;
     }
 
-    if (globals.simVars->isEnabled("COM Savage Cub")) {
-        instruments.push_back(new comSavageCub(350, 50, 300));
-    }
+    strncpy(profileAircraft, globals.lastAircraft, sizeof(profileAircraft) - 1);
+    profileAircraft[sizeof(profileAircraft) - 1] = '\0';
 
-    if (globals.simVars->isEnabled("XPDR Savage Cub")) {
-        instruments.push_back(new xpdrSavageCub(350, 50, 300));
+    std::vector<LayoutSetting> layout;
+    if (globals.simVars->getProfileLayout(profileAircraft, &layout)) {
+        changeLayout(&layout);
     }
 }
 
@@ -675,7 +738,10 @@ int main(int argc, char **argv)
 
         switch (event.type) {
             case ALLEGRO_EVENT_TIMER:
+                reloadLayout();
+                checkProfile();
                 doUpdate();
+                latency::frameDone();
                 redraw = true;
                 break;
 
@@ -690,7 +756,9 @@ int main(int argc, char **argv)
 
         if (redraw && al_is_event_queue_empty(eventQueue) && !globals.quit) {
             doRender();
+            double renderEnd = al_get_time();
             al_flip_display();
+            governor.endFrame(renderEnd);
             redraw = false;
         }
     }
@@ -707,5 +775,10 @@ int main(int argc, char **argv)
 #endif
 
     cleanup();
+
+    if (globals.registry) {
+        delete globals.registry;
+    }
+
     return 0;
 }
@@ -1,20 +1,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "instrument.h"
+#include "rotationCache.h"
 #include "simvars.h"
+#include "instrumentFactory.h"
 
 /// <summary>
 /// Default Constructor
 /// </summary>
 instrument::instrument()
 {
+    static int nextSlot = 0;
+
     bitmapCount = 0;
+    redrawSlot = nextSlot++ % ReducedRateFrames;
 }
 
 /// <summary>
 /// Constructor
 /// </summary>
-instrument::instrument(int xPos, int yPos, int size)
+instrument::instrument(int xPos, int yPos, int size) : instrument()
 {
     this->xPos = xPos;
     this->yPos = yPos;
@@ -26,13 +31,104 @@ instrument::instrument(int xPos, int yPos, int size)
 /// </summary>
 instrument::~instrument()
 {
-    if (customInstrument != NULL) {
-        delete customInstrument;
+    // Custom instrument is always one of the variants
+    for (auto const& variant : variants) {
+        delete variant.inst;
     }
 
     destroyBitmaps();
 }
 
+/// <summary>
+/// Replace this instrument with the named variant or go back to this
+/// instrument if the name is empty. Variants are only constructed the
+/// first time they are used.
+/// </summary>
+void instrument::useVariant(const char* variantName)
+{
+    customInstrument = NULL;
+
+    if (variantName == NULL || variantName[0] == '\0') {
+        return;
+    }
+
+    for (auto const& variant : variants) {
+        if (strcmp(variant.name, variantName) == 0) {
+            customInstrument = variant.inst;
+            return;
+        }
+    }
+
+    instrument* inst = instrumentFactory::createVariant(variantName, name, xPos, yPos, size);
+    if (inst == NULL) {
+        return;
+    }
+
+    Variant variant;
+    strncpy(variant.name, variantName, 63);
+    variant.name[63] = '\0';
+    variant.inst = inst;
+    variants.push_back(variant);
+
+    customInstrument = inst;
+}
+
+/// <summary>
+/// Returns true if shadows should be drawn. They can be turned off by
+/// the user or when quality is reduced.
+/// </summary>
+bool instrument::showShadows()
+{
+    if (!globals.enableShadows) {
+        return false;
+    }
+
+    return globals.quality < (secondary ? QUALITY_FEWER_SHADOWS : QUALITY_NO_SHADOWS);
+}
+
+/// <summary>
+/// Slow moving instruments can call this to skip redrawing their
+/// display on most frames when quality is reduced. The last drawn
+/// display should still be put on screen.
+/// </summary>
+bool instrument::skipRedraw()
+{
+    // Always draw the display the first time after it is created
+    if (globals.quality < QUALITY_REDUCED_RATE || !displayDrawn) {
+        displayDrawn = true;
+        return false;
+    }
+
+    return globals.frameCount % ReducedRateFrames != redrawSlot;
+}
+
+/// <summary>
+/// Returns true if the background needs composing again, i.e. after a
+/// resize, when shadows are turned on or off or when the key changes.
+/// The key is any slow moving value the background depends on, e.g. a
+/// calibration setting. When true the background has been cleared and
+/// is the target bitmap so the caller can draw its static layers.
+/// </summary>
+bool instrument::updateBackground(double key)
+{
+    bool shadows = showShadows();
+
+    if (background != NULL && backgroundKey == key && backgroundShadows == shadows) {
+        return false;
+    }
+
+    if (background == NULL) {
+        background = al_create_bitmap(size, size);
+    }
+
+    backgroundKey = key;
+    backgroundShadows = shadows;
+
+    al_set_target_bitmap(background);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    return true;
+}
+
 /// <summary>
 /// Each instrument needs to give itself a name
 /// </summary>
@@ -46,7 +142,21 @@ void instrument::setName(const char *name)
 }
 
 /// <summary>
-/// Load a bitmap from the bitmap directory
+/// Bitmap files are only decoded once and kept in memory so that
+/// instruments can be created quickly when the layout changes.
+/// </summary>
+struct CachedBitmap
+{
+    char filepath[256];
+    ALLEGRO_BITMAP* bitmap;
+};
+
+static CachedBitmap bitmapCache[MaxCachedBitmaps];
+static int cachedBitmapCount = 0;
+
+/// <summary>
+/// Load a bitmap from the bitmap directory. The caller owns the
+/// returned bitmap which is a copy of the cached original.
 /// </summary>
 ALLEGRO_BITMAP *instrument::loadBitmap(const char* filename)
 {
@@ -54,15 +164,49 @@ ALLEGRO_BITMAP *instrument::loadBitmap(const char* filename)
     strcpy(filepath, globals.BitmapDir);
     strcat(filepath, filename);
 
-    ALLEGRO_BITMAP* bitmap = al_load_bitmap(filepath);
-    if (!bitmap) {
+    for (int i = 0; i < cachedBitmapCount; i++) {
+        if (strcmp(bitmapCache[i].filepath, filepath) == 0) {
+            return al_clone_bitmap(bitmapCache[i].bitmap);
+        }
+    }
+
+    // Keep decoded original in system memory rather than video memory
+    int flags = al_get_new_bitmap_flags();
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    ALLEGRO_BITMAP* cached = al_load_bitmap(filepath);
+    al_set_new_bitmap_flags(flags);
+
+    if (!cached) {
         sprintf(globals.error, "Missing bitmap: %s", filepath);
         return NULL;
     }
 
+    ALLEGRO_BITMAP* bitmap = al_clone_bitmap(cached);
+
+    if (cachedBitmapCount < MaxCachedBitmaps) {
+        strcpy(bitmapCache[cachedBitmapCount].filepath, filepath);
+        bitmapCache[cachedBitmapCount].bitmap = cached;
+        cachedBitmapCount++;
+    }
+    else {
+        al_destroy_bitmap(cached);
+    }
+
     return bitmap;
 }
 
+/// <summary>
+/// Free the decoded originals of all loaded bitmaps
+/// </summary>
+void instrument::destroyBitmapCache()
+{
+    for (int i = 0; i < cachedBitmapCount; i++) {
+        al_destroy_bitmap(bitmapCache[i].bitmap);
+    }
+
+    cachedBitmapCount = 0;
+}
+
 void instrument::addBitmap(ALLEGRO_BITMAP* bitmap)
 {
     if (bitmapCount >= MaxBitmaps) {
@@ -83,10 +227,13 @@ void instrument::destroyBitmaps()
 {
     // Destroy all bitmaps
     for (int i = 0; i < bitmapCount; i++) {
+        softBlend::release(bitmaps[i]);
+        rotationCache::release(bitmaps[i]);
         al_destroy_bitmap(bitmaps[i]);
     }
 
     bitmapCount = 0;
+    displayDrawn = false;
 
     if (dim) {
         al_destroy_bitmap(dim);
@@ -97,6 +244,12 @@ void instrument::destroyBitmaps()
         al_destroy_bitmap(semiDim);
         semiDim = NULL;
     }
+
+    if (background) {
+        softBlend::release(background);
+        al_destroy_bitmap(background);
+        background = NULL;
+    }
 }
 
 /// <summary>
@@ -104,6 +257,10 @@ void instrument::destroyBitmaps()
 /// </summary>
 void instrument::dimInstrument(bool fullDim)
 {
+    // Always drawn onto the display so keep in video memory (even if software compositing)
+    int flags = al_get_new_bitmap_flags();
+    al_set_new_bitmap_flags(flags & ~ALLEGRO_MEMORY_BITMAP);
+
     if (fullDim && dim == NULL) {
         dim = loadBitmap("dim.png");
     }
@@ -112,6 +269,8 @@ void instrument::dimInstrument(bool fullDim)
         semiDim = loadBitmap("semi-dim.png");
     }
 
+    al_set_new_bitmap_flags(flags);
+
     ALLEGRO_BITMAP* bmp;
     if (fullDim) {
         bmp = dim;
@@ -3,17 +3,25 @@
 
 #include <allegro5/allegro.h>
 #include <list>
+#include <vector>
 #include "globals.h"
+#include "softBlend.h"
 
 extern globalVars globals;
 
 // Set maximum number of bitmaps per instrument
 const int MaxBitmaps = 25;
 
+// Set maximum number of decoded bitmap files shared by all instruments
+const int MaxCachedBitmaps = 128;
+
 // Convert Allegro4 angle (256 = full circle) into radians
 const double AngleFactor = 2.0f * ALLEGRO_PI / 256.0f;
 const double DegreesToRadians = ALLEGRO_PI / 180.0f;
 
+// Slow moving instruments are redrawn once every this many frames at reduced quality
+const int ReducedRateFrames = 4;
+
 class instrument
 {
 protected:
@@ -23,6 +31,30 @@ protected:
     ALLEGRO_BITMAP* semiDim = NULL;
     instrument* customInstrument = NULL;
 
+    // Layers that only change on resize (or slowly) composed once (see updateBackground)
+    ALLEGRO_BITMAP* background = NULL;
+
+    // Less important instruments lose their shadows first at reduced quality
+    bool secondary = false;
+
+private:
+    struct Variant
+    {
+        char name[64];
+        instrument* inst;
+    };
+
+    // Variants that have been used (kept for the next time they are needed)
+    std::vector<Variant> variants;
+
+    // Frame that this instrument redraws on at a reduced rate (spreads the work)
+    int redrawSlot;
+    bool displayDrawn = false;
+
+    // What the background was last composed with
+    bool backgroundShadows = false;
+    double backgroundKey = 0;
+
 public:
     char name[256];
     int xPos = 0;
@@ -31,18 +63,23 @@ public:
 
     instrument();
     instrument(int xPos, int yPos, int size);
-    ~instrument();
+    virtual ~instrument();
     void setName(const char* name);
     void dimInstrument(bool fullDim = true);
     virtual void resize() = 0;
     virtual void render() = 0;
     virtual void update() = 0;
     virtual void updateCustom(double val);
+    static void destroyBitmapCache();
 
 protected:
     ALLEGRO_BITMAP* loadBitmap(const char* filename);
     void addBitmap(ALLEGRO_BITMAP* bitmap);
     void destroyBitmaps();
+    void useVariant(const char* variantName);
+    bool showShadows();
+    bool skipRedraw();
+    bool updateBackground(double key = 0);
 };
 
 #endif // _INSTRUMENT_H
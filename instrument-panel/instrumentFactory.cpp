@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "instrumentFactory.h"
+#include "gauge.h"
+
+/// <summary>
+/// Instruments register themselves during static initialisation
+/// so the list must be created on first use.
+/// </summary>
+std::vector<InstrumentDef>& instrumentFactory::defs()
+{
+    static std::vector<InstrumentDef> registered;
+    return registered;
+}
+
+bool instrumentFactory::add(const char* name, const char* parent, InstrumentConstructor create, int rank, int defaultX, int defaultY, int defaultSize)
+{
+    InstrumentDef def = { name, parent, create, rank, defaultX, defaultY, defaultSize };
+    defs().push_back(def);
+    return true;
+}
+
+const std::vector<InstrumentDef>& instrumentFactory::all()
+{
+    return defs();
+}
+
+const InstrumentDef* instrumentFactory::find(const char* name)
+{
+    for (auto const& def : defs()) {
+        if (strcmp(def.name, name) == 0) {
+            return &def;
+        }
+    }
+
+    return NULL;
+}
+
+/// <summary>
+/// Returns the drawing rank of the named instrument. Gauges that are
+/// only in the gauges folder are drawn after (on top of) the rest.
+/// </summary>
+int instrumentFactory::rank(const char* name)
+{
+    const InstrumentDef* def = find(name);
+    if (def == NULL) {
+        return INT_MAX;
+    }
+
+    return def->rank;
+}
+
+/// <summary>
+/// Create the named instrument at its default position or
+/// return NULL if there is no such instrument.
+/// </summary>
+instrument* instrumentFactory::create(const char* name)
+{
+    const InstrumentDef* def = find(name);
+    if (def == NULL) {
+        if (gauge::isDefined(name)) {
+            return new gauge(50, 50, 300, name);
+        }
+        return NULL;
+    }
+
+    if (def->defaultSize == 0) {
+        // Only available as a variant
+        return NULL;
+    }
+
+    return def->create(def->defaultX, def->defaultY, def->defaultSize, NULL);
+}
+
+/// <summary>
+/// Create a variant to replace the parent instrument. Any gauge can be
+/// used as a variant but other instruments must be registered as a
+/// variant of the parent.
+/// </summary>
+instrument* instrumentFactory::createVariant(const char* name, const char* parent, int xPos, int yPos, int size)
+{
+    const InstrumentDef* def = find(name);
+    if (def == NULL) {
+        if (gauge::isDefined(name)) {
+            return new gauge(xPos, yPos, size, name, parent);
+        }
+        snprintf(globals.error, sizeof(globals.error), "Unknown variant %s for instrument %s", name, parent);
+        return NULL;
+    }
+
+    if (def->parent == NULL || strcmp(def->parent, parent) != 0) {
+        snprintf(globals.error, sizeof(globals.error), "%s is not a variant of %s", name, parent);
+        return NULL;
+    }
+
+    return def->create(xPos, yPos, size, parent);
+}
@@ -0,0 +1,64 @@
+#ifndef _INSTRUMENT_FACTORY_H_
+#define _INSTRUMENT_FACTORY_H_
+
+#include <vector>
+#include "instrument.h"
+
+typedef instrument* (*InstrumentConstructor)(int xPos, int yPos, int size, const char* parentName);
+
+/// <summary>
+/// A registered instrument. Variants name the instrument they can
+/// replace and are only constructed when an aircraft needs them.
+/// Instruments with a default size can be enabled in the settings file.
+/// Instruments are drawn in order of rank so overlapping instruments
+/// stack the same way whatever order the settings file lists them in.
+/// </summary>
+struct InstrumentDef
+{
+    const char* name;
+    const char* parent;
+    InstrumentConstructor create;
+    int rank;
+    int defaultX;
+    int defaultY;
+    int defaultSize;
+};
+
+/// <summary>
+/// Every instrument class registers itself here (see the macros below)
+/// so the panel can be built from the settings file without a list of
+/// all instruments. Anything not registered is looked for in the gauges
+/// folder.
+/// </summary>
+class instrumentFactory
+{
+public:
+    static bool add(const char* name, const char* parent, InstrumentConstructor create, int rank, int defaultX, int defaultY, int defaultSize);
+    static const std::vector<InstrumentDef>& all();
+    static const InstrumentDef* find(const char* name);
+    static int rank(const char* name);
+    static instrument* create(const char* name);
+    static instrument* createVariant(const char* name, const char* parent, int xPos, int yPos, int size);
+
+private:
+    static std::vector<InstrumentDef>& defs();
+};
+
+// Register an instrument that can be enabled in the settings file
+#define REGISTER_INSTRUMENT(cls, name, rank, defaultX, defaultY, defaultSize) \
+    static instrument* create_##cls(int xPos, int yPos, int size, const char* parentName) \
+    { \
+        return new cls(xPos, yPos, size); \
+    } \
+    static bool cls##Registered = instrumentFactory::add(name, NULL, create_##cls, rank, defaultX, defaultY, defaultSize)
+
+// Register a variant of the parent instrument. A default size of 0
+// means it can only be used as a variant.
+#define REGISTER_VARIANT(cls, name, parent, rank, defaultX, defaultY, defaultSize) \
+    static instrument* create_##cls(int xPos, int yPos, int size, const char* parentName) \
+    { \
+        return new cls(xPos, yPos, size, parentName); \
+    } \
+    static bool cls##Registered = instrumentFactory::add(name, parent, create_##cls, rank, defaultX, defaultY, defaultSize)
+
+#endif // _INSTRUMENT_FACTORY_H_
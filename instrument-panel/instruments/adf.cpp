@@ -1,9 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "adf.h"
-#include "alternate/gForce.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(adf, "ADF", 11, 1500, 750, 300);
 
 adf::adf(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -85,17 +88,17 @@ void adf::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add locator
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
 
     // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
     // Add top
-    al_draw_bitmap(bitmaps[4], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[4], 0, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -113,15 +116,8 @@ void adf::update()
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (loadedAircraft == F15_EAGLE || loadedAircraft == F18_HORNET || loadedAircraft == HAWKER_HUNTER) {
-            customInstrument = new gForce(xPos, yPos, size, name);
-        }
+        // Use custom instrument for this aircraft if we have one (can be any gauge)
+        useVariant(globals.aircraftTraits->variant("ADF"));
     }
 
     if (customInstrument) {
@@ -3,6 +3,9 @@
 #include "adi.h"
 #include "simvars.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(adi, "ADI", 2, 700, 50, 300);
 
 adi::adi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -113,54 +116,54 @@ void adi::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add back horizon and rotate
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add horizon shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 400, 415 * scaleFactor, (415 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 400, 400, 415 * scaleFactor, (415 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add horizon
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add rim shadow
-        al_draw_bitmap(bitmaps[6], 15 * scaleFactor, 15 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[6], 15 * scaleFactor, 15 * scaleFactor);
 
         // Add outer pointer shadow
-        al_draw_bitmap(bitmaps[9], 315 * scaleFactor, 15 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[9], 315 * scaleFactor, 15 * scaleFactor);
 
         // Add middle pointer shadow
-        al_draw_bitmap(bitmaps[11], 15 * scaleFactor, (355 - currentAdiCal * 10) * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[11], 15 * scaleFactor, (355 - currentAdiCal * 10) * scaleFactor);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add middle pointer
-    al_draw_bitmap(bitmaps[10], 0, (340 - currentAdiCal * 10) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[10], 0, (340 - currentAdiCal * 10) * scaleFactor);
 
     // Add background
-    al_draw_bitmap(bitmaps[7], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[7], 0, 0);
 
     // Add rim
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[5], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
     // Add outer casing
-    al_draw_bitmap(bitmaps[8], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[8], 0, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -193,60 +196,10 @@ void adi::update()
 
     // Calculate values
     double targetPitch = simVars->adiPitch;
-    double diff = abs(targetPitch - pitchAngle);
-
-    if (diff > 80.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 20.0; else pitchAngle -= 20.0;
-    }
-    else if (diff > 40.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 10.0; else pitchAngle -= 10.0;
-    }
-    else if (diff > 20.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 5.0; else pitchAngle -= 5.0;
-    }
-    else if (diff > 10.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 2.5; else pitchAngle -= 2.5;
-    }
-    else if (diff > 5.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 1.25; else pitchAngle -= 1.25;
-    }
-    else if (diff > 0.625) {
-        if (pitchAngle < targetPitch) pitchAngle += 0.625; else pitchAngle -= 0.625;
-    }
-    else {
-        pitchAngle = targetPitch;
-    }
+    pitchSmooth.update(pitchAngle, targetPitch);
 
     double targetBank = simVars->adiBank;
-    diff = abs(targetBank - bankAngle);
-
-    // Stop instrument flipping by 360 degrees
-    if (diff > 300.0) {
-        if (bankAngle < targetBank) bankAngle += 360.0; else bankAngle -= 360.0;
-        diff = abs(targetBank - bankAngle);
-    }
-
-    if (diff > 80.0) {
-        if (bankAngle < targetBank) bankAngle += 20.0; else bankAngle -= 20.0;
-    }
-    else if (diff > 40.0) {
-        if (bankAngle < targetBank) bankAngle += 10.0; else bankAngle -= 10.0;
-    }
-    else if (diff > 20.0) {
-        if (bankAngle < targetBank) bankAngle += 5.0; else bankAngle -= 5.0;
-    }
-    else if (diff > 10.0) {
-        if (bankAngle < targetBank) bankAngle += 2.5; else bankAngle -= 2.5;
-    }
-    else if (diff > 5.0) {
-        if (bankAngle < targetBank) bankAngle += 1.25; else bankAngle -= 1.25;
-    }
-    else if (diff > 0.625) {
-        if (bankAngle < targetBank) bankAngle += 0.625; else bankAngle -= 0.625;
-    }
-    else {
-        bankAngle = targetBank;
-    }
+    bankSmooth.update(bankAngle, targetBank);
 
     if (currentAdiCal > adiCal && currentAdiCal > -10)
     {
@@ -3,6 +3,7 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class adi : public instrument
 {
@@ -13,6 +14,8 @@ private:
     // Instrument values (caclulated from variables and needed to draw the instrument)
     double bankAngle = 0;
     double pitchAngle = 0;
+    smoother pitchSmooth{ 0.2, 600, 0.625 };
+    smoother bankSmooth{ 0.2, 600, 0.625, 360 };
     int adiCal = 0;
     int currentAdiCal = 0;
 
@@ -1,9 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "alt.h"
-#include "alternate/altFast.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(alt, "ALT", 3, 1100, 50, 300);
 
 alt::alt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -11,6 +14,14 @@ alt::alt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     addVars();
     simVars = &globals.simVars->simVars;
 
+    // 1ft pointer moves fast so keeps half as many steps
+    int steps = globals.simVars->getRotationSteps(name);
+    if (steps > 0) {
+        pointer1000Cache.setSteps(steps);
+        pointer100Cache.setSteps(steps);
+        pointer1Cache.setSteps((steps + 1) / 2);
+    }
+
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
     if (globals.hardwareKnobs) {
@@ -117,65 +128,73 @@ void alt::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add outer scale (inches of mercury) and rotate
-    // 29.5 = 0 radians
-    angle = (29.5 - inhg) * 1.8;
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
-
-    // Add inner scale (millibars) and rotate
-    // 1000 = 0 radians
-    double mb = inhg * 33.86378746435;
-    angle = (1000.0f - mb) * 0.0525f;
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_INVERSE_DEST_COLOR, ALLEGRO_ONE);
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    // Pressure scales only move when the altimeter is set so compose them with the main dial
+    if (updateBackground(inhg)) {
+        // Add outer scale (inches of mercury) and rotate
+        // 29.5 = 0 radians
+        angle = (29.5 - inhg) * 1.8;
+        softBlend::drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+
+        // Add inner scale (millibars) and rotate
+        // 1000 = 0 radians
+        double mb = inhg * 33.86378746435;
+        angle = (1000.0f - mb) * 0.0525f;
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_INVERSE_DEST_COLOR, ALLEGRO_ONE);
+        softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+        if (showShadows()) {
+            // Set blender to multiply (shades of grey darken, white has no effect)
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
-        // Add inner hole shadow
-        al_draw_bitmap_region(bitmaps[7], 0, 0, 200, 200, 60 * scaleFactor, 310 * scaleFactor, 0);
+            // Add inner hole shadow
+            softBlend::drawBitmapRegion(bitmaps[7], 0, 0, 200, 200, 60 * scaleFactor, 310 * scaleFactor, 0);
 
-        // Add outer hole Shadow
-        al_draw_bitmap_region(bitmaps[8], 0, 0, 200, 200, 610 * scaleFactor, 310 * scaleFactor, 0);
+            // Add outer hole Shadow
+            softBlend::drawBitmapRegion(bitmaps[8], 0, 0, 200, 200, 610 * scaleFactor, 310 * scaleFactor, 0);
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
+            // Restore normal blender
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        }
 
-    // Add main dial
-    al_draw_bitmap(bitmaps[10], 0, 0, 0);
+        // Add main dial
+        softBlend::drawBitmap(bitmaps[10], 0, 0);
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+        if (showShadows()) {
+            // Set blender to multiply (shades of grey darken, white has no effect)
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
-        // Add pointer hole shadow
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 200, 200, 310 * scaleFactor, 410 * scaleFactor, 200 * scaleFactor, 200 * scaleFactor, 0);
+            // Add pointer hole shadow
+            softBlend::drawScaledBitmap(bitmaps[9], 0, 0, 200, 200, 310 * scaleFactor, 410 * scaleFactor, 200 * scaleFactor, 200 * scaleFactor, 0);
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+            // Restore normal blender
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        }
     }
 
+    // Draw stuff into dest bitmap
+    al_set_target_bitmap(bitmaps[1]);
+
+    // Copy background (replaces last frame)
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    softBlend::drawBitmap(background, 0, 0);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
     // Add 1000ft pointer
     // 0 = 0 radians
     angle = altitude * 0.0062832f;
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 100, 0);
+    pointer1000Cache.draw(bitmaps[4], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 100);
 
     // Add 100ft pointer
     // 0 = 0 radians
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 10, 0);
+    pointer100Cache.draw(bitmaps[5], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 10);
 
     // Add 1ft pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+    pointer1Cache.draw(bitmaps[6], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -192,18 +211,10 @@ void alt::update()
     bool aircraftChanged = (loadedAircraft != globals.aircraft);
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
-        fastAircraft = ((loadedAircraft != NO_AIRCRAFT && loadedAircraft != JUSTFLIGHT_PA28
-            && loadedAircraft != HELI_H135 && simVars->cruiseSpeed >= globals.FastAircraftSpeed) || loadedAircraft == ORNITHOPTER);
+        fastAircraft = globals.aircraftTraits->isFast(simVars->cruiseSpeed);
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (fastAircraft) {
-            customInstrument = new altFast(xPos, yPos, size, name);
-        }
+        // Use custom instrument for this aircraft if we have one
+        useVariant(fastAircraft ? "ALT Fast" : "");
         prevVal = simVars->sbEncoder[2];
     }
 
@@ -242,27 +253,10 @@ void alt::update()
 
     if (diff > 4000.0) {
         altitude = simVars->altAltitude;
-    }
-    else if (diff > 500.0) {
-        if (altitude < simVars->altAltitude) altitude += 200.0; else altitude -= 200.0;
-    }
-    else if (diff > 100.0) {
-        if (altitude < simVars->altAltitude) altitude += 40.0; else altitude -= 40.0;
-    }
-    else if (diff > 50.0) {
-        if (altitude < simVars->altAltitude) altitude += 20.0; else altitude -= 20.0;
-    }
-    else if (diff > 10.0) {
-        if (altitude < simVars->altAltitude) altitude += 5.0; else altitude -= 5.0;
-    }
-    else if (diff > 5.0) {
-        if (altitude < simVars->altAltitude) altitude += 2.0; else altitude -= 2.0;
-    }
-    else if (diff > 1) {
-        if (altitude < simVars->altAltitude) altitude += 1.0; else altitude -= 1.0;
+        altitudeSmooth.reset();
     }
     else {
-        altitude = simVars->altAltitude;
+        altitudeSmooth.update(altitude, simVars->altAltitude);
     }
 }
 
@@ -317,11 +311,10 @@ void alt::updateKnobs()
                 prevVal = val;
             }
         }
-        time(&lastCalAdjust);
+        lastCalAdjust = globals.frameTime;
     }
     else if (lastCalAdjust != 0) {
-        time(&now);
-        if (now - lastCalAdjust > 1) {
+        if (globals.frameTime - lastCalAdjust > 1) {
             lastCalAdjust = 0;
         }
     }
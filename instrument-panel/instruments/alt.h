@@ -3,6 +3,8 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "smoother.h"
+#include "rotationCache.h"
 
 class alt : public instrument
 {
@@ -16,15 +18,20 @@ private:
     double inhg;          // inches of mercury
     double angle;
     double altitude = 0;
+    smoother altitudeSmooth{ 0.15, 6000, 1 };
     bool isStdMode = false;
 
+    // Pre-rotated pointers (1ft pointer moves fast so coarser steps are not noticed)
+    rotationCache pointer1000Cache{ 1440 };
+    rotationCache pointer100Cache{ 1440 };
+    rotationCache pointer1Cache{ 720 };
+
     // Hardware knobs
     int calKnob = -1;
     int prevVal = 0;
     int prevValSb = 0;
     int prevPushSb = 0;
-    time_t lastCalAdjust = 0;
-    time_t now;
+    double lastCalAdjust = 0;
 
 public:
     alt(int xPos, int yPos, int size);
@@ -2,6 +2,13 @@
 #include <stdlib.h>
 #include "altFast.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(altFast, "ALT Fast", "ALT", 0, 0, 0, 0);
+
+// Height of the reel artwork (source pixels), covers every reel position
+const int SmallReelHeight = 54 * 9 + 162;
+const int LargeReelHeight = 262 + 131 * 8 + 393;
 
 altFast::altFast(int xPos, int yPos, int size, const char* parentName) : instrument(xPos, yPos, size)
 {
@@ -51,10 +58,14 @@ void altFast::resize()
 
     // 2 = Graduated transparency for altitude reels
     ALLEGRO_BITMAP* trans = al_create_bitmap(78 * scaleFactor, 393 * scaleFactor);
+    al_set_target_bitmap(trans);
+    al_draw_scaled_bitmap(orig, 289, 0, 262, 254, 0, 0, 78 * scaleFactor, 393 * scaleFactor, 0);
     addBitmap(trans);
 
     // 3 = Graduated transparency for pressure reels
     ALLEGRO_BITMAP* trans2 = al_create_bitmap(45 * scaleFactor, 162 * scaleFactor);
+    al_set_target_bitmap(trans2);
+    al_draw_scaled_bitmap(orig, 289, 0, 262, 254, 0, 0, 45 * scaleFactor, 162 * scaleFactor, 0);
     addBitmap(trans2);
 
     // 4 = Shadow background
@@ -70,7 +81,7 @@ void altFast::resize()
     // 6 = Fill with background colour (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(size, size);
     al_set_target_bitmap(bg);
-    al_draw_scaled_bitmap(orig, 75, 61, 1, 1, 0, 0, size, size, 0);
+    al_draw_scaled_bitmap(orig, 240, 312, 1, 1, 0, 0, size, size, 0);
     addBitmap(bg);
 
     // 7 = Pointer sprite
@@ -79,9 +90,52 @@ void altFast::resize()
     al_draw_bitmap_region(orig, 148, 649, 43, 562, 0, 0, 0);
     addBitmap(pointer);
 
+    // Reel strips are several times taller than the instrument so at large
+    // sizes can be more than the graphics driver allows. The digits are
+    // then drawn from the original bitmap instead.
+    int maxSize = al_get_display_option(globals.display, ALLEGRO_MAX_BITMAP_SIZE);
+    reelStrips = (maxSize <= 0 || LargeReelHeight * scaleFactor <= maxSize);
+
+    // 8 = Pressure reel strip (digits 9 to 0 with wrap around)
+    addBitmap(createReel(148, 45, SmallReelHeight, 45 * scaleFactor));
+
+    // 9 = Thousands altitude reel strip
+    addBitmap(createReel(0, 73, LargeReelHeight, 78 * scaleFactor));
+
+    // 10 = Hundreds and tens altitude reel strip
+    addBitmap(createReel(74, 73, LargeReelHeight, 78 * scaleFactor));
+
+    // 11 = Main dial
+    ALLEGRO_BITMAP* dial = al_create_bitmap(size, size);
+    al_set_target_bitmap(dial);
+    al_draw_scaled_bitmap(orig, 240, 312, 800, 800, 0, 0, size, size, 0);
+    addBitmap(dial);
+
     al_set_target_backbuffer(globals.display);
 }
 
+/// <summary>
+/// Returns a reel strip scaled from a column of the original bitmap or
+/// NULL if strips aren't being used. Clears reelStrips if it can't be
+/// created.
+/// </summary>
+ALLEGRO_BITMAP* altFast::createReel(int sourceX, int sourceWidth, int sourceHeight, int width)
+{
+    if (!reelStrips) {
+        return NULL;
+    }
+
+    ALLEGRO_BITMAP* reel = al_create_bitmap(width, sourceHeight * scaleFactor);
+    if (reel == NULL) {
+        reelStrips = false;
+        return NULL;
+    }
+
+    al_set_target_bitmap(reel);
+    al_draw_scaled_bitmap(bitmaps[0], sourceX, 0, sourceWidth, sourceHeight, 0, 0, width, sourceHeight * scaleFactor, 0);
+    return reel;
+}
+
 /// <summary>
 /// Draw the instrument at the stored position
 /// </summary>
@@ -98,19 +152,7 @@ void altFast::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Fill with black
-    al_draw_scaled_bitmap(bitmaps[0], 240, 312, 1, 1, 0, 0, size, size, 0);
-
-    // Copy graduated pattern artwork into trans2 bitmap for the small digits
-    int destWidth = 45 * scaleFactor;
-    int destHeight = 162 * scaleFactor;
-    al_set_target_bitmap(bitmaps[3]);
-    al_draw_scaled_bitmap(bitmaps[0], 289, 0, 262, 254, 0, 0, destWidth, destHeight, 0);
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Copy graduated pattern artwork into trans bitmap
-    al_set_target_bitmap(bitmaps[2]);
-    al_draw_scaled_bitmap(bitmaps[0], 289, 0, 262, 254, 0, 0, 78 * scaleFactor, 393 * scaleFactor, 0);
-    al_set_target_bitmap(bitmaps[1]);
+    softBlend::drawBitmap(bitmaps[6], 0, 0);
 
     // Add hPa Reels
     int val = (inhg * 33.86378746435) + 0.5;
@@ -160,10 +202,10 @@ void altFast::render()
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
     // Draw electrics on/off
-    al_draw_scaled_bitmap(bitmaps[0], 194, 0, 95, 31, 277 * scaleFactor, 681 * scaleFactor, 98 * scaleFactor, 33 * scaleFactor, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 194, 0, 95, 31, 277 * scaleFactor, 681 * scaleFactor, 98 * scaleFactor, 33 * scaleFactor, 0);
 
     // Display Dial
-    al_draw_scaled_bitmap(bitmaps[0], 240, 312, 800, 800, 0, 0, size, size, 0);
+    softBlend::drawBitmap(bitmaps[11], 0, 0);
 
     if (globals.aircraft == F15_EAGLE) {
         // Needle shows 1000's of feet
@@ -174,52 +216,64 @@ void altFast::render()
         angle = (altitude - (int)(altitude / 100) * 100.0) * 3.6 * DegreesToRadians;
     }
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Fill shadow_background bitmap with white
         al_set_target_bitmap(bitmaps[4]);
-        al_draw_scaled_bitmap(bitmaps[0], 192, 649, 1, 1, 0, 0, size, size, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 192, 649, 1, 1, 0, 0, size, size, 0);
 
         // Write shadow sprite to shadow background
-        al_draw_rotated_bitmap(bitmaps[5], 21 * scaleFactor, 322 * scaleFactor, 410 * scaleFactor, 420 * scaleFactor, angle, 0);
+        softBlend::drawRotatedBitmap(bitmaps[5], 21 * scaleFactor, 322 * scaleFactor, 410 * scaleFactor, 420 * scaleFactor, angle, 0);
         al_set_target_bitmap(bitmaps[1]);
 
         // Draw shadow
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[4], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[4], 0, 0);
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     //Draw needle pointer at angle
-    al_draw_scaled_rotated_bitmap(bitmaps[7], 21, 322, size / 2, size / 2, scaleFactor, scaleFactor, angle, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[7], 21, 322, size / 2, size / 2, scaleFactor, scaleFactor, angle, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
     }
 }
 
+/// <summary>
+/// Each reel is a single offset blit from the pre-scaled reel strip
+/// or is scaled from the original bitmap if there are no strips.
+/// </summary>
 void altFast::addSmallNumber(int yPos, int digit1, int digit2, int digit3, int digit4)
 {
     int destWidth = 45 * scaleFactor;
     int destHeight = 162 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit1), 45, 162, 486 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit2), 45, 162, 532 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit3), 45, 162, 578 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit4), 45, 162, 624 * scaleFactor, yPos, destWidth, destHeight, 0);
+    if (!reelStrips) {
+        softBlend::drawScaledBitmap(bitmaps[0], 148, 54 * (9 - digit1), 45, 162, 486 * scaleFactor, yPos, destWidth, destHeight, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 148, 54 * (9 - digit2), 45, 162, 532 * scaleFactor, yPos, destWidth, destHeight, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 148, 54 * (9 - digit3), 45, 162, 578 * scaleFactor, yPos, destWidth, destHeight, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 148, 54 * (9 - digit4), 45, 162, 624 * scaleFactor, yPos, destWidth, destHeight, 0);
+        return;
+    }
+
+    softBlend::drawBitmapRegion(bitmaps[8], 0, 54 * (9 - digit1) * scaleFactor, destWidth, destHeight, 486 * scaleFactor, yPos, 0);
+    softBlend::drawBitmapRegion(bitmaps[8], 0, 54 * (9 - digit2) * scaleFactor, destWidth, destHeight, 532 * scaleFactor, yPos, 0);
+    softBlend::drawBitmapRegion(bitmaps[8], 0, 54 * (9 - digit3) * scaleFactor, destWidth, destHeight, 578 * scaleFactor, yPos, 0);
+    softBlend::drawBitmapRegion(bitmaps[8], 0, 54 * (9 - digit4) * scaleFactor, destWidth, destHeight, 624 * scaleFactor, yPos, 0);
 }
 
 void altFast::addSmallShadow(int yPos)
 {
-    al_draw_bitmap(bitmaps[3], 486 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 532 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 578 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 624 * scaleFactor, yPos, 0);
+    softBlend::drawBitmap(bitmaps[3], 486 * scaleFactor, yPos);
+    softBlend::drawBitmap(bitmaps[3], 532 * scaleFactor, yPos);
+    softBlend::drawBitmap(bitmaps[3], 578 * scaleFactor, yPos);
+    softBlend::drawBitmap(bitmaps[3], 624 * scaleFactor, yPos);
 }
 
 void altFast::addLargeNumber(int yPos1, int yPos2, int yPos3)
@@ -228,18 +282,25 @@ void altFast::addLargeNumber(int yPos1, int yPos2, int yPos3)
     int destWidth = 78 * scaleFactor;
     int destHeight = 393 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[0], 0, yPos1, 73, 393, 70 * scaleFactor, destY, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 74, yPos2, 73, 393, 151 * scaleFactor, destY, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 74, yPos3, 73, 393, 233 * scaleFactor, destY, destWidth, destHeight, 0);
+    if (!reelStrips) {
+        softBlend::drawScaledBitmap(bitmaps[0], 0, yPos1, 73, 393, 70 * scaleFactor, destY, destWidth, destHeight, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 74, yPos2, 73, 393, 151 * scaleFactor, destY, destWidth, destHeight, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 74, yPos3, 73, 393, 233 * scaleFactor, destY, destWidth, destHeight, 0);
+        return;
+    }
+
+    softBlend::drawBitmapRegion(bitmaps[9], 0, yPos1 * scaleFactor, destWidth, destHeight, 70 * scaleFactor, destY, 0);
+    softBlend::drawBitmapRegion(bitmaps[10], 0, yPos2 * scaleFactor, destWidth, destHeight, 151 * scaleFactor, destY, 0);
+    softBlend::drawBitmapRegion(bitmaps[10], 0, yPos3 * scaleFactor, destWidth, destHeight, 233 * scaleFactor, destY, 0);
 }
 
 void altFast::addLargeShadow()
 {
     int destY = 202 * scaleFactor;
 
-    al_draw_bitmap(bitmaps[2], 70 * scaleFactor, destY, 0);
-    al_draw_bitmap(bitmaps[2], 151 * scaleFactor, destY, 0);
-    al_draw_bitmap(bitmaps[2], 233 * scaleFactor, destY, 0);
+    softBlend::drawBitmap(bitmaps[2], 70 * scaleFactor, destY);
+    softBlend::drawBitmap(bitmaps[2], 151 * scaleFactor, destY);
+    softBlend::drawBitmap(bitmaps[2], 233 * scaleFactor, destY);
 }
 
 /// <summary>
@@ -278,29 +339,7 @@ void altFast::updateCustom(double inhgVal)
     }
 
     // Calculate values
-    double diff = abs(simVars->altAltitude - altitude);
-
-    if (diff > 500.0) {
-        if (altitude < simVars->altAltitude) altitude += 200.0; else altitude -= 200.0;
-    }
-    else if (diff > 100.0) {
-        if (altitude < simVars->altAltitude) altitude += 40.0; else altitude -= 40.0;
-    }
-    else if (diff > 50.0) {
-        if (altitude < simVars->altAltitude) altitude += 20.0; else altitude -= 20.0;
-    }
-    else if (diff > 10.0) {
-        if (altitude < simVars->altAltitude) altitude += 5.0; else altitude -= 5.0;
-    }
-    else if (diff > 5.0) {
-        if (altitude < simVars->altAltitude) altitude += 2.0; else altitude -= 2.0;
-    }
-    else if (diff > 1) {
-        if (altitude < simVars->altAltitude) altitude += 1.0; else altitude -= 1.0;
-    }
-    else {
-        altitude = simVars->altAltitude;
-    }
+    altitudeSmooth.update(altitude, simVars->altAltitude);
 }
 
 /// <summary>
@@ -353,11 +392,10 @@ void altFast::updateKnobs()
                 prevVal = val;
             }
         }
-        time(&lastCalAdjust);
+        lastCalAdjust = globals.frameTime;
     }
     else if (lastCalAdjust != 0) {
-        time(&now);
-        if (now - lastCalAdjust > 1) {
+        if (globals.frameTime - lastCalAdjust > 1) {
             lastCalAdjust = 0;
         }
     }
@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class altFast : public instrument
 {
@@ -10,18 +11,19 @@ private:
     SimVars* simVars;
     float scaleFactor;
     bool hasParent;
+    bool reelStrips;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
     double inhg;
     double angle;
     double altitude = 0;
+    smoother altitudeSmooth{ 0.15, 6000, 1 };
 
     // Hardware knobs
     int calKnob = -1;
     int prevVal = 0;
     int prevValSb = 0;
-    time_t lastCalAdjust = 0;
-    time_t now;
+    double lastCalAdjust = 0;
 
 public:
     altFast(int xPos, int yPos, int size, const char* parentName = NULL);
@@ -31,6 +33,7 @@ public:
 
 private:
     void resize();
+    ALLEGRO_BITMAP* createReel(int sourceX, int sourceWidth, int sourceHeight, int width);
     void addSmallNumber(int yPos, int digit1, int digit2, int digit3, int digit4);
     void addSmallShadow(int yPos);
     void addLargeNumber(int yPos1, int yPos2, int yPos3);
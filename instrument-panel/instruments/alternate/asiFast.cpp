@@ -2,7 +2,11 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asiFast.h"
+#include "calibrationTables.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(asiFast, "ASI Fast", "ASI", 0, 0, 0, 0);
 
 asiFast::asiFast(int xPos, int yPos, int size, const char* parentName) : instrument(xPos, yPos, size)
 {
@@ -64,23 +68,20 @@ void asiFast::resize()
     al_draw_scaled_bitmap(orig, 801, 801, 800, 800, 0, 0, fsize, fsize, 0);
     addBitmap(shadowBackground);
 
-    // 4 = Shadow sprite (to be rotated)
-    ALLEGRO_BITMAP* shadowBackground2 = al_create_bitmap(800, 800);
-    addBitmap(shadowBackground2);
-
-    // 5 = Shadow sprite
+    // 4 = Shadow sprite on white (rotated and multiplied straight onto the destination)
     ALLEGRO_BITMAP* shadow = al_create_bitmap(149 * scaleFactor, 609 * scaleFactor);
     al_set_target_bitmap(shadow);
+    al_draw_scaled_bitmap(orig, 513, 863, 1, 1, 0, 0, 149 * scaleFactor, 609 * scaleFactor, 0);
     al_draw_scaled_bitmap(orig, 513, 863, 149, 609, 0, 0, 149 * scaleFactor, 609 * scaleFactor, 0);
     addBitmap(shadow);
 
-    // 6 = Pointer sprite
+    // 5 = Pointer sprite
     ALLEGRO_BITMAP* pointer = al_create_bitmap(111, 581);
     al_set_target_bitmap(pointer);
     al_draw_bitmap_region(orig, 153, 881, 111, 581, 0, 0, 0);
     addBitmap(pointer);
 
-    // 7 = Fill with background colour (takes 1 pixel of background and scales it)
+    // 6 = Fill with background colour (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(fsize, fsize);
     al_set_target_bitmap(bg);
     al_draw_scaled_bitmap(orig, 75, 61, 1, 1, 0, 0, fsize, fsize, 0);
@@ -107,49 +108,41 @@ void asiFast::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Draw background colour
-    al_draw_bitmap(bitmaps[7], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[6], 0, 0);
 
     // Display outer dial
     float centre = fsize / 2.0f;
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, centre, centre, scaleFactor, scaleFactor, machAngle * AngleFactor, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[2], 400, 400, centre, centre, scaleFactor, scaleFactor, machAngle * AngleFactor, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Display main dial shadow
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[3], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[3], 0, 0);
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Display dial (contains transparencies) over outer dial
-    al_draw_scaled_bitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, fsize, fsize, 0);
-
-    if (globals.enableShadows) {
-        // Fill shadow_background bitmap with white
-        al_set_target_bitmap(bitmaps[4]);
-        al_draw_scaled_bitmap(bitmaps[0], 513, 863, 1, 1, 0, 0, fsize, fsize, 0);
-
-        // Write shadow sprite to shadow background
-        al_draw_rotated_bitmap(bitmaps[5], 76 * scaleFactor, 367 * scaleFactor, 410 * scaleFactor, 430 * scaleFactor, airspeedAngle * AngleFactor, 0);
-        al_set_target_bitmap(bitmaps[1]);
+    softBlend::drawScaledBitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, fsize, fsize, 0);
 
+    if (showShadows()) {
         // Draw shadow
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[4], 0, 0, 0);
+        softBlend::drawRotatedBitmap(bitmaps[4], 76 * scaleFactor, 367 * scaleFactor, 410 * scaleFactor, 430 * scaleFactor, airspeedAngle * AngleFactor, 0);
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Draw needle pointer at angle
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 54, 348, centre, centre, scaleFactor, scaleFactor, airspeedAngle * AngleFactor, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[5], 54, 348, centre, centre, scaleFactor, scaleFactor, airspeedAngle * AngleFactor, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
 
     int fadjust = (fsize - size) / 2;
-    al_draw_bitmap(bitmaps[1], xPos - fadjust, yPos - fadjust, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos - fadjust, yPos - fadjust);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -181,21 +174,7 @@ void asiFast::update()
 #endif
 
     // Calculate airspeed angle
-    double speed = simVars->asiAirspeed / 10.0f;
-
-    if (speed > 400) {
-        targetAirspeedAngle = 233.65;
-    }
-    else if (speed > 0) {
-        targetAirspeedAngle = 0.0000052772 * pow(speed, 5) - 0.0003338205 * pow(speed, 4) - 0.0025509435 * pow(speed, 3) + 0.482328783 * pow(speed, 2) - 1.5416690771 * speed + 1.0500510789;
-        // Angle is not accurate below 3
-        if (targetAirspeedAngle < 3) {
-            targetAirspeedAngle = 0;
-        }
-    }
-    else {
-        targetAirspeedAngle = 0;
-    }
+    targetAirspeedAngle = asiFastAirspeedScale.lookup(simVars->asiAirspeed);
 
     // Smooth out airspeed adjustment at low speed
     if (targetAirspeedAngle < 5 && abs(targetAirspeedAngle - airspeedAngle) > .5f) {
@@ -211,7 +190,7 @@ void asiFast::update()
     }
 
     // Calculate mach angle
-    speed = simVars->asiMachSpeed;
+    double speed = simVars->asiMachSpeed;
 
     if (speed > 0.3) {
         machAngle = 256 - ((((251.3 * log(speed) + 446.1) + 4.02) * 0.71111111111111) - airspeedAngle);
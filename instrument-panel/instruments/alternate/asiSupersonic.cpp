@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asiSupersonic.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(asiSupersonic, "ASI Supersonic", "ASI", 0, 0, 0, 0);
 
 asiSupersonic::asiSupersonic(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -71,14 +75,14 @@ void asiSupersonic::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 25, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 25, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -103,29 +107,7 @@ void asiSupersonic::update()
     }
 
     // Calculate values
-    if (simVars->asiAirspeed < 50) {
-        // 0 to 20 degrees = 0 to 50 knots
-        angle = simVars->asiAirspeed * 20.0 / 50.0;
-    }
-    else if (simVars->asiAirspeed < 200) {
-        // 20 to 140 degrees = 50 to 200 knots
-        angle = 20 + (simVars->asiAirspeed - 50) * 120.0 / 150.0;
-    }
-    else if (simVars->asiAirspeed < 300) {
-        // 140 to 180 degrees = 200 to 300 knots
-        angle = 140 + (simVars->asiAirspeed - 200) * 40.0 / 100.0;
-    }
-    else if (simVars->asiAirspeed < 600) {
-        // 180 to 270 degrees = 300 to 600 knots
-        angle = 180 + (simVars->asiAirspeed - 300) * 90.0 / 300.0;
-    }
-    else if (simVars->asiAirspeed < 1000) {
-        // 270 to 340 degrees = 600 to 1000 knots
-        angle = 270 + (simVars->asiAirspeed - 600) * 70.0 / 400.0;
-    }
-    else {
-        angle = 340;
-    }
+    angle = asiSupersonicAirspeedScale.lookup(simVars->asiAirspeed);
 }
 
 /// <summary>
@@ -2,9 +2,14 @@
 #include <stdlib.h>
 #include <math.h>
 #include "rpmPercent.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(rpmPercent, "RPM Percent", "RPM", 0, 0, 0, 0);
 
 rpmPercent::rpmPercent(int xPos, int yPos, int size, const char* parentName) : instrument(xPos, yPos, size)
 {
+    secondary = true;
     if (parentName) {
         // Use position, size and vars from parent
         setName(parentName);
@@ -15,6 +20,7 @@ rpmPercent::rpmPercent(int xPos, int yPos, int size, const char* parentName) : i
     }
 
     simVars = &globals.simVars->simVars;
+    derived = &globals.simVars->derived;
     resize();
 }
 
@@ -101,30 +107,30 @@ void rpmPercent::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add reverse thrust indicator
     if (simVars->throttlePosition < 0) {
-        al_draw_bitmap(bitmaps[8], 362 * scaleFactor, 496 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[8], 362 * scaleFactor, 496 * scaleFactor);
     }
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -155,29 +161,11 @@ void rpmPercent::update()
     digit4 = (int)simVars->rpmElapsedTime % 10;
     digit5 = (int)(simVars->rpmElapsedTime * 10) % 10;
 
-    if (simVars->numberOfEngines == 2) {
-        turbineEngineN1 = (simVars->turbineEngine1N1 + simVars->turbineEngine2N1) / 2;
-    }
-    else if (simVars->numberOfEngines > 3) {
-        turbineEngineN1 = (simVars->turbineEngine1N1 + simVars->turbineEngine2N1 + simVars->turbineEngine3N1 + simVars->turbineEngine4N1) / 4;
-    }
-    else if (simVars->numberOfEngines == 3) {
-        turbineEngineN1 = (simVars->turbineEngine1N1 + simVars->turbineEngine2N1 + simVars->turbineEngine3N1) / 3;
-    }
-    else {
-        turbineEngineN1 = simVars->turbineEngine1N1;
-    }
+    turbineEngineN1 = derived->get(DERIVED_TURBINE_N1);
 
     // RPM percent dial begins at vertical and spans 315 degrees
     // The scale changes at 60 percent
-    if (turbineEngineN1 < 60) {
-        // The 0-60% arc spans 135 degrees
-        angle = 135 * (turbineEngineN1 / 60 );
-    }
-    else {
-        // The remaining 40% arc (60-100%) starts at 135 degs and spans 180 degrees
-        angle = 135 + (181 * (turbineEngineN1 - 60) / 40.0);    
-    }
+    angle = rpmPercentN1Scale.lookup(turbineEngineN1);
 }
 
 /// <summary>
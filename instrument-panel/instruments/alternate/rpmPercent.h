@@ -2,12 +2,14 @@
 #define _RPM_PERCENT_H_
 
 #include "simvars.h"
+#include "derivedVars.h"
 #include "instrument.h"
 
 class rpmPercent : public instrument
 {
 private:
     SimVars* simVars;
+    derivedVars* derived;
     float scaleFactor;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
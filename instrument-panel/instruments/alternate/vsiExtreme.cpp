@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <math.h>
 #include "vsiExtreme.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(vsiExtreme, "VSI Extreme", "VSI", 0, 0, 0, 0);
 
 vsiExtreme::vsiExtreme(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -77,25 +81,25 @@ void vsiExtreme::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 400, 50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -123,44 +127,13 @@ void vsiExtreme::update()
     vertSpeed = abs(simVars->vsiVerticalSpeed * 0.06);
 
     // Different scale after 2
-    if (vertSpeed > 2) {
-        targetAngle = 79.5 + (vertSpeed - 2.0) * 96.5 / 4.0;
-
-        if (targetAngle > 175.5) {
-            targetAngle = 175.5;
-        }
-    }
-    else {
-        targetAngle = vertSpeed * 79.5 / 2.0;
-    }
+    targetAngle = vsiExtremeVertSpeedScale.lookup(vertSpeed);
 
     if (simVars->vsiVerticalSpeed < 0) {
         targetAngle = -targetAngle;
     }
 
-    double diff = abs(targetAngle - angle);
-
-    if (diff > 40.0) {
-        if (angle < targetAngle) angle += 20.0; else angle -= 20.0;
-    }
-    else if (diff > 20.0) {
-        if (angle < targetAngle) angle += 10.0; else angle -= 10.0;
-    }
-    else if (diff > 10.0) {
-        if (angle < targetAngle) angle += 5.0; else angle -= 5.0;
-    }
-    else if (diff > 5.0) {
-        if (angle < targetAngle) angle += 2.5; else angle -= 2.5;
-    }
-    else if (diff > 2.5) {
-        if (angle < targetAngle) angle += 1.25; else angle -= 1.25;
-    }
-    else if (diff > 0.625) {
-        if (angle < targetAngle) angle += 0.625; else angle -= 0.625;
-    }
-    else {
-        angle = targetAngle;
-    }
+    needleSmooth.update(angle, targetAngle);
 }
 
 /// <summary>
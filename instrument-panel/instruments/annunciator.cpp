@@ -1,16 +1,21 @@
 #include <stdio.h>
 #include <stdlib.h>
-#ifdef _WIN32
-#include <Windows.h>
-#endif
 #include "annunciator.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(annunciator, "Annunciator", 13, 50, 50, 200);
+
+// Seconds to keep connection messages bright before dimming
+const double UndimTime = 30;
 
 annunciator::annunciator(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Annunciator");
     simVars = &globals.simVars->simVars;
+    alerts = &globals.simVars->alerts;
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -114,13 +119,13 @@ void annunciator::render()
     if (!globals.dataLinked)
     {
         // 'No Data Link' message
-        al_draw_bitmap(bitmaps[7], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[7], 0, 0);
         state = 0;
     }
     else if (!globals.connected)
     {
         // 'Not Connected' message
-        al_draw_bitmap(bitmaps[8], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[8], 0, 0);
         state = 1;
     }
     else {
@@ -131,39 +136,35 @@ void annunciator::render()
         }
         else {
             // Draw no warnings (warnings get overlayed)
-            al_draw_bitmap(bitmaps[2], 0, 0, 0);
+            softBlend::drawBitmap(bitmaps[2], 0, 0);
 
             // No warnings if no electrics
             if (globals.electrics) {
-                if (vacWarningL || vacWarningR) {
-
-                    if (vacWarningL) {
-                        al_draw_scaled_bitmap(bitmaps[3], 0, 0, 46, 62, 34 * scaleFactor, 30 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
-                    }
-                    al_draw_scaled_bitmap(bitmaps[3], 46, 0, 153, 62, 80 * scaleFactor, 30 * scaleFactor, 153 * scaleFactor, 62 * scaleFactor, 0);
-                    if (vacWarningR) {
-                        al_draw_scaled_bitmap(bitmaps[3], 199, 0, 46, 62, 233 * scaleFactor, 30 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
-                    }
+                // Single suction gauge so both sides always match
+                if (alerts->isShowing(ALERT_VAC)) {
+                    softBlend::drawScaledBitmap(bitmaps[3], 0, 0, 245, 62, 34 * scaleFactor, 30 * scaleFactor, 245 * scaleFactor, 62 * scaleFactor, 0);
                 }
 
+                // Fuel warning flashes for 10 seconds
+                bool fuelWarningL = alerts->isShowing(ALERT_FUEL_LEFT);
+                bool fuelWarningR = alerts->isShowing(ALERT_FUEL_RIGHT);
+
                 if (fuelWarningL || fuelWarningR) {
-                    if (flashCount % 2 == 0) {
-                        if (fuelWarningL) {
-                            al_draw_scaled_bitmap(bitmaps[4], 0, 0, 46, 62, 34 * scaleFactor, 90 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
-                        }
-                        al_draw_scaled_bitmap(bitmaps[4], 46, 0, 282, 62, 80 * scaleFactor, 90 * scaleFactor, 282 * scaleFactor, 62 * scaleFactor, 0);
-                        if (fuelWarningR) {
-                            al_draw_scaled_bitmap(bitmaps[4], 328, 0, 46, 62, 362 * scaleFactor, 90 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
-                        }
+                    if (fuelWarningL) {
+                        softBlend::drawScaledBitmap(bitmaps[4], 0, 0, 46, 62, 34 * scaleFactor, 90 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
+                    }
+                    softBlend::drawScaledBitmap(bitmaps[4], 46, 0, 282, 62, 80 * scaleFactor, 90 * scaleFactor, 282 * scaleFactor, 62 * scaleFactor, 0);
+                    if (fuelWarningR) {
+                        softBlend::drawScaledBitmap(bitmaps[4], 328, 0, 46, 62, 362 * scaleFactor, 90 * scaleFactor, 46 * scaleFactor, 62 * scaleFactor, 0);
                     }
                 }
 
-                if (oilWarning) {
-                    al_draw_bitmap(bitmaps[5], 496 * scaleFactor, 29 * scaleFactor, 0);
+                if (alerts->isShowing(ALERT_OIL_PRESSURE)) {
+                    softBlend::drawBitmap(bitmaps[5], 496 * scaleFactor, 29 * scaleFactor);
                 }
 
-                if (voltsWarning) {
-                    al_draw_bitmap(bitmaps[6], 590 * scaleFactor, 90 * scaleFactor, 0);
+                if (alerts->isShowing(ALERT_VOLTS)) {
+                    softBlend::drawBitmap(bitmaps[6], 590 * scaleFactor, 90 * scaleFactor);
                 }
             }
         }
@@ -171,16 +172,13 @@ void annunciator::render()
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (state != prevState) {
-        dimDelay = 1000;
+        undimUntil = globals.frameTime + UndimTime;
         prevState = state;
     }
-    else if (state < 2 && dimDelay > 0) {
-        dimDelay--;
-    }
-    else if (!globals.electrics) {
+    else if (!globals.electrics && (state == 2 || globals.frameTime >= undimUntil)) {
         dimInstrument();
     }
 }
@@ -204,7 +202,7 @@ void annunciator::showAtcInfo()
         strcat(callSign, " Heavy");
     }
 
-    al_draw_bitmap(bitmaps[9], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[9], 0, 0);
     al_draw_text(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 20, 0, tailNumber);
     al_draw_text(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 40, 0, callSign);
 }
@@ -215,20 +213,6 @@ void annunciator::showAtcInfo()
 /// </summary>
 void annunciator::update()
 {
-    bool aircraftChanged = (loadedAircraft != globals.aircraft);
-    if (aircraftChanged) {
-        loadedAircraft = globals.aircraft;
-        fastAircraft = ((loadedAircraft != NO_AIRCRAFT && simVars->cruiseSpeed >= globals.FastAircraftSpeed)) || loadedAircraft == ORNITHOPTER;
-        prevFuelL = 100;
-        prevFuelR = 100;
-        vacWarningL = false;
-        vacWarningR = false;
-        fuelWarningL = false;
-        fuelWarningR = false;
-        oilWarning = false;
-        voltsWarning = false;
-    }
-
     // Check for position or size change
     int *settings = globals.simVars->readSettings(name, xPos, yPos, size);
 
@@ -246,118 +230,6 @@ void annunciator::update()
         updateKnobs();
     }
 #endif
-
-    // Split fuel from all tanks between left/right
-    // by using main tank percentages as a ratio.
-    double fuelPercent = 100 * simVars->fuelQuantity / simVars->fuelCapacity;
-
-    if (simVars->fuelLeftPercent == simVars->fuelRightPercent) {
-        leftPercent = fuelPercent;
-        rightPercent = fuelPercent;
-    }
-    else {
-        fuelPercent *= 2;
-        totalPercent = simVars->fuelLeftPercent + simVars->fuelRightPercent;
-        leftPercent = fuelPercent * simVars->fuelLeftPercent / totalPercent;
-        rightPercent = fuelPercent * simVars->fuelRightPercent / totalPercent;
-
-        // Normalise percentages (maintain overall percent)
-        if (leftPercent > 100) {
-            rightPercent += leftPercent - 100;
-            leftPercent = 100;
-        }
-
-        if (rightPercent > 100) {
-            leftPercent += rightPercent - 100;
-            rightPercent = 100;
-        }
-    }
-
-    if (simVars->numberOfEngines == 2) {
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2) / 2;
-    }
-    else if (simVars->numberOfEngines > 3) {
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2 + simVars->oilPressure3 + simVars->oilPressure4) / 4;
-    }
-    else if (simVars->numberOfEngines == 3) {
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2 + simVars->oilPressure3) / 3;
-    }
-    else {
-        oilPressure = simVars->oilPressure1;
-    }
-
-    if (loadedAircraft != GLIDER) {
-        checkFuel(leftPercent, &fuelWarningL, &prevFuelL);
-        checkFuel(rightPercent, &fuelWarningR, &prevFuelR);
-
-        if (loadedAircraft != KODIAK_100) {
-            // VAC warning if < 1 inHG
-            vacWarningL = (simVars->suctionPressure < 1);
-            vacWarningR = (simVars->suctionPressure < 1);
-        }
-
-        // Oil warning if pressure < 20 PSI
-        oilWarning = (oilPressure < 20) && loadedAircraft != ORNITHOPTER;
-
-        // Volts warning if battery load too high, i.e. alternator off or not charging quick enough
-        voltsWarning = (simVars->batteryLoad > 18);
-    }
-
-    // Fuel warning flashes for 10 seconds
-    if (flashCount > 0) {
-        // Alternate on/off every 500 ms
-        long timeDiff;
-#ifdef _WIN32
-        long now = GetTickCount64();
-        timeDiff = now - lastFlash;
-#else
-        timespec now;
-        clock_gettime(CLOCK_MONOTONIC, &now);
-        timeDiff = (now.tv_sec - lastFlash.tv_sec) * 1000 + (now.tv_nsec - lastFlash.tv_nsec) / 1000000;
-#endif
-        if (timeDiff >= 500) {
-            flashCount--;
-            lastFlash = now;
-        }
-    }
-}
-
-void annunciator::checkFuel(double fuelLevel, bool *fuelWarning, double *prevFuel)
-{
-    double warnPercent;
-
-    if (loadedAircraft == AIRBUS_A310 || loadedAircraft == BOEING_747) {
-        // Long haul - Fuel warning at 3%
-        warnPercent = 3;
-    }
-    else if (fastAircraft) {
-        // Fuel warning at 6%
-        warnPercent = 6;
-    }
-    else {
-        // Fuel warning at 12%
-        warnPercent = 12;
-    }
-
-    if (fuelLevel == 0 || fuelLevel > warnPercent) {
-        *fuelWarning = false;
-    }
-    else {
-        *fuelWarning = true;
-        if (*prevFuel > warnPercent) {
-            // Flash for 10 seconds
-            if (flashCount == 0) {
-#ifdef _WIN32
-                lastFlash = GetTickCount64();
-#else
-                clock_gettime(CLOCK_MONOTONIC, &lastFlash);
-#endif
-            }
-            flashCount = 20;
-        }
-    }
-
-    *prevFuel = fuelLevel;
 }
 
 #ifndef _WIN32
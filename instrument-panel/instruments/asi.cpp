@@ -2,13 +2,13 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asi.h"
-#include "alternate/asiFast.h"
-#include "alternate/asiSupersonic.h"
-#include "savageCub/asiSavageCub.h"
-#include "spitfire/asiSpitfire.h"
-#include "glider/asiGlider.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
+#include "calibrationTables.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(asi, "ASI", 1, 300, 50, 300);
 
 asi::asi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -16,6 +16,11 @@ asi::asi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     addVars();
     simVars = &globals.simVars->simVars;
 
+    int steps = globals.simVars->getRotationSteps(name);
+    if (steps > 0) {
+        pointerCache.setSteps(steps);
+    }
+
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
     if (globals.hardwareKnobs) {
@@ -92,44 +97,52 @@ void asi::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Outer scale only moves when calibrated so compose it with the main dial
+    if (updateBackground(airspeedCal)) {
+        // Add outer scale (adjusted airspeed) and rotate
+        // 0 = 0 radians
+        softBlend::drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedCal * DegreesToRadians, 0);
 
-    // Add outer scale (adjusted airspeed) and rotate
-    // 0 = 0 radians
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedCal * DegreesToRadians, 0);
+        if (showShadows()) {
+            // Set blender to multiply (shades of grey darken, white has no effect)
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add outer hole Shadow
+            softBlend::drawBitmapRegion(bitmaps[3], 0, 0, size, 180 * scaleFactor, 10 * scaleFactor, 630 * scaleFactor, 0);
 
-        // Add outer hole Shadow
-        al_draw_bitmap_region(bitmaps[3], 0, 0, size, 180 * scaleFactor, 10 * scaleFactor, 630 * scaleFactor, 0);
+            // Restore normal blender
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add main dial
+        softBlend::drawScaledBitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, size, size, 0);
     }
 
-    // Add main dial
-    al_draw_scaled_bitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, size, size, 0);
+    // Draw stuff into dest bitmap
+    al_set_target_bitmap(bitmaps[1]);
+
+    // Copy background (replaces last frame)
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    softBlend::drawBitmap(background, 0, 0);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
+    pointerCache.draw(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -146,32 +159,21 @@ void asi::update()
     bool aircraftChanged = (loadedAircraft != globals.aircraft);
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
-        fastAircraft = (loadedAircraft != NO_AIRCRAFT && loadedAircraft != JUSTFLIGHT_PA28
-            && loadedAircraft != HELI_H135 && simVars->cruiseSpeed >= globals.FastAircraftSpeed);
-        supersonicAircraft = (loadedAircraft == F15_EAGLE || loadedAircraft == F18_HORNET || loadedAircraft == HAWKER_HUNTER || loadedAircraft == ORNITHOPTER);
+        fastAircraft = globals.aircraftTraits->isFast(simVars->cruiseSpeed);
+        supersonicAircraft = globals.aircraftTraits->supersonic;
         cabinLights = 0;
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (loadedAircraft == SAVAGE_CUB) {
-            customInstrument = new asiSavageCub(xPos, yPos, size, name);
-        }
-        else if (loadedAircraft == SUPERMARINE_SPITFIRE) {
-            customInstrument = new asiSpitfire(xPos, yPos, size, name);
-        }
-        else if (loadedAircraft == GLIDER) {
-            customInstrument = new asiGlider(xPos, yPos, size, name);
-        }
-        else if (supersonicAircraft) {
-            customInstrument = new asiSupersonic(xPos, yPos, size, name);
-        }
-        else if (fastAircraft) {
-            customInstrument = new asiFast(xPos, yPos, size, name);
+        // Use custom instrument for this aircraft if we have one
+        const char* variant = globals.aircraftTraits->variant("ASI");
+        if (variant[0] == '\0') {
+            if (supersonicAircraft) {
+                variant = "ASI Supersonic";
+            }
+            else if (fastAircraft) {
+                variant = "ASI Fast";
+            }
         }
+        useVariant(variant);
     }
 
 #ifndef _WIN32
@@ -202,21 +204,7 @@ void asi::update()
     airspeedKnots = simVars->asiAirspeed;
 
     // Not a linear scale!
-    if (airspeedKnots < 40) {
-        airspeedAngle = airspeedKnots * 0.013;
-    }
-    else if (airspeedKnots < 90) {
-        airspeedAngle = -0.03 + pow(airspeedKnots - 12.1, 1.439) * 0.0047;
-    }
-    else if (airspeedKnots < 120) {
-        airspeedAngle = 0.4 + pow(airspeedKnots - 12.1, 1.4) * 0.0046;
-    }
-    else if (airspeedKnots < 160) {
-        airspeedAngle = 1.53 + pow(airspeedKnots - 12.0, 1.320) * 0.0043;
-    }
-    else {
-        airspeedAngle = 2.27 + pow(airspeedKnots - 12.0, 1.28) * 0.0040;
-    }
+    airspeedAngle = asiAirspeedScale.lookup(airspeedKnots);
 }
 
 /// <summary>
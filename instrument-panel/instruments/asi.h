@@ -3,6 +3,7 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "rotationCache.h"
 
 class asi : public instrument
 {
@@ -22,6 +23,9 @@ private:
     double angle;
     double cabinLights = 0;
 
+    // Pre-rotated pointer (0.25 degree steps)
+    rotationCache pointerCache{ 1440 };
+
     // Hardware knobs
     int calKnob = -1;
     int prevVal = 0;
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include "digitalClock.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(digitalClock, "Digital Clock", 15, 250, 250, 200);
 
 digitalClock::digitalClock(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -17,7 +20,7 @@ digitalClock::digitalClock(int xPos, int yPos, int size) : instrument(xPos, yPos
 #endif
 
     resize();
-    time(&flightStartTime);
+    flightStartTime = globals.frameTime;
 }
 
 /// <summary>
@@ -54,89 +57,16 @@ void digitalClock::resize()
     al_draw_scaled_bitmap(orig, 800, 0, 52, 30, 0, 0, 52 * scaleFactor, 30 * scaleFactor, 0);
     addBitmap(bmp);
 
-    // 4 = Digit 0
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 5 = Digit 1
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 94, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 6 = Digit 2
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 188, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 7 = Digit 3
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 282, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 8 = Digit 4
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 376, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 9 = Digit 5
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 470, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 10 = Digit 6
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 564, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 11 = Digit 7
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 658, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 12 = Digit 8
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 752, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 13 = Digit 9
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 666, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 14 = Minus
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 130, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 15 = Letter V
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 264, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 16 = Letter F
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 398, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
-
-    // 17 = Letter C
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 532, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    // 4 = Digits, minus and letters V, F and C
+    digits.setDigits(0, 800, 94, 134, 102);
+    digits.addGlyph('9', 800, 666, 94, 134, 102);
+    digits.addGlyph('-', 800, 130, 94, 134, 77);
+    digits.addGlyph('V', 800, 264, 94, 134, 102);
+    digits.addGlyph('F', 800, 398, 94, 134, 102);
+    digits.addGlyph('C', 800, 532, 94, 134, 102);
+    digits.addSpace('.', 26);
+    digits.addSpace(':', 26);
+    addBitmap(digits.createAtlas(orig, scaleFactor, scaleFactor));
 
     al_set_target_backbuffer(globals.display);
 }
@@ -153,11 +83,22 @@ void digitalClock::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
+    if (skipRedraw()) {
+        // Show the last display drawn
+        al_set_target_backbuffer(globals.display);
+        softBlend::drawBitmap(bitmaps[1], xPos, yPos);
+
+        if (!globals.electrics) {
+            dimInstrument();
+        }
+        return;
+    }
+
     // Draw stuff into dest bitmap
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main panel
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add selector arrow
     int arrowX;
@@ -177,52 +118,42 @@ void digitalClock::render()
         arrowY = 550;
     }
 
-    al_draw_bitmap(bitmaps[3], arrowX * scaleFactor, arrowY * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[3], arrowX * scaleFactor, arrowY * scaleFactor);
 
     switch (displayView) {
     case Voltage:
-        drawDisplay(voltsx10 / 100, (voltsx10 / 10) % 10, voltsx10 % 10, 0);
+        drawDisplay(voltsx10, 'V');
         break;
 
     case Farenheit:
-        if (tempFx10 < 0) {
-            drawDisplay(-tempFx10 / 100, (-tempFx10 / 10) % 10, -tempFx10 % 10, 1, true);
-        }
-        else {
-            drawDisplay(tempFx10 / 100, (tempFx10 / 10) % 10, tempFx10 % 10, 1);
-        }
+        drawDisplay(tempFx10, 'F');
         break;
 
     case Celsius:
-        if (tempCx10 < 0) {
-            drawDisplay(-tempCx10 / 100, (-tempCx10 / 10) % 10, -tempCx10 % 10, 2, true);
-        }
-        else {
-            drawDisplay(tempCx10 / 100, (tempCx10 / 10) % 10, tempCx10 % 10, 2);
-        }
+        drawDisplay(tempCx10, 'C');
         break;
     }
 
     switch (clockView) {
     case UtcTime:
-        drawClock(utcHours / 10, utcHours % 10, utcMins / 10, utcMins % 10);
+        drawClock(utcHours, utcMins);
         break;
 
     case LocalTime:
-        drawClock(localHours / 10, localHours % 10, localMins / 10, localMins % 10);
+        drawClock(localHours, localMins);
         break;
 
     case FlightTime:
-        drawClock(flightHours / 10, flightHours % 10, flightMins / 10, flightMins % 10);
+        drawClock(flightHours, flightMins);
         break;
 
     case ElapsedTime:
-        drawClock(elapsedMins / 10, elapsedMins % 10, elapsedSecs / 10, elapsedSecs % 10);
+        drawClock(elapsedMins, elapsedSecs);
         break;
     }
 
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -230,47 +161,24 @@ void digitalClock::render()
 }
 
 /// <summary>
-/// Draw top row of digits + letter
+/// Draw top row of digits + letter, right aligned so the decimal
+/// point stays in the same place
 /// </summary>
-void digitalClock::drawDisplay(int digit1, int digit2, int digit3, int letter, bool isMinus)
+void digitalClock::drawDisplay(int valx10, char letter)
 {
-    int y = 255 * scaleFactor;
-
     // Temps can be negative
-    if (isMinus) {
-        if (digit1 > 0) {
-            al_draw_bitmap(bitmaps[14], 110 * scaleFactor, y, 0);
-        }
-        else {
-            al_draw_bitmap(bitmaps[14], 212 * scaleFactor, y, 0);
-        }
-    }
-
-    // Farenheit can be > 99
-    if (digit1 > 9) {
-        al_draw_bitmap(bitmaps[5], 85 * scaleFactor, y, 0);
-    }
+    char text[16];
+    snprintf(text, sizeof(text), "%s%d.%d%c", valx10 < 0 ? "-" : "", abs(valx10) / 10, abs(valx10) % 10, letter);
 
-    if (digit1 > 0) {
-        al_draw_bitmap(bitmaps[4 + (digit1 % 10)], 187 * scaleFactor, y, 0);
-    }
-
-    al_draw_bitmap(bitmaps[4 + digit2], 289 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit3], 417 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[15 + letter], 519 * scaleFactor, y, 0);
+    digits.draw(621 - digits.textWidth(text), 255, "%s", text);
 }
 
 /// <summary>
 /// Draw bottom row of digits
 /// </summary>
-void digitalClock::drawClock(int digit1, int digit2, int digit3, int digit4)
+void digitalClock::drawClock(int val1, int val2)
 {
-    int y = 430 * scaleFactor;
-
-    al_draw_bitmap(bitmaps[4 + digit1], 277 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit2], 379 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit3], 507 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit4], 609 * scaleFactor, y, 0);
+    digits.draw(277, 430, "%02d:%02d", val1 % 100, val2 % 100);
 }
 
 /// <summary>
@@ -301,7 +209,7 @@ void digitalClock::update()
     voltsx10 = simVars->dcVolts * 10 + 0.5;
 
     // Smooth out temp change display
-    time(&now);
+    double now = globals.frameTime;
     if (now - lastTempChange > 4) {
         lastTempChange = now;
         tempCx10 = simVars->dcTempC * 10 + .5;
@@ -316,16 +224,14 @@ void digitalClock::update()
     localHours = (mins / 60) % 24;
     localMins = mins % 60;
 
-    time(&now);
-
     // Absoulte time doesn't work so just use panel start time
-    mins = (now - flightStartTime) / 60;
+    mins = (int)(now - flightStartTime) / 60;
     flightHours = (mins / 60) % 24;
     flightMins = mins % 60;
 
     int seconds = stopWatchSeconds;
     if (stopWatchRunning) {
-        seconds += now - stopWatchStarted;
+        seconds += (int)(now - stopWatchStarted);
     }
 
     elapsedMins = (seconds / 60) % 99;
@@ -396,19 +302,18 @@ void digitalClock::updateKnobs()
                 system("sudo reboot");
             }
 
-            time(&stopWatchPressed);
+            stopWatchPressed = globals.frameTime;
 
             if (clockView == ElapsedTime) {
                 if (!stopWatchRunning) {
                     // Start
                     stopWatchRunning = true;
-                    time(&stopWatchStarted);
+                    stopWatchStarted = globals.frameTime;
                 }
                 else {
                     // Stop
                     stopWatchRunning = false;
-                    time(&now);
-                    stopWatchSeconds += now - stopWatchStarted;
+                    stopWatchSeconds += (int)(globals.frameTime - stopWatchStarted);
                 }
             }
         }
@@ -421,11 +326,10 @@ void digitalClock::updateKnobs()
     }
     else if (stopWatchPressed != 0) {
         // Reset if button held for more than 1 second
-        time(&now);
-        if (now - stopWatchPressed > 1) {
+        if (globals.frameTime - stopWatchPressed > 1) {
             if (clockView == FlightTime) {
                 // Reset flight time
-                time(&flightStartTime);
+                flightStartTime = globals.frameTime;
             }
             else if (clockView == ElapsedTime) {
                 // Reset stopwatch
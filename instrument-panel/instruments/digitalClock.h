@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "numericDisplay.h"
 
 class digitalClock : public instrument
 {
@@ -22,20 +23,20 @@ class digitalClock : public instrument
 private:
     SimVars* simVars;
     float scaleFactor;
+    numericDisplay digits;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
     DisplayView displayView = Celsius;
     ClockView clockView = UtcTime;
     bool stopWatchRunning = false;
     int stopWatchSeconds = 0;
-    time_t flightStartTime;
-    time_t now;
-    time_t stopWatchStarted;
-    time_t stopWatchPressed;
+    double flightStartTime;
+    double stopWatchStarted;
+    double stopWatchPressed;
     int voltsx10;
     int tempFx10;
     int tempCx10;
-    time_t lastTempChange = 0;
+    double lastTempChange = 0;
     int utcHours;
     int utcMins;
     int localHours;
@@ -59,8 +60,8 @@ public:
     void update();
 
 private:
-    void drawDisplay(int digit1, int digit2, int digit3, int letter, bool isMinus = false);
-    void drawClock(int digit1, int digit2, int digit3, int digit4);
+    void drawDisplay(int valx10, char letter);
+    void drawClock(int val1, int val2);
     void resize();
     void addVars();
     void addKnobs();
@@ -3,12 +3,16 @@
 #include <math.h>
 #include "egt.h"
 #include "simvars.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(egt, "EGT", 17, 250, 500, 200);
 
 egt::egt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("EGT");
     addVars();
     simVars = &globals.simVars->simVars;
+    derived = &globals.simVars->derived;
     resize();
 }
 
@@ -73,27 +77,38 @@ void egt::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
+    if (skipRedraw()) {
+        // Show the last display drawn
+        al_set_target_backbuffer(globals.display);
+        softBlend::drawBitmap(bitmaps[1], xPos, yPos);
+
+        if (!globals.electrics) {
+            dimInstrument();
+        }
+        return;
+    }
+
     // Draw stuff into dest bitmap
     al_set_target_bitmap(bitmaps[1]);
 
     // Add dials
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add ref pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 60, 6, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtRefAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[5], 60, 6, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtRefAngle * DegreesToRadians, 0);
 
     // Add left pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtAngle * DegreesToRadians, 0);
 
     // Add right pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, flowAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, flowAngle * DegreesToRadians, 0);
 
     // Add top layer
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -125,22 +140,8 @@ void egt::update()
     }
 
     // Calculate values
-    if (simVars->numberOfEngines == 2) {
-        exhaustGasTemp = (simVars->exhaustGasTemp1 + simVars->exhaustGasTemp2) / 2;
-        engineFuelFlow = (simVars->engineFuelFlow1 + simVars->engineFuelFlow2) / 2;
-    }
-    else if (simVars->numberOfEngines > 3) {
-        exhaustGasTemp = (simVars->exhaustGasTemp1 + simVars->exhaustGasTemp2 + simVars->exhaustGasTemp3 + simVars->exhaustGasTemp4) / 4;
-        engineFuelFlow = (simVars->engineFuelFlow1 + simVars->engineFuelFlow2 + simVars->engineFuelFlow3 + simVars->engineFuelFlow4) / 4;
-    }
-    else if (simVars->numberOfEngines == 3) {
-        exhaustGasTemp = (simVars->exhaustGasTemp1 + simVars->exhaustGasTemp2 + simVars->exhaustGasTemp3) / 3;
-        engineFuelFlow = (simVars->engineFuelFlow1 + simVars->engineFuelFlow2 + simVars->engineFuelFlow3) / 3;
-    }
-    else {
-        exhaustGasTemp = simVars->exhaustGasTemp1;
-        engineFuelFlow = simVars->engineFuelFlow1;
-    }
+    exhaustGasTemp = derived->get(DERIVED_EXHAUST_GAS_TEMP);
+    engineFuelFlow = derived->get(DERIVED_ENGINE_FUEL_FLOW);
 
     egtAngle = 62 - (exhaustGasTemp - 680) * 0.527885;
     if (egtAngle < -60) {
@@ -2,12 +2,14 @@
 #define _EGT_H_
 
 #include "simvarDefs.h"
+#include "derivedVars.h"
 #include "instrument.h"
 
 class egt : public instrument
 {
 private:
     SimVars* simVars;
+    derivedVars* derived;
     Aircraft loadedAircraft = UNDEFINED;
     float scaleFactor;
 
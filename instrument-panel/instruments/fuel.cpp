@@ -3,12 +3,16 @@
 #include "fuel.h"
 #include "simvars.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(fuel, "Fuel", 16, 50, 500, 200);
 
 fuel::fuel(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Fuel");
     addVars();
     simVars = &globals.simVars->simVars;
+    derived = &globals.simVars->derived;
     resize();
 }
 
@@ -67,24 +71,35 @@ void fuel::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
+    if (skipRedraw()) {
+        // Show the last display drawn
+        al_set_target_backbuffer(globals.display);
+        softBlend::drawBitmap(bitmaps[1], xPos, yPos);
+
+        if (!globals.electrics) {
+            dimInstrument();
+        }
+        return;
+    }
+
     // Draw stuff into dest bitmap
     al_set_target_bitmap(bitmaps[1]);
 
     // Add dials
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add left pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
 
     // Add right pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
 
     // Add top layer
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -108,31 +123,9 @@ void fuel::update()
         resize();
     }
 
-    // Split fuel from all tanks between left/right
-    // by using main tank percentages as a ratio.
-    double fuelPercent = 100 * simVars->fuelQuantity / simVars->fuelCapacity;
-
-    if (simVars->fuelLeftPercent == simVars->fuelRightPercent) {
-        leftPercent = fuelPercent;
-        rightPercent = fuelPercent;
-    }
-    else {
-        fuelPercent *= 2;
-        totalPercent = simVars->fuelLeftPercent + simVars->fuelRightPercent;
-        leftPercent = fuelPercent * simVars->fuelLeftPercent / totalPercent;
-        rightPercent = fuelPercent * simVars->fuelRightPercent / totalPercent;
-
-        // Normalise percentages (maintain overall percent)
-        if (leftPercent > 100) {
-            rightPercent += leftPercent - 100;
-            leftPercent = 100;
-        }
-
-        if (rightPercent > 100) {
-            leftPercent += rightPercent - 100;
-            rightPercent = 100;
-        }
-    }
+    // Fuel from all tanks split between left/right
+    leftPercent = derived->get(DERIVED_FUEL_LEFT_PERCENT);
+    rightPercent = derived->get(DERIVED_FUEL_RIGHT_PERCENT);
 
     angleLeft = 55 - leftPercent * 1.144;
     angleRight = 124 + rightPercent * 1.144;
@@ -2,17 +2,18 @@
 #define _FUEL_H_
 
 #include "simvarDefs.h"
+#include "derivedVars.h"
 #include "instrument.h"
 
 class fuel : public instrument
 {
 private:
     SimVars* simVars;
+    derivedVars* derived;
     float scaleFactor;
 
     // Instrument values (caclulated from variables and needed to draw the instrument)
     double fuelPercent;
-    double totalPercent;
     double leftPercent;
     double rightPercent;
     double angleLeft;
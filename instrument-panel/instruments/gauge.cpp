@@ -0,0 +1,575 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gauge.h"
+#include "simvars.h"
+#include "jsonParser.h"
+#include "instrumentFactory.h"
+
+void showError(const char* msg);
+
+/// <summary>
+/// VAC is a gauge but is listed in the settings file
+/// and has a default position like other instruments.
+/// </summary>
+static instrument* createVac(int xPos, int yPos, int size, const char* parentName)
+{
+    return new gauge(xPos, yPos, size, "VAC", parentName);
+}
+
+static bool vacRegistered = instrumentFactory::add("VAC", NULL, createVac, 19, 250, 750, 200);
+
+// Maximum width of the atlas before sprites wrap onto a new row
+const int AtlasWidth = 2048;
+
+/// <summary>
+/// Builds the layers of a gauge as its JSON file is parsed.
+/// Settings such as "Bitmap" are at level 1, the members of each
+/// layer are at level 3 and the numbers in a layer's arrays are at
+/// level 4 (or level 5 for the points of a curve).
+/// </summary>
+class gaugeHandler : public jsonHandler
+{
+private:
+    gauge* thisPtr;
+    bool inLayers = false;
+    bool inLayer = false;
+    int layerNum = 0;
+
+    // Layer currently being read
+    bool isNeedle;
+    double source[4];
+    double position[2];
+    double pivot[2];
+    double shadow[2];
+    double shadowOffset[2];
+    bool hasSource;
+    bool hasShadow;
+    char varName[256];
+    double scaling;
+    double initial;
+    std::vector<CalPoint> points;
+
+    // Numbers in the array currently being read
+    double nums[4];
+    int numCount = 0;
+
+public:
+    char error[256] = { '\0' };
+
+    gaugeHandler(gauge* thisPtr)
+    {
+        this->thisPtr = thisPtr;
+    }
+
+    void startObject(int level, const char* key)
+    {
+        if (inLayers && level == 2) {
+            inLayer = true;
+            layerNum++;
+            isNeedle = false;
+            position[0] = 0;
+            position[1] = 0;
+            pivot[0] = 0;
+            pivot[1] = 0;
+            shadowOffset[0] = 10;
+            shadowOffset[1] = 10;
+            hasSource = false;
+            hasShadow = false;
+            varName[0] = '\0';
+            scaling = 1;
+            initial = 0;
+            points.clear();
+        }
+    }
+
+    void endObject(int level, const char* key)
+    {
+        if (inLayer && level == 2) {
+            addLayer();
+            inLayer = false;
+        }
+    }
+
+    void startArray(int level, const char* key)
+    {
+        if (level == 1 && _stricmp(key, "Layers") == 0) {
+            inLayers = true;
+        }
+        else if (inLayer && (level == 3 || level == 4)) {
+            numCount = 0;
+        }
+    }
+
+    void endArray(int level, const char* key)
+    {
+        if (level == 1) {
+            inLayers = false;
+            return;
+        }
+
+        if (!inLayer) {
+            return;
+        }
+
+        if (level == 4) {
+            // Point of a curve
+            if (numCount != 2) {
+                fail("Curve points must be [in, out]");
+                return;
+            }
+            CalPoint point = { nums[0], nums[1] };
+            if (!points.empty() && point.in <= points.back().in) {
+                fail("Curve points must be in ascending order");
+                return;
+            }
+            points.push_back(point);
+            return;
+        }
+
+        if (level != 3 || _stricmp(key, "Curve") == 0) {
+            return;
+        }
+
+        if (_stricmp(key, "Source") == 0) {
+            if (numCount != 4 || nums[2] < 1 || nums[3] < 1) {
+                fail("Source must be [x, y, width, height]");
+                return;
+            }
+            memcpy(source, nums, sizeof(source));
+            hasSource = true;
+            return;
+        }
+
+        if (numCount != 2) {
+            fail("Position, Pivot, Shadow and Shadow Offset must be [x, y]");
+            return;
+        }
+
+        if (_stricmp(key, "Position") == 0) {
+            memcpy(position, nums, sizeof(position));
+        }
+        else if (_stricmp(key, "Pivot") == 0) {
+            memcpy(pivot, nums, sizeof(pivot));
+        }
+        else if (_stricmp(key, "Shadow") == 0) {
+            memcpy(shadow, nums, sizeof(shadow));
+            hasShadow = true;
+        }
+        else if (_stricmp(key, "Shadow Offset") == 0) {
+            memcpy(shadowOffset, nums, sizeof(shadowOffset));
+        }
+    }
+
+    void value(int level, const char* key, const char* value, JsonType type)
+    {
+        if (level == 1) {
+            if (_stricmp(key, "Bitmap") == 0) {
+                strncpy(thisPtr->bitmapFile, value, 255);
+                thisPtr->bitmapFile[255] = '\0';
+            }
+            else if (_stricmp(key, "Size") == 0) {
+                thisPtr->designSize = atoi(value);
+            }
+            else if (_stricmp(key, "Power") == 0) {
+                if (_stricmp(value, "None") == 0) {
+                    thisPtr->power = POWER_NONE;
+                }
+                else if (_stricmp(value, "Avionics") == 0) {
+                    thisPtr->power = POWER_AVIONICS;
+                }
+                else {
+                    thisPtr->power = POWER_ELECTRICS;
+                }
+            }
+            return;
+        }
+
+        if (!inLayer) {
+            return;
+        }
+
+        if (level == 3) {
+            if (_stricmp(key, "Type") == 0) {
+                isNeedle = (_stricmp(value, "Needle") == 0);
+            }
+            else if (_stricmp(key, "Var") == 0) {
+                strncpy(varName, value, 255);
+                varName[255] = '\0';
+            }
+            else if (_stricmp(key, "Scaling") == 0) {
+                scaling = atof(value);
+            }
+            else if (_stricmp(key, "Initial") == 0) {
+                initial = atof(value);
+            }
+        }
+        else if ((level == 4 || level == 5) && type == JSON_NUMBER) {
+            if (numCount < 4) {
+                nums[numCount] = atof(value);
+            }
+            numCount++;
+        }
+    }
+
+private:
+    void addLayer()
+    {
+        if (!hasSource) {
+            fail("Source is missing");
+            return;
+        }
+
+        GaugeLayer layer;
+        layer.isNeedle = isNeedle;
+        layer.x = position[0];
+        layer.y = position[1];
+        layer.pivotX = pivot[0];
+        layer.pivotY = pivot[1];
+        layer.shadowX = shadowOffset[0];
+        layer.shadowY = shadowOffset[1];
+        layer.varSlot = -1;
+        layer.curve = -1;
+        layer.angle = 0;
+
+        // Needles are scaled when drawn so keep them at design size
+        bool scaled = !isNeedle;
+        layer.sprite = thisPtr->addSprite((int)source[0], (int)source[1], (int)source[2], (int)source[3], scaled);
+        if (hasShadow) {
+            layer.shadowSprite = thisPtr->addSprite((int)shadow[0], (int)shadow[1], (int)source[2], (int)source[3], scaled);
+        }
+        else {
+            layer.shadowSprite = -1;
+        }
+
+        if (isNeedle) {
+            const SimVarDef* def = findSimVar(varName);
+            if (def == NULL) {
+                fail("Var is missing or unknown");
+                return;
+            }
+            if (def->size != sizeof(double)) {
+                fail("Var must be a number");
+                return;
+            }
+            layer.varSlot = def->offset / sizeof(double);
+
+            bool found = false;
+            for (auto const& var : thisPtr->vars) {
+                if (strcmp(var.name, def->name) == 0) {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found) {
+                GaugeVar var;
+                strcpy(var.name, def->name);
+                var.scaling = scaling;
+                var.initial = initial;
+                thisPtr->vars.push_back(var);
+            }
+
+            if (points.size() == 1) {
+                fail("Curve needs at least two points");
+                return;
+            }
+            if (!points.empty()) {
+                layer.curve = (int)thisPtr->curves.size();
+                thisPtr->curves.push_back(calibration(points.data(), (int)points.size()));
+            }
+        }
+
+        thisPtr->layers.push_back(layer);
+    }
+
+    void fail(const char* msg)
+    {
+        // Keep the first error
+        if (error[0] == '\0') {
+            snprintf(error, sizeof(error), "Layer %d: %s", layerNum, msg);
+        }
+    }
+};
+
+gauge::gauge(int xPos, int yPos, int size, const char* gaugeName, const char* parentName) : instrument(xPos, yPos, size)
+{
+    secondary = true;
+    if (parentName) {
+        // Use position, size and vars from parent
+        setName(parentName);
+    }
+    else {
+        setName(gaugeName);
+    }
+
+    loaded = load(gaugeName);
+    if (loaded && !parentName) {
+        addVars();
+    }
+
+    simVars = &globals.simVars->simVars;
+    resize();
+}
+
+/// <summary>
+/// Returns true if there is a gauge file for the named instrument
+/// </summary>
+bool gauge::isDefined(const char* gaugeName)
+{
+    char filepath[256];
+    gaugePath(filepath, gaugeName);
+
+    FILE* infile = fopen(filepath, "r");
+    if (!infile) {
+        return false;
+    }
+
+    fclose(infile);
+    return true;
+}
+
+void gauge::gaugePath(char* filepath, const char* gaugeName)
+{
+    snprintf(filepath, 256, "%s%s.json", globals.GaugeDir, gaugeName);
+}
+
+/// <summary>
+/// Read the layers from the gauge file
+/// </summary>
+bool gauge::load(const char* gaugeName)
+{
+    char filepath[256];
+    gaugePath(filepath, gaugeName);
+
+    strcpy(bitmapFile, "");
+    jsonParser parser;
+    gaugeHandler handler(this);
+    char msg[256];
+    int len;
+
+    if (!parser.parse(filepath, &handler)) {
+        len = snprintf(msg, sizeof(msg), "Gauge file %s line %d column %d: %s", filepath, parser.line, parser.column, parser.error);
+    }
+    else if (handler.error[0] != '\0') {
+        len = snprintf(msg, sizeof(msg), "Gauge file %s %s", filepath, handler.error);
+    }
+    else if (bitmapFile[0] == '\0' || designSize <= 0 || layers.empty()) {
+        len = snprintf(msg, sizeof(msg), "Gauge file %s needs a Bitmap, Size and Layers", filepath);
+    }
+    else {
+        return true;
+    }
+
+    if (len >= (int)sizeof(msg)) {
+        // Show that the message has been cut short
+        strcpy(&msg[sizeof(msg) - 4], "...");
+    }
+
+    showError(msg);
+    return false;
+}
+
+/// <summary>
+/// Returns the index of the sprite for the bitmap region, adding it
+/// if it is not already used by another layer.
+/// </summary>
+int gauge::addSprite(int srcX, int srcY, int width, int height, bool scaled)
+{
+    for (int i = 0; i < (int)sprites.size(); i++) {
+        GaugeSprite* sprite = &sprites[i];
+        if (sprite->srcX == srcX && sprite->srcY == srcY && sprite->width == width &&
+            sprite->height == height && sprite->scaled == scaled) {
+            return i;
+        }
+    }
+
+    GaugeSprite sprite;
+    memset(&sprite, 0, sizeof(sprite));
+    sprite.srcX = srcX;
+    sprite.srcY = srcY;
+    sprite.width = width;
+    sprite.height = height;
+    sprite.scaled = scaled;
+    sprites.push_back(sprite);
+
+    return (int)sprites.size() - 1;
+}
+
+/// <summary>
+/// Destroy and recreate all bitmaps as instrument has been resized
+/// </summary>
+void gauge::resize()
+{
+    destroyBitmaps();
+
+    if (!loaded) {
+        return;
+    }
+
+    scaleFactor = size / (float)designSize;
+
+    // Pack sprites into rows with a gap so filtering doesn't
+    // bleed neighbouring sprites into each other.
+    int x = 0;
+    int y = 0;
+    int rowHeight = 0;
+    int atlasWidth = 0;
+    for (auto& sprite : sprites) {
+        sprite.atlasWidth = sprite.width;
+        sprite.atlasHeight = sprite.height;
+        if (sprite.scaled) {
+            sprite.atlasWidth = (int)(sprite.width * scaleFactor + 0.5f);
+            sprite.atlasHeight = (int)(sprite.height * scaleFactor + 0.5f);
+            if (sprite.atlasWidth < 1) sprite.atlasWidth = 1;
+            if (sprite.atlasHeight < 1) sprite.atlasHeight = 1;
+        }
+
+        if (x > 0 && x + sprite.atlasWidth > AtlasWidth) {
+            x = 0;
+            y += rowHeight + 2;
+            rowHeight = 0;
+        }
+
+        sprite.atlasX = x;
+        sprite.atlasY = y;
+        x += sprite.atlasWidth + 2;
+
+        if (rowHeight < sprite.atlasHeight) {
+            rowHeight = sprite.atlasHeight;
+        }
+        if (atlasWidth < x) {
+            atlasWidth = x;
+        }
+    }
+
+    // 0 = Original (loaded) bitmap
+    ALLEGRO_BITMAP* orig = loadBitmap(bitmapFile);
+    addBitmap(orig);
+
+    if (bitmaps[0] == NULL) {
+        return;
+    }
+
+    // 1 = Destination bitmap (all other bitmaps get assembled to here)
+    ALLEGRO_BITMAP* bmp = al_create_bitmap(size, size);
+    addBitmap(bmp);
+
+    // 2 = Atlas of all sprites
+    bmp = al_create_bitmap(atlasWidth, y + rowHeight);
+    al_set_target_bitmap(bmp);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    for (auto const& sprite : sprites) {
+        al_draw_scaled_bitmap(orig, sprite.srcX, sprite.srcY, sprite.width, sprite.height,
+            sprite.atlasX, sprite.atlasY, sprite.atlasWidth, sprite.atlasHeight, 0);
+    }
+    addBitmap(bmp);
+
+    al_set_target_backbuffer(globals.display);
+}
+
+/// <summary>
+/// Draw the instrument at the stored position
+/// </summary>
+void gauge::render()
+{
+    if (bitmaps[0] == NULL) {
+        return;
+    }
+
+    // Use normal blender
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+    // Draw stuff into dest bitmap
+    al_set_target_bitmap(bitmaps[1]);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+    // All sprites come from the atlas so Allegro can draw
+    // consecutive layers in one batch.
+    al_hold_bitmap_drawing(true);
+
+    for (auto const& layer : layers) {
+        if (layer.shadowSprite != -1 && showShadows()) {
+            // Flush the batch before changing blender
+            al_hold_bitmap_drawing(false);
+
+            // Set blender to multiply (shades of grey darken, white has no effect)
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            drawSprite(layer, layer.shadowSprite, layer.shadowX, layer.shadowY);
+
+            // Restore normal blender
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+            al_hold_bitmap_drawing(true);
+        }
+
+        drawSprite(layer, layer.sprite, 0, 0);
+    }
+
+    al_hold_bitmap_drawing(false);
+
+    // Position dest bitmap on screen
+    al_set_target_backbuffer(globals.display);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
+
+    if ((power == POWER_ELECTRICS && !globals.electrics) || (power == POWER_AVIONICS && !globals.avionics)) {
+        dimInstrument();
+    }
+}
+
+/// <summary>
+/// Draw a layer's sprite (or its shadow) offset in design units
+/// </summary>
+void gauge::drawSprite(const GaugeLayer& layer, int spriteNum, double offsetX, double offsetY)
+{
+    const GaugeSprite* sprite = &sprites[spriteNum];
+    float destX = (layer.x + offsetX) * scaleFactor;
+    float destY = (layer.y + offsetY) * scaleFactor;
+
+    if (layer.isNeedle) {
+        softBlend::drawScaledRotatedBitmapRegion(bitmaps[2], sprite->atlasX, sprite->atlasY, sprite->atlasWidth, sprite->atlasHeight,
+            layer.pivotX, layer.pivotY, destX, destY, scaleFactor, scaleFactor, layer.angle, 0);
+    }
+    else {
+        softBlend::drawBitmapRegion(bitmaps[2], sprite->atlasX, sprite->atlasY, sprite->atlasWidth, sprite->atlasHeight, destX, destY, 0);
+    }
+}
+
+/// <summary>
+/// Fetch flightsim vars and then update all internal variables
+/// that affect this instrument.
+/// </summary>
+void gauge::update()
+{
+    // Check for position or size change
+    int *settings = globals.simVars->readSettings(name, xPos, yPos, size);
+
+    xPos = settings[0];
+    yPos = settings[1];
+
+    if (size != settings[2]) {
+        size = settings[2];
+        resize();
+    }
+
+    // Calculate values
+    double* vals = (double*)simVars;
+    for (auto& layer : layers) {
+        if (layer.isNeedle) {
+            double val = vals[layer.varSlot];
+            if (layer.curve != -1) {
+                val = curves[layer.curve].lookup(val);
+            }
+            layer.angle = val * DegreesToRadians;
+        }
+    }
+}
+
+/// <summary>
+/// Add FlightSim variables for this instrument (used for simulation mode)
+/// </summary>
+void gauge::addVars()
+{
+    for (auto const& var : vars) {
+        globals.simVars->addVar(name, var.name, false, var.scaling, var.initial);
+    }
+}
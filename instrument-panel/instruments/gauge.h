@@ -0,0 +1,95 @@
+#ifndef _GAUGE_H_
+#define _GAUGE_H_
+
+#include <vector>
+#include "simvarDefs.h"
+#include "instrument.h"
+#include "calibration.h"
+
+enum GaugePower {
+    POWER_NONE,
+    POWER_ELECTRICS,
+    POWER_AVIONICS
+};
+
+/// <summary>
+/// A region of the gauge bitmap. Image sprites are copied into the
+/// atlas at instrument size and needle sprites at design size (they
+/// are scaled when drawn rotated).
+/// </summary>
+struct GaugeSprite
+{
+    int srcX;
+    int srcY;
+    int width;
+    int height;
+    bool scaled;
+    int atlasX;
+    int atlasY;
+    int atlasWidth;
+    int atlasHeight;
+};
+
+struct GaugeLayer
+{
+    bool isNeedle;
+    int sprite;
+    int shadowSprite;
+    double x;
+    double y;
+    double pivotX;
+    double pivotY;
+    double shadowX;
+    double shadowY;
+    int varSlot;
+    int curve;
+    double angle;
+};
+
+struct GaugeVar
+{
+    char name[256];
+    double scaling;
+    double initial;
+};
+
+/// <summary>
+/// Generic instrument described by a JSON file in the gauges directory
+/// instead of C++. A gauge is a list of layers drawn in order, each one
+/// either a fixed image or a needle rotated by a sim variable converted
+/// to degrees by a calibration curve. All sprites are packed into one
+/// atlas bitmap so the layers are drawn as a single batch.
+/// </summary>
+class gauge : public instrument
+{
+private:
+    SimVars* simVars;
+    float scaleFactor;
+    bool loaded = false;
+
+    char bitmapFile[256];
+    int designSize = 800;
+    GaugePower power = POWER_ELECTRICS;
+    std::vector<GaugeSprite> sprites;
+    std::vector<GaugeLayer> layers;
+    std::vector<GaugeVar> vars;
+    std::vector<calibration> curves;
+
+public:
+    gauge(int xPos, int yPos, int size, const char* gaugeName, const char* parentName = NULL);
+    void render();
+    void update();
+    static bool isDefined(const char* gaugeName);
+
+private:
+    void resize();
+    void addVars();
+    bool load(const char* gaugeName);
+    int addSprite(int srcX, int srcY, int width, int height, bool scaled);
+    void drawSprite(const GaugeLayer& layer, int spriteNum, double offsetX, double offsetY);
+    static void gaugePath(char* filepath, const char* gaugeName);
+
+    friend class gaugeHandler;
+};
+
+#endif // _GAUGE_H_
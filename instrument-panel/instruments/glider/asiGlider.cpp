@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asiGlider.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(asiGlider, "ASI Glider", "ASI", 0, 0, 0, 0);
 
 asiGlider::asiGlider(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -77,25 +81,25 @@ void asiGlider::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 24, 374, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 24, 374, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 24, 374, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 24, 374, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -122,19 +126,7 @@ void asiGlider::update()
     // Calculate values
     kmph = simVars->asiAirspeed * 1.852;
 
-    if (kmph < 20) {
-        kmph = 20;
-    }
-
-    if (kmph <= 100) {
-        angle = 124 + kmph * 2.3;
-    }
-    else if (kmph <= 150) {
-        angle = 154 + kmph * 2.0;   // -206
-    }
-    else {
-        angle = 217 + kmph * 1.58;  // -143
-    }
+    angle = asiGliderAirspeedScale.lookup(kmph);
 }
 
 /// <summary>
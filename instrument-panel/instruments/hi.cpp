@@ -5,6 +5,9 @@
 #include "hi.h"
 #include "simvars.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(hi, "HI", 6, 700, 400, 300);
 
 hi::hi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -12,6 +15,12 @@ hi::hi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     addVars();
     simVars = &globals.simVars->simVars;
 
+    int steps = globals.simVars->getRotationSteps(name);
+    if (steps > 0) {
+        dialCache.setSteps(steps);
+        bugCache.setSteps(steps);
+    }
+
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
     if (globals.hardwareKnobs) {
@@ -87,27 +96,27 @@ void hi::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add dial
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    dialCache.draw(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians);
 
     // Add plane
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add heading bug shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 408 * scaleFactor, scaleFactor, scaleFactor, bugAngle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 408 * scaleFactor, scaleFactor, scaleFactor, bugAngle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add heading bug
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bugAngle * DegreesToRadians, 0);
+    bugCache.draw(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bugAngle * DegreesToRadians);
 
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -215,11 +224,10 @@ void hi::updateKnobs()
                 prevVal = val;
             }
         }
-        time(&lastBugAdjust);
+        lastBugAdjust = globals.frameTime;
     }
     else if (lastBugAdjust != 0) {
-        time(&now);
-        if (now - lastBugAdjust > 1) {
+        if (globals.frameTime - lastBugAdjust > 1) {
             lastBugAdjust = 0;
         }
     }
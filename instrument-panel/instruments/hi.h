@@ -3,6 +3,7 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "rotationCache.h"
 
 class hi : public instrument
 {
@@ -17,12 +18,15 @@ private:
     double bugAngle;
     double headingBug = 0;
 
+    // Pre-rotated dial and heading bug (0.25 degree steps)
+    rotationCache dialCache{ 1440 };
+    rotationCache bugCache{ 1440 };
+
     // Hardware knobs
     int hdgKnob = -1;
     int prevVal = 0;
     int prevValSb = 0;
-    time_t lastBugAdjust = 0;
-    time_t now;
+    double lastBugAdjust = 0;
 
 public:
     hi(int xPos, int yPos, int size);
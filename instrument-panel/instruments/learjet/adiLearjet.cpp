@@ -2,6 +2,15 @@
 #include <stdlib.h>
 #include "adiLearjet.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(adiLearjet, "ADI Learjet", 21, 50, 50, 300);
+
+// Seconds for the gyro to topple once it has stopped
+const double GyroToppleTime = 6.7;
+
+// Longest frame the gyro moves for (stops a stall making it jump)
+const double MaxFrameSecs = 0.1;
 
 adiLearjet::adiLearjet(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -17,7 +26,8 @@ adiLearjet::adiLearjet(int xPos, int yPos, int size) : instrument(xPos, yPos, si
 #endif
 
     resize();
-    time(&lastPowerTime);
+    lastPowerTime = globals.frameTime;
+    lastUpdateTime = globals.frameTime;
 }
 
 /// <summary>
@@ -70,9 +80,12 @@ void adiLearjet::resize()
     al_draw_scaled_bitmap(orig, 1524, 858, 229, 389, 0, 0, 229 * scaleFactor, 389 * scaleFactor, 0);
     addBitmap(trans4);
 
-    // 7 = Roll pointer shadow
-    ALLEGRO_BITMAP* trans5 = al_create_bitmap(size, size);
-    addBitmap(trans5);
+    // 7 = Roll pointer shadow sprite on white (rotated and multiplied straight onto the destination)
+    ALLEGRO_BITMAP* pointerShadow = al_create_bitmap(100 * scaleFactor, 600 * scaleFactor);
+    al_set_target_bitmap(pointerShadow);
+    al_draw_scaled_bitmap(orig, 1484, 1387, 1, 1, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
+    al_draw_scaled_bitmap(orig, 1498, 1386, 99, 599, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
+    addBitmap(pointerShadow);
 
     // 8 = Roll pointer sprite
     ALLEGRO_BITMAP* pointer = al_create_bitmap(100 * scaleFactor, 600 * scaleFactor);
@@ -80,18 +93,18 @@ void adiLearjet::resize()
     al_draw_scaled_bitmap(orig, 1297, 1388, 99, 599, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
     addBitmap(pointer);
 
-    // 9 = Roll pointer shadow sprite
-    ALLEGRO_BITMAP* pointerShadow = al_create_bitmap(100 * scaleFactor, 600 * scaleFactor);
-    al_set_target_bitmap(pointerShadow);
-    al_draw_scaled_bitmap(orig, 1498, 1386, 99, 599, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
-    addBitmap(pointerShadow);
-
-    // 10 = Fill with background colour (takes 1 pixel of background and scales it)
+    // 9 = Fill with background colour (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(size, size);
     al_set_target_bitmap(bg);
     al_draw_scaled_bitmap(orig, 1267, 20, 1, 1, 0, 0, size, size, 0);
     addBitmap(bg);
 
+    // 10 = Bezel
+    ALLEGRO_BITMAP* bezel = al_create_bitmap(size, size);
+    al_set_target_bitmap(bezel);
+    al_draw_scaled_bitmap(orig, 507, 0, 798, 798, 0, 0, size, size, 0);
+    addBitmap(bezel);
+
     al_set_target_backbuffer(globals.display);
 }
 
@@ -107,81 +120,89 @@ void adiLearjet::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
+    // Shadows that don't move with the wheel only change when calibrated
+    // or the power changes so multiply them into a single shadow layer
+    if (updateBackground(currentAdiCal * 2 + globals.electrics) && showShadows()) {
+        // Fill with white
+        al_clear_to_color(al_map_rgb(0xff, 0xff, 0xff));
+
+        // Set blender to multiply (shades of grey darken, white has no effect)
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+
+        // Wing pointer shadow
+        softBlend::drawBitmap(bitmaps[4], 186 * scaleFactor, (390 - (currentAdiCal * 10)) * scaleFactor);
+
+        // Bezel shadow
+        softBlend::drawBitmap(bitmaps[5], 70 * scaleFactor, 90 * scaleFactor);
+
+        if (!globals.electrics)
+        {
+            // OFF indicator shadow
+            softBlend::drawBitmap(bitmaps[6], 18 * scaleFactor, 200 * scaleFactor);
+        }
+
+        // Restore normal blender
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    }
+
     // Draw stuff into dest bitmap
     al_set_target_bitmap(bitmaps[1]);
 
     // Fill with black
-    al_draw_scaled_bitmap(bitmaps[0], 628, 850, 1, 1, 0, 0, size, size, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 628, 850, 1, 1, 0, 0, size, size, 0);
 
     // Blit wheel into wheel sized bitmap
     al_set_target_bitmap(bitmaps[2]);
-    al_draw_scaled_bitmap(bitmaps[0], 0, 900 + (pitchAngle * 5), 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 0, 900 + (pitchAngle * 5), 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
 
     // Set blender to multiply (shades of grey darken, white has no effect)
     al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
     // Draw graduation to make wheel look round
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
     // Restore normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
     // Draw bits above and below the wheel
-    al_draw_scaled_bitmap(bitmaps[0], 507, 972, 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 507, 972, 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
     al_set_target_bitmap(bitmaps[1]);
 
     // Draw wheel
-    al_draw_rotated_bitmap(bitmaps[2], 253 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, bankAngle * 0.7111111 * DegreesToRadians, 0);
+    softBlend::drawRotatedBitmap(bitmaps[2], 253 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, bankAngle * 0.7111111 * DegreesToRadians, 0);
 
-    if (globals.enableShadows)
+    if (showShadows())
     {
-        // Fill roll pointer shadow sprite with white
-        al_set_target_bitmap(bitmaps[7]);
-        al_draw_scaled_bitmap(bitmaps[0], 1484, 1387, 1, 1, 0, 0, size, size, 0);
-
-        // Draw roll_pointer shadow into trans5
-        al_draw_scaled_rotated_bitmap(bitmaps[9], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 415 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
-        al_set_target_bitmap(bitmaps[1]);
-
         // Draw shadows
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
-        // Wing pointer shadow
-        al_draw_bitmap(bitmaps[4], 186 * scaleFactor, (390 - (currentAdiCal * 10)) * scaleFactor, 0);
-
-        // Bezel shadow
-        al_draw_bitmap(bitmaps[5], 70 * scaleFactor, 90 * scaleFactor, 0);
-
-        if (!globals.electrics)
-        {
-            // OFF indicator shadow
-            al_draw_bitmap(bitmaps[6], 18 * scaleFactor, 200 * scaleFactor, 0);
-        }
+        // Wing pointer, bezel and OFF indicator shadows
+        softBlend::drawBitmap(background, 0, 0);
 
         // Roll pointer shadow
-        al_draw_bitmap(bitmaps[7], 0, 0, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[7], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 415 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Draw Bezel
-    al_draw_scaled_bitmap(bitmaps[0], 507, 0, 798, 798, 0, 0, size, size, 0);
+    softBlend::drawBitmap(bitmaps[10], 0, 0);
 
     if (!globals.electrics)
     {
         // Draw OFF Indicator
-        al_draw_scaled_bitmap(bitmaps[0], 1236, 874, 213, 362, 15 * scaleFactor, 200 * scaleFactor, 213 * scaleFactor, 362 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[0], 1236, 874, 213, 362, 15 * scaleFactor, 200 * scaleFactor, 213 * scaleFactor, 362 * scaleFactor, 0);
     }
 
     // Draw wing pointer Indicator
-    al_draw_scaled_bitmap(bitmaps[0], 523, 820, 544, 92, 200 * scaleFactor, (380 - (currentAdiCal * 10)) * scaleFactor, 544 * scaleFactor, 92 * scaleFactor, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 523, 820, 544, 92, 200 * scaleFactor, (380 - (currentAdiCal * 10)) * scaleFactor, 544 * scaleFactor, 92 * scaleFactor, 0);
 
     // Draw roll pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[8], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[8], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -216,97 +237,48 @@ void adiLearjet::update()
     double timeDifference = 0;
     if (globals.electrics)
     {
-        time(&lastPowerTime);
+        lastPowerTime = globals.frameTime;
 
         // Power to go off after 5 - 7 mins
         gyroSpinTime = rand() % 120 + 300;
-        failCount = 0;
     }
     else
     {
-        time_t now;
-        time(&now);
-
         // Secs power is off
-        timeDifference = (double)difftime(now, lastPowerTime);
+        timeDifference = globals.frameTime - lastPowerTime;
+    }
+
+    double frameSecs = globals.frameTime - lastUpdateTime;
+    lastUpdateTime = globals.frameTime;
+
+    if (frameSecs > MaxFrameSecs)
+    {
+        frameSecs = MaxFrameSecs;
     }
 
     if (timeDifference >= gyroSpinTime)
     {
-        if (failCount++ <= 200)
+        // Gyro topples for a few seconds
+        if (timeDifference - gyroSpinTime <= GyroToppleTime)
         {
             if (pitchAngle < 90)
             {
-                pitchAngle += 0.03;
+                pitchAngle += 0.9 * frameSecs;
             }
 
             if (bankAngle < 180)
             {
-                bankAngle += 0.3;
+                bankAngle += 9 * frameSecs;
             }
         }
-        else
-        {
-            failCount = 201;
-        }
     }
     else
     {
         double targetPitch = simVars->adiPitch;
-        double diff = abs(targetPitch - pitchAngle);
-
-        if (diff > 80.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 20.0; else pitchAngle -= 20.0;
-        }
-        else if (diff > 40.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 10.0; else pitchAngle -= 10.0;
-        }
-        else if (diff > 20.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 5.0; else pitchAngle -= 5.0;
-        }
-        else if (diff > 10.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 2.5; else pitchAngle -= 2.5;
-        }
-        else if (diff > 5.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 1.25; else pitchAngle -= 1.25;
-        }
-        else if (diff > 0.625) {
-            if (pitchAngle < targetPitch) pitchAngle += 0.625; else pitchAngle -= 0.625;
-        }
-        else {
-            pitchAngle = targetPitch;
-        }
+        pitchSmooth.update(pitchAngle, targetPitch);
 
         double targetBank = simVars->adiBank;
-        diff = abs(targetBank - bankAngle);
-
-        // Stop instrument flipping by 360 degrees
-        if (diff > 300.0) {
-            if (bankAngle < targetBank) bankAngle += 360.0; else bankAngle -= 360.0;
-            diff = abs(targetBank - bankAngle);
-        }
-
-        if (diff > 80.0) {
-            if (bankAngle < targetBank) bankAngle += 20.0; else bankAngle -= 20.0;
-        }
-        else if (diff > 40.0) {
-            if (bankAngle < targetBank) bankAngle += 10.0; else bankAngle -= 10.0;
-        }
-        else if (diff > 20.0) {
-            if (bankAngle < targetBank) bankAngle += 5.0; else bankAngle -= 5.0;
-        }
-        else if (diff > 10.0) {
-            if (bankAngle < targetBank) bankAngle += 2.5; else bankAngle -= 2.5;
-        }
-        else if (diff > 5.0) {
-            if (bankAngle < targetBank) bankAngle += 1.25; else bankAngle -= 1.25;
-        }
-        else if (diff > 0.625) {
-            if (bankAngle < targetBank) bankAngle += 0.625; else bankAngle -= 0.625;
-        }
-        else {
-            bankAngle = targetBank;
-        }
+        bankSmooth.update(bankAngle, targetBank);
 
         if (currentAdiCal > adiCal && currentAdiCal > -10)
         {
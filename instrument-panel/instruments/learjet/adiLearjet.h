@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class adiLearjet : public instrument
 {
@@ -13,11 +14,13 @@ private:
     // Instrument values (calculated from variables and needed to draw the instrument)
     double bankAngle = 0;
     double pitchAngle = 0;
+    smoother pitchSmooth{ 0.2, 600, 0.625 };
+    smoother bankSmooth{ 0.2, 600, 0.625, 360 };
     int adiCal = 0;
     int currentAdiCal = 0;
     int gyroSpinTime = 0;
-    int failCount = 201;
-    time_t lastPowerTime;
+    double lastUpdateTime = 0;
+    double lastPowerTime;
 
     // Hardware knobs
     int calKnob = -1;
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include "nav.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(nav, "Nav", 20, 50, 1000, 600);
 
 nav::nav(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -54,114 +57,102 @@ void nav::resize()
     al_draw_scaled_bitmap(orig, 0, 400, 1600, 400, 0, 0, size, 400 * scaleFactorY, 0);
     addBitmap(bmp);
 
-    // 4 = Digits
-    bmp = al_create_bitmap(380, 80);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 0, 800, 380, 80, 0, 0, 0);
-    addBitmap(bmp);
+    // 4 = Digits, decimal point and altitude minus
+    digits.setDigits(0, 800, 38, 80, 38);
+    digits.addGlyph('.', 380, 800, 20, 80, 20);
+    digits.addGlyph('-', 400, 832, 38, 48, 38, 32);
+    addBitmap(digits.createAtlas(orig, scaleFactorX, scaleFactorY));
 
-    // 5 = Dot
-    bmp = al_create_bitmap(20, 80);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 380, 800, 20, 80, 0, 0, 0);
-    addBitmap(bmp);
-
-    // 6 = Switch
+    // 5 = Switch
     bmp = al_create_bitmap(80, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 400, 800, 80, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 7 = Transponder state selected
+    // 6 = Transponder state selected
     bmp = al_create_bitmap(320, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 480, 800, 320, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 8 = Transponder state
+    // 7 = Transponder state
     bmp = al_create_bitmap(320, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 480, 834, 320, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 9 = TX
+    // 8 = TX
     bmp = al_create_bitmap(160, 24);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 800, 839, 160, 24, 0, 0, 0);
     addBitmap(bmp);
 
-    // 10 = Autopilot switches
+    // 9 = Autopilot switches
     bmp = al_create_bitmap(640, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 800, 800, 640, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 11 = Autopilot display
+    // 10 = Autopilot display
     bmp = al_create_bitmap(1152, 50);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 0, 884, 1152, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    // 12 = Autopilot vertical speed digits
+    // 11 = Autopilot vertical speed digits
     bmp = al_create_bitmap(320, 50);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1152, 884, 320, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    // 13 = Autopilot vertical speed 00fpm
+    // 12 = Autopilot vertical speed 00fpm
     bmp = al_create_bitmap(162, 50);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 966, 834, 162, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    // 14 = Autopilot vertical speed minus
+    // 13 = Autopilot vertical speed minus
     bmp = al_create_bitmap(23, 50);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1128, 834, 23, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    // 15 = Autopilot ALTS display
+    // 14 = Autopilot ALTS display
     bmp = al_create_bitmap(128, 50);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1151, 834, 128, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    // 16 = Autopilot LOC display
+    // 15 = Autopilot LOC display
     bmp = al_create_bitmap(66, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1280, 834, 66, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 17 = Autopilot G/S display
+    // 16 = Autopilot G/S display
     bmp = al_create_bitmap(66, 34);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1346, 834, 66, 34, 0, 0, 0);
     addBitmap(bmp);
 
-    // 18 = Autopilot MAN TOGA display
+    // 17 = Autopilot MAN TOGA display
     bmp = al_create_bitmap(172, 32);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1427, 834, 172, 32, 0, 0, 0);
     addBitmap(bmp);
 
-    // 19 = Autopilot MAN MCT display
+    // 18 = Autopilot MAN MCT display
     bmp = al_create_bitmap(148, 32);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 1451, 800, 148, 32, 0, 0, 0);
     addBitmap(bmp);
 
-    // 20 = Managed or selected indicator
+    // 19 = Managed or selected indicator
     bmp = al_create_bitmap(21, 21);
     al_set_target_bitmap(bmp);
     al_draw_bitmap_region(orig, 448, 844, 21, 21, 0, 0, 0);
     addBitmap(bmp);
 
-    // 21 = Altitude minus
-    bmp = al_create_bitmap(38, 48);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 400, 832, 38, 48, 0, 0, 0);
-    addBitmap(bmp);
-
     al_set_target_backbuffer(globals.display);
 }
 
@@ -189,7 +180,7 @@ void nav::render()
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.avionics) {
         dimInstrument();
@@ -202,7 +193,7 @@ void nav::render()
 void nav::renderNav()
 {
     // Add main nav
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add panel 1 frequencies
     addFreq3dp(com1Freq, 237, 19);
@@ -228,47 +219,47 @@ void nav::renderNav()
     // Add selected switch
     switch (switchSel) {
     case Com1:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactorX, 104 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 80, 34, 460 * scaleFactorX, 104 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
         break;
     case Nav1:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactorX, 104 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 80, 34, 1064 * scaleFactorX, 104 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
         break;
     case Com2:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactorX, 233 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 80, 34, 460 * scaleFactorX, 233 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
         break;
     case Nav2:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactorX, 233 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 80, 34, 1064 * scaleFactorX, 233 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
         break;
     case Adf:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 80, 34, 460 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
         break;
     }
 
     // Add transmit1 selected or state
     if (switchSel == Transmit1) {
-        al_draw_scaled_bitmap(bitmaps[9], 80, 0, 80, 24, 377 * scaleFactorX, 106 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[8], 80, 0, 80, 24, 377 * scaleFactorX, 106 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
     }
     else if (simVars->com1Transmit) {
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 80, 24, 377 * scaleFactorX, 106 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[8], 0, 0, 80, 24, 377 * scaleFactorX, 106 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
     }
 
     // Add transmit2 selected or state
     if (switchSel == Transmit2) {
-        al_draw_scaled_bitmap(bitmaps[9], 80, 0, 80, 24, 377 * scaleFactorX, 235 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[8], 80, 0, 80, 24, 377 * scaleFactorX, 235 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
     }
     else if (simVars->com2Transmit) {
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 80, 24, 377 * scaleFactorX, 235 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[8], 0, 0, 80, 24, 377 * scaleFactorX, 235 * scaleFactorY, 80 * scaleFactorX, 24 * scaleFactorY, 0);
     }
 
     // Add transponder state
     int statePos = 80 * transponderState;
     if (switchSel == Transponder) {
         // Add transponder state selected
-        al_draw_scaled_bitmap(bitmaps[7], statePos, 0, 80, 34, 1064 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[6], statePos, 0, 80, 34, 1064 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
     }
     else {
         // Add transponder state
-        al_draw_scaled_bitmap(bitmaps[8], statePos, 0, 80, 34, 1064 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[7], statePos, 0, 80, 34, 1064 * scaleFactorX, 363 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
     }
 }
 
@@ -278,12 +269,12 @@ void nav::renderNav()
 void nav::renderAutopilot()
 {
     // Add main autopilot
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
 
     // Add autopilot switch selected
     int selPos = 80 * (switchSel - (int)Autopilot);
     int destPos = 203 + 160 * (switchSel - (int)Autopilot);
-    al_draw_scaled_bitmap(bitmaps[10], selPos, 0, 80, 34, destPos * scaleFactorX, 339 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
+    softBlend::drawScaledBitmap(bitmaps[9], selPos, 0, 80, 34, destPos * scaleFactorX, 339 * scaleFactorY, 80 * scaleFactorX, 34 * scaleFactorY, 0);
 
     int destSizeX = 128 * scaleFactorX;
     int destSizeY = 50 * scaleFactorY;
@@ -312,83 +303,83 @@ void nav::renderAutopilot()
 
     // Add auto throttle display
     if (simVars->autothrottleActive) {
-        al_draw_scaled_bitmap(bitmaps[11], 1024, 0, 128, 50, 212 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 1024, 0, 128, 50, 212 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
     }
 
     // Add spd hold display
     if (autopilotSpd == SpdHold) {
-        al_draw_scaled_bitmap(bitmaps[11], 896, 0, 128, 50, 331 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 896, 0, 128, 50, 331 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
     }
 
     // Add hdg display
     switch (autopilotHdg) {
     case HdgSet:
-        al_draw_scaled_bitmap(bitmaps[11], 0, 0, 128, 50, 461 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 0, 0, 128, 50, 461 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         break;
     case LevelFlight:
-        al_draw_scaled_bitmap(bitmaps[11], 128, 0, 128, 50, 461 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 128, 0, 128, 50, 461 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         break;
     }
 
     // Add ap display
     if (simVars->autopilotEngaged) {
-        al_draw_scaled_bitmap(bitmaps[11], 256, 0, 64, 50, 612 * scaleFactorX, 252 * scaleFactorY, 64 * scaleFactorX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 256, 0, 64, 50, 612 * scaleFactorX, 252 * scaleFactorY, 64 * scaleFactorX, destSizeY, 0);
     }
 
     // Add fd display
     if (simVars->flightDirectorActive) {
-        al_draw_scaled_bitmap(bitmaps[11], 320, 0, 63, 50, 688 * scaleFactorX, 252 * scaleFactorY, 63 * scaleFactorX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 320, 0, 63, 50, 688 * scaleFactorX, 252 * scaleFactorY, 63 * scaleFactorX, destSizeY, 0);
     }
 
     // Add alt display
     switch (autopilotAlt) {
     case AltHold:
-        al_draw_scaled_bitmap(bitmaps[11], 384, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 384, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         break;
 
     case PitchHold:
-        al_draw_scaled_bitmap(bitmaps[11], 512, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 512, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         break;
 
     case VerticalSpeedHold:
-        al_draw_scaled_bitmap(bitmaps[11], 640, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 640, 0, 128, 50, 756 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         // Add white alts display
-        al_draw_scaled_bitmap(bitmaps[15], 0, 0, 128, 50, 1160 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
+        softBlend::drawScaledBitmap(bitmaps[14], 0, 0, 128, 50, 1160 * scaleFactorX, 252 * scaleFactorY, destSizeX, destSizeY, 0);
         break;
     }
 
     if (simVars->autopilotApproachHold) {
         // Add cyan LOC display
-        al_draw_scaled_bitmap(bitmaps[16], 0, 0, 66, 34, 1317 * scaleFactorX, 227 * scaleFactorY, 66 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[15], 0, 0, 66, 34, 1317 * scaleFactorX, 227 * scaleFactorY, 66 * scaleFactorX, 34 * scaleFactorY, 0);
     }
 
     if (simVars->autopilotGlideslopeHold) {
         // Add cyan G/S display
-        al_draw_scaled_bitmap(bitmaps[17], 0, 0, 66, 34, 1317 * scaleFactorX, 270 * scaleFactorY, 66 * scaleFactorX, 34 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[16], 0, 0, 66, 34, 1317 * scaleFactorX, 270 * scaleFactorY, 66 * scaleFactorX, 34 * scaleFactorY, 0);
     }
 
     if (simVars->autothrottleActive && simVars->throttlePosition > 95) {
         // Add MAN TOGA display
-        al_draw_scaled_bitmap(bitmaps[18], 0, 0, 172, 32, 391 * scaleFactorX, 187 * scaleFactorY, 172 * scaleFactorX, 32 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[17], 0, 0, 172, 32, 391 * scaleFactorX, 187 * scaleFactorY, 172 * scaleFactorX, 32 * scaleFactorY, 0);
     }
     else if (simVars->autothrottleActive && simVars->throttlePosition > 91) {
         // Add MAN MCT display
-        al_draw_scaled_bitmap(bitmaps[19], 0, 0, 148, 32, 403 * scaleFactorX, 187 * scaleFactorY, 148 * scaleFactorX, 32 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[18], 0, 0, 148, 32, 403 * scaleFactorX, 187 * scaleFactorY, 148 * scaleFactorX, 32 * scaleFactorY, 0);
     }
 
     if (managedSpeed) {
         // Add managed speed indicator
-        al_draw_scaled_bitmap(bitmaps[20], 0, 0, 21, 21, 384 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[19], 0, 0, 21, 21, 384 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
     }
 
     if (managedHeading) {
         // Add managed heading indicator
-        al_draw_scaled_bitmap(bitmaps[20], 0, 0, 21, 21, 518 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[19], 0, 0, 21, 21, 518 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
     }
 
     if (managedAltitude) {
         // Add managed altitude indicator
-        al_draw_scaled_bitmap(bitmaps[20], 0, 0, 21, 21, 806 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
+        softBlend::drawScaledBitmap(bitmaps[19], 0, 0, 21, 21, 806 * scaleFactorX, 220 * scaleFactorY, 21 * scaleFactorX, 21 * scaleFactorY, 0);
     }
 }
 
@@ -397,17 +388,7 @@ void nav::renderAutopilot()
 /// </summary>
 void nav::addNum3(int val, int x, int y)
 {
-    int digit1 = (val % 1000) / 100;
-    int digit2 = (val % 100) / 10;
-    int digit3 = val % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactorX, yPos, width, height, 0);
+    digits.draw(x, y, "%03d", val % 1000);
 }
 
 /// <summary>
@@ -415,27 +396,8 @@ void nav::addNum3(int val, int x, int y)
 /// </summary>
 void nav::addNum4(int val, int x, int y, bool leading)
 {
-    int digit1 = (val % 10000) / 1000;
-    int digit2 = (val % 1000) / 100;
-    int digit3 = (val % 100) / 10;
-    int digit4 = val % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    if (leading || digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    }
-    x += 38;
-
-    if (leading || digit1 != 0 || digit2 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    }
-    x += 38;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 38) * scaleFactorX, yPos, width, height, 0);
+    // Last two digits are always shown
+    digits.draw(x, y, leading ? "%04d" : "%4.2d", val % 10000);
 }
 
 /// <summary>
@@ -444,47 +406,14 @@ void nav::addNum4(int val, int x, int y, bool leading)
 /// </summary>
 void nav::addNum5(int val, int x, int y, bool leading)
 {
-    bool isNegative = (val < 0);
-    if (isNegative) {
-        val = -val;
-    }
-
-    int digit1 = (val % 100000) / 10000;
-    int digit2 = (val % 10000) / 1000;
-    int digit3 = (val % 1000) / 100;
-    int digit4 = (val % 100) / 10;
-    int digit5 = val % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    if (isNegative && digit2 != 0) {
-        // Add minus
-        al_draw_scaled_bitmap(bitmaps[21], 0, 0, 38, 48, x * scaleFactorX, (y + 32) * scaleFactorY, width, 48 * scaleFactorY, 0);
-    }
-    else if (leading || digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    }
-    x += 38;
-
-    if (isNegative && digit2 == 0) {
-        // Add minus
-        al_draw_scaled_bitmap(bitmaps[21], 0, 0, 38, 48, x * scaleFactorX, (y + 32) * scaleFactorY, width, 48 * scaleFactorY, 0);
-    }
-    else if (leading || digit1 != 0 || digit2 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    }
-
-    if (leading || digit1 != 0 || digit2 != 0 || digit3 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 38) * scaleFactorX, yPos, width, height, 0);
+    if (val < 0) {
+        // Minus goes in the first column or the second if under 1000
+        int absVal = -val % 10000;
+        digits.draw(x, y, absVal < 1000 ? " -%3d" : "-%4d", absVal);
     }
-
-    if (leading || digit1 != 0 || digit2 != 0 || digit3 != 0 || digit4 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 76) * scaleFactorX, yPos, width, height, 0);
+    else {
+        digits.draw(x, y, leading ? "%05d" : "%5d", val % 100000);
     }
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 114) * scaleFactorX, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -492,18 +421,7 @@ void nav::addNum5(int val, int x, int y, bool leading)
 /// </summary>
 void nav::addNum2dp(int val, int x, int y)
 {
-    int digit1 = (val % 1000) / 100;
-    int digit2 = (val % 100) / 10;
-    int digit3 = val % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 38) * scaleFactorX, yPos, 20 * scaleFactorX, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 58) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 96) * scaleFactorX, yPos, width, height, 0);
+    digits.draw(x, y, "%d.%02d", (val % 1000) / 100, val % 100);
 }
 
 /// <summary>
@@ -511,22 +429,7 @@ void nav::addNum2dp(int val, int x, int y)
 /// </summary>
 void nav::addFreq2dp(int freq, int x, int y)
 {
-    int digit1 = freq / 10000;
-    int digit2 = (freq % 10000) / 1000;
-    int digit3 = (freq % 1000) / 100;
-    int digit4 = (freq % 100) / 10;
-    int digit5 = freq % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactorX, yPos, 20 * scaleFactorX, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactorX, yPos, width, height, 0);
+    digits.draw(x, y, "%03d.%02d", freq / 100, freq % 100);
 }
 
 /// <summary>
@@ -534,24 +437,7 @@ void nav::addFreq2dp(int freq, int x, int y)
 /// </summary>
 void nav::addFreq3dp(int freq, int x, int y)
 {
-    int digit1 = freq / 100000;
-    int digit2 = (freq % 100000) / 10000;
-    int digit3 = (freq % 10000) / 1000;
-    int digit4 = (freq % 1000) / 100;
-    int digit5 = (freq % 100) / 10;
-    int digit6 = freq % 10;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactorX, yPos, 20 * scaleFactorX, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit6, 0, 38, 80, (x + 210) * scaleFactorX, yPos, width, height, 0);
+    digits.draw(x, y, "%03d.%03d", freq / 1000, freq % 1000);
 }
 
 /// <summary>
@@ -559,22 +445,8 @@ void nav::addFreq3dp(int freq, int x, int y)
 /// </summary>
 void nav::addSquawk(int code, int x, int y)
 {
-    // Transponder code is in BCO16
-    int digit1 = code / 4096;
-    code -= digit1 * 4096;
-    int digit2 = code / 256;
-    code -= digit2 * 256;
-    int digit3 = code / 16;
-    int digit4 = code - digit3 * 16;
-
-    int yPos = y * scaleFactorY;
-    int width = 38 * scaleFactorX;
-    int height = 80 * scaleFactorY;
-
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 76) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 152) * scaleFactorX, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 228) * scaleFactorX, yPos, width, height, 0);
+    // Transponder code is in BCO16 so each hex digit is one octal digit
+    digits.draw(x, y, "%x %x %x %x", (code >> 12) & 0xf, (code >> 8) & 0xf, (code >> 4) & 0xf, code & 0xf);
 }
 
 void nav::addVerticalSpeed(int x, int y)
@@ -585,7 +457,7 @@ void nav::addVerticalSpeed(int x, int y)
     if (simVars->autopilotVerticalSpeed == 0) {
         // Add 0fpm
         x += 119;
-        al_draw_scaled_bitmap(bitmaps[13], 32, 0, 130, 50, x * scaleFactorX, yPos, 130 * scaleFactorX, height, 0);
+        softBlend::drawScaledBitmap(bitmaps[12], 32, 0, 130, 50, x * scaleFactorX, yPos, 130 * scaleFactorX, height, 0);
         return;
     }
 
@@ -599,20 +471,20 @@ void nav::addVerticalSpeed(int x, int y)
 
     if (simVars->autopilotVerticalSpeed < 0) {
         // Add minus
-        al_draw_scaled_bitmap(bitmaps[14], 0, 0, 23, 50, x * scaleFactorX, yPos, 23 * scaleFactorX, height, 0);
+        softBlend::drawScaledBitmap(bitmaps[13], 0, 0, 23, 50, x * scaleFactorX, yPos, 23 * scaleFactorX, height, 0);
     }
     x += 23;
 
     if (digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[12], 32 * digit1, 0, 32, 50, x * scaleFactorX, yPos, 32 * scaleFactorX, height, 0);
+        softBlend::drawScaledBitmap(bitmaps[11], 32 * digit1, 0, 32, 50, x * scaleFactorX, yPos, 32 * scaleFactorX, height, 0);
         x += 32;
     }
 
-    al_draw_scaled_bitmap(bitmaps[12], 32 * digit2, 0, 32, 50, x * scaleFactorX, yPos, 32 * scaleFactorX, height, 0);
+    softBlend::drawScaledBitmap(bitmaps[11], 32 * digit2, 0, 32, 50, x * scaleFactorX, yPos, 32 * scaleFactorX, height, 0);
     x += 32;
 
     // Add 00fpm
-    al_draw_scaled_bitmap(bitmaps[13], 0, 0, 162, 50, x * scaleFactorX, yPos, 162 * scaleFactorX, height, 0);
+    softBlend::drawScaledBitmap(bitmaps[12], 0, 0, 162, 50, x * scaleFactorX, yPos, 162 * scaleFactorX, height, 0);
 }
 
 /// <summary>
@@ -862,20 +734,19 @@ void nav::updateKnobs()
             else {
                 autopilotSwitchPressed();
             }
-            time(&lastPush);
+            longPushPending = true;
         }
         else {
             // Released
-            lastPush = 0;
+            longPushPending = false;
         }
         prevSelPush = val;
         adjustSetSel = 0;
     }
 
     // Check for long press (over 1 sec)
-    if (lastPush > 0) {
-        time(&now);
-        if (now - lastPush > 1) {
+    if (longPushPending) {
+        if (globals.hardwareKnobs->pressDuration(selPush) > 1) {
             if (switchSel == Speed) {
                 // Long press on speed switches between managed and selected
                 if (autopilotSpd == SpdHold) {
@@ -892,7 +763,7 @@ void nav::updateKnobs()
                 }
                 manSelSpeed();
             }
-            lastPush = 0;
+            longPushPending = false;
         }
     }
 
@@ -917,14 +788,13 @@ void nav::updateKnobs()
             }
             prevAdjustVal = val;
         }
-        time(&lastAdjust);
+        adjusting = true;
     }
-    else if (lastAdjust != 0) {
+    else if (adjusting) {
         // Reset digit set selection if more than 5 seconds since last adjustment
-        time(&now);
-        if (now - lastAdjust > 5) {
+        if (globals.hardwareKnobs->idleTime(adjustKnob) > 5) {
             adjustSetSel = 0;
-            lastAdjust = 0;
+            adjusting = false;
         }
     }
 
@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "numericDisplay.h"
 
 class nav : public instrument
 {
@@ -48,6 +49,7 @@ private:
     Aircraft loadedAircraft = UNDEFINED;
     float scaleFactorX;
     float scaleFactorY;
+    numericDisplay digits;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
     Switch switchSel = Com1;
@@ -92,9 +94,8 @@ private:
     int prevSelPush = 0;
     int prevAdjustVal = 0;
     int prevAdjustPush = 0;
-    time_t lastAdjust = 0;
-    time_t lastPush = 0;
-    time_t now;
+    bool adjusting = false;
+    bool longPushPending = false;
 
 public:
     nav(int xPos, int yPos, int size);
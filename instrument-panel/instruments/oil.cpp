@@ -2,12 +2,16 @@
 #include <stdlib.h>
 #include "oil.h"
 #include "simvars.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(oil, "Oil", 18, 50, 750, 200);
 
 oil::oil(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Oil");
     addVars();
     simVars = &globals.simVars->simVars;
+    derived = &globals.simVars->derived;
     resize();
 }
 
@@ -66,24 +70,35 @@ void oil::render()
     // Use normal blender
     al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
+    if (skipRedraw()) {
+        // Show the last display drawn
+        al_set_target_backbuffer(globals.display);
+        softBlend::drawBitmap(bitmaps[1], xPos, yPos);
+
+        if (!globals.electrics) {
+            dimInstrument();
+        }
+        return;
+    }
+
     // Draw stuff into dest bitmap
     al_set_target_bitmap(bitmaps[1]);
 
     // Add dials
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add left pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, tempAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 60 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, tempAngle * DegreesToRadians, 0);
 
     // Add right pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, pressureAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[4], 60, 20, 340 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, pressureAngle * DegreesToRadians, 0);
 
     // Add top layer
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[3], 0, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -108,22 +123,8 @@ void oil::update()
     }
 
     // Calculate values
-    if (simVars->numberOfEngines == 2) {
-        oilTemp = (simVars->oilTemp1 + simVars->oilTemp2) / 2;
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2) / 2;
-    }
-    else if (simVars->numberOfEngines > 3) {
-        oilTemp = (simVars->oilTemp1 + simVars->oilTemp2 + simVars->oilTemp3 + simVars->oilTemp4) / 4;
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2 + simVars->oilPressure3 + simVars->oilPressure4) / 4;
-    }
-    else if (simVars->numberOfEngines == 3) {
-        oilTemp = (simVars->oilTemp1 + simVars->oilTemp2 + simVars->oilTemp3) / 3;
-        oilPressure = (simVars->oilPressure1 + simVars->oilPressure2 + simVars->oilPressure3) / 3;
-    }
-    else {
-        oilTemp = simVars->oilTemp1;
-        oilPressure = simVars->oilPressure1;
-    }
+    oilTemp = derived->get(DERIVED_OIL_TEMP);
+    oilPressure = derived->get(DERIVED_OIL_PRESSURE);
 
     if (oilTemp > 100) {
         tempAngle = 40 - (oilTemp - 100) * 0.7;
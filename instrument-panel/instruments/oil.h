@@ -2,12 +2,14 @@
 #define _OIL_H_
 
 #include "simvars.h"
+#include "derivedVars.h"
 #include "instrument.h"
 
 class oil : public instrument
 {
 private:
     SimVars* simVars;
+    derivedVars* derived;
     float scaleFactor;
 
     // Instrument values (caclulated from variables and needed to draw the instrument)
@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "radCom.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(radCom, "Rad Com", 12, 1500, 750, 300);
 
 radCom::radCom(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -46,23 +50,20 @@ void radCom::resize()
     al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
     addBitmap(bmp);
 
-    // 3 = Digits 1
-    bmp = al_create_bitmap(570, 100);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 800, 570, 100, 0, 0, 570, 100, 0);
-    addBitmap(bmp);
+    // 3 = Digits 1 (decimal points already drawn)
+    largeDigits.setDigits(0, 800, 57, 100, 57);
+    largeDigits.addSpace('.', 30);
+    addBitmap(largeDigits.createAtlas(orig, scaleFactor, scaleFactor));
 
     // 4 = Digits 2
-    bmp = al_create_bitmap(440, 80);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 900, 440, 80, 0, 0, 440, 80, 0);
-    addBitmap(bmp);
+    smallDigits.setDigits(0, 900, 44, 80, 44);
+    smallDigits.addSpace('.', 23);
+    addBitmap(smallDigits.createAtlas(orig, scaleFactor, scaleFactor));
 
     // 5 = Digits 2 selected
-    bmp = al_create_bitmap(440, 80);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 980, 440, 80, 0, 0, 440, 80, 0);
-    addBitmap(bmp);
+    selectedDigits.setDigits(0, 980, 44, 80, 44);
+    selectedDigits.addSpace('.', 23);
+    addBitmap(selectedDigits.createAtlas(orig, scaleFactor, scaleFactor));
 
     // 6 = Comm2
     bmp = al_create_bitmap(196 * scaleFactor, 44 * scaleFactor);
@@ -101,21 +102,21 @@ void radCom::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add Comm2
     if (!simVars->com1Transmit) {
-        al_draw_bitmap(bitmaps[6], 313 * scaleFactor, 78 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[6], 313 * scaleFactor, 78 * scaleFactor);
     }
 
     // Add swap button
     if (switchSel == Swap) {
-        al_draw_bitmap(bitmaps[7], 367 * scaleFactor, 378 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[7], 367 * scaleFactor, 378 * scaleFactor);
     }
 
     // Add adjust button
     if (switchSel == Adjust) {
-        al_draw_bitmap(bitmaps[8], 520 * scaleFactor, 377 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[8], 520 * scaleFactor, 377 * scaleFactor);
     }
 
     // Add frequencies
@@ -124,7 +125,7 @@ void radCom::render()
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.avionics) {
         dimInstrument();
@@ -136,69 +137,44 @@ void radCom::render()
 /// </summary>
 void radCom::addFreq3dp(int freq, int x, int y, bool isLarge)
 {
-    int digit1 = freq / 100000;
-    int digit2 = (freq % 100000) / 10000;
-    int digit3 = (freq % 10000) / 1000;
-    int digit4 = (freq % 1000) / 100;
-    int digit5 = (freq % 100) / 10;
-    int digit6 = freq % 10;
-
-    int yPos = y * scaleFactor;
-    int wide;
-    int tall;
-    int preDot = x;
-    int postDot;
-    int bmp;
-    int fromBmp;
-
     if (isLarge) {
-        wide = 57;
-        tall = 100;
-        postDot = x + wide * 3 + 30;
-        bmp = 3;
-    }
-    else {
-        wide = 44;
-        tall = 80;
-        postDot = x + wide * 3 + 23;
-        bmp = 4;
+        largeDigits.draw(x, y, "%03d.%03d", freq / 1000, freq % 1000);
+        return;
     }
 
-    int width = wide * scaleFactor;
-    int height = tall * scaleFactor;
-
-    // Add first 3 digits
-    if (!isLarge && switchSel == Adjusting && adjustSetSel == 0) {
-        fromBmp = bmp + 1;
-    }
-    else {
-        fromBmp = bmp;
+    if (switchSel != Adjusting) {
+        smallDigits.draw(x, y, "%03d.%03d", freq / 1000, freq % 1000);
+        return;
     }
 
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit1, 0, wide, tall, preDot * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit2, 0, wide, tall, (preDot + wide) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit3, 0, wide, tall, (preDot + wide * 2) * scaleFactor, yPos, width, height, 0);
+    // Highlight the set of digits being adjusted
+    static const int SetStart[] = { 0, 4, 5 };
+    static const int SetEnd[] = { 3, 5, 7 };
 
-    // Add digit after decimal point
-    if (!isLarge && switchSel == Adjusting && adjustSetSel == 1) {
-        fromBmp = bmp + 1;
-    }
-    else {
-        fromBmp = bmp;
+    // Room for any int although the sets only line up with 7 characters
+    char text[16];
+    char selected[16];
+    if (snprintf(text, sizeof(text), "%03d.%03d", freq / 1000, freq % 1000) != 7) {
+        smallDigits.draw(x, y, "%s", text);
+        return;
     }
+    strcpy(selected, text);
 
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit4, 0, wide, tall, postDot * scaleFactor, yPos, width, height, 0);
+    for (int i = 0; text[i] != '\0'; i++) {
+        if (text[i] == '.') {
+            continue;
+        }
 
-    // Add last 2 digits
-    if (!isLarge && switchSel == Adjusting && adjustSetSel == 2) {
-        fromBmp = bmp + 1;
-    }
-    else {
-        fromBmp = bmp;
+        if (i >= SetStart[adjustSetSel] && i < SetEnd[adjustSetSel]) {
+            text[i] = ' ';
+        }
+        else {
+            selected[i] = ' ';
+        }
     }
 
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit5, 0, wide, tall, (postDot + wide) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[fromBmp], wide * digit6, 0, wide, tall, (postDot + wide * 2) * scaleFactor, yPos, width, height, 0);
+    smallDigits.draw(x, y, "%s", text);
+    selectedDigits.draw(x, y, "%s", selected);
 }
 
 /// <summary>
@@ -271,7 +247,7 @@ void radCom::updateKnobs()
                     else {
                         adjustDigits(-1);
                     }
-                    time(&lastAdjust);
+                    lastAdjust = globals.frameTime;
                     break;
             }
             prevVal = val;
@@ -286,22 +262,21 @@ void radCom::updateKnobs()
             switch (switchSel) {
                 case Swap:
                     // Debounce
-                    time(&now);
-                    if (now - lastSwap > 0) {
+                    if (globals.frameTime - lastSwap > 0.5) {
                         if (simVars->com1Transmit) {
                             globals.simVars->write(KEY_COM1_RADIO_SWAP);
                         }
                         else {
                             globals.simVars->write(KEY_COM2_RADIO_SWAP);
                         }
-                        time(&lastSwap);
+                        lastSwap = globals.frameTime;
                     }
                     break;
 
                 case Adjust:
                     switchSel = Adjusting;
                     adjustSetSel = 0;
-                    time(&lastAdjust);
+                    lastAdjust = globals.frameTime;
                     break;
 
                 case Adjusting:
@@ -310,7 +285,7 @@ void radCom::updateKnobs()
                     }
                     else {
                         adjustSetSel++;
-                        time(&lastAdjust);
+                        lastAdjust = globals.frameTime;
                     }
                     break;
             }
@@ -320,8 +295,7 @@ void radCom::updateKnobs()
 
     if (switchSel == Adjusting) {
         // Stop adjusting if more than 5 seconds since last adjustment
-        time(&now);
-        if (now - lastAdjust > 5) {
+        if (globals.frameTime - lastAdjust > 5) {
             switchSel = Adjust;
         }
     }
@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "numericDisplay.h"
 
 class radCom : public instrument
 {
@@ -15,6 +16,9 @@ private:
 
     SimVars* simVars;
     float scaleFactor;
+    numericDisplay largeDigits;
+    numericDisplay smallDigits;
+    numericDisplay selectedDigits;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
     Switch switchSel = Swap;
@@ -27,9 +31,8 @@ private:
     int selPush = -1;
     int prevVal = 0;
     int prevPush = 0;
-    time_t lastSwap = 0;
-    time_t lastAdjust = 0;
-    time_t now;
+    double lastSwap = 0;
+    double lastAdjust = 0;
 
 public:
     radCom(int xPos, int yPos, int size);
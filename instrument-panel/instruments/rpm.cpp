@@ -2,15 +2,17 @@
 #include <stdlib.h>
 #include <math.h>
 #include "rpm.h"
-#include "alternate/rpmPercent.h"
-#include "savageCub/rpmSavageCub.h"
-#include "spitfire/rpmSpitfire.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(rpm, "RPM", 10, 1100, 750, 300);
 
 
 rpm::rpm(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
+    secondary = true;
     setName("RPM");
     addVars();
     simVars = &globals.simVars->simVars;
@@ -105,42 +107,42 @@ void rpm::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add white digits
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit1 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 238 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit2 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 292 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit3 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 346 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit4 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 400 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[5], 0, (499 - digit1 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 238 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[5], 0, (499 - digit2 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 292 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[5], 0, (499 - digit3 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 346 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[5], 0, (499 - digit4 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 400 * scaleFactor, 564 * scaleFactor, 0);
 
     // Add black digits
-    al_draw_bitmap_region(bitmaps[6], 0, (499 - digit5 * 50.6) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 454 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[6], 0, (499 - digit5 * 50.6) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 454 * scaleFactor, 564 * scaleFactor, 0);
 
     // Add hourglass
-    al_draw_bitmap_region(bitmaps[7], 0, 44 * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 508 * scaleFactor, 564 * scaleFactor, 0);
+    softBlend::drawBitmapRegion(bitmaps[7], 0, 44 * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 508 * scaleFactor, 564 * scaleFactor, 0);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Add reverse thrust indicator
     if (simVars->throttlePosition < 0) {
-        al_draw_bitmap(bitmaps[8], 362 * scaleFactor, 496 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[8], 362 * scaleFactor, 496 * scaleFactor);
     }
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -158,22 +160,21 @@ void rpm::update()
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-        
-        if (loadedAircraft == SUPERMARINE_SPITFIRE) {
-            customInstrument = new rpmSpitfire(xPos, yPos, size, name);
+        // Use custom instrument for this aircraft if we have one
+        const char* variant = globals.aircraftTraits->variant("RPM");
+        if (variant[0] != '\0') {
+            useVariant(variant);
         }
         // Test for high-reving Rotax piston engine (e.g., Savage Cub, Shock Ultra, et al)
         else if ((int)simVars->engineType == 0 && simVars->engineMaxRpm > 5000) {
-            customInstrument = new rpmSavageCub(xPos, yPos, size, name);
+            useVariant("RPM Savage Cub");
         }
         // Test for Jet (1) and Turbine (5) engines
         else if ((int)simVars->engineType == 1 || (int)simVars->engineType == 5) {
-            customInstrument = new rpmPercent(xPos, yPos, size, name);
+            useVariant("RPM Percent");
+        }
+        else {
+            useVariant("");
         }
         // Otherwise, use this standard RPM gauge is for a piston engine with a 
         // typical red line at 2700 RPM. This gauge has a max of 3500 RPM.
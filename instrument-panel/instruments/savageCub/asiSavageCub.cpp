@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asiSavageCub.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(asiSavageCub, "ASI Savage Cub", "ASI", 22, 50, 50, 300);
 
 asiSavageCub::asiSavageCub(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -71,25 +75,25 @@ void asiSavageCub::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_scaled_bitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, size, size, 0);
+    softBlend::drawScaledBitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, size, size, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[3], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[3], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[2], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -117,21 +121,7 @@ void asiSavageCub::update()
     airspeedKnots = simVars->asiAirspeed * 2;
 
     // Not a linear scale!
-    if (airspeedKnots < 40) {
-        airspeedAngle = airspeedKnots * 0.013;
-    }
-    else if (airspeedKnots < 90) {
-        airspeedAngle = -0.03 + pow(airspeedKnots - 12.1, 1.439) * 0.0047;
-    }
-    else if (airspeedKnots < 120) {
-        airspeedAngle = 0.4 + pow(airspeedKnots - 12.1, 1.4) * 0.0046;
-    }
-    else if (airspeedKnots < 160) {
-        airspeedAngle = 1.53 + pow(airspeedKnots - 12.0, 1.320) * 0.0043;
-    }
-    else {
-        airspeedAngle = 2.27 + pow(airspeedKnots - 12.0, 1.28) * 0.0040;
-    }
+    airspeedAngle = asiAirspeedScale.lookup(airspeedKnots);
 }
 
 /// <summary>
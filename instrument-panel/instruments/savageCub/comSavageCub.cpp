@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include "comSavageCub.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(comSavageCub, "COM Savage Cub", 24, 350, 50, 300);
 
 comSavageCub::comSavageCub(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -39,11 +42,10 @@ void comSavageCub::resize()
     al_draw_scaled_bitmap(orig, 0, 0, 400, 400, 0, 0, size, size, 0);
     addBitmap(bmp);
 
-    // 3 = Digits
-    bmp = al_create_bitmap(320, 50);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 0, 400, 320, 50, 0, 0, 0);
-    addBitmap(bmp);
+    // 3 = Digits (decimal point already drawn)
+    digits.setDigits(0, 400, 32, 50, 32);
+    digits.addSpace('.', 32);
+    addBitmap(digits.createAtlas(orig, scaleFactor, scaleFactor));
 
     al_set_target_backbuffer(globals.display);
 }
@@ -64,7 +66,7 @@ void comSavageCub::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add com1 frequencies
     addFreq3dp(com1Freq, 105, 120);
@@ -72,7 +74,7 @@ void comSavageCub::render()
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.avionics) {
         dimInstrument();
@@ -84,24 +86,7 @@ void comSavageCub::render()
 /// </summary>
 void comSavageCub::addFreq3dp(int freq, int x, int y)
 {
-    int digit1 = freq / 100000;
-    int digit2 = (freq % 100000) / 10000;
-    int digit3 = (freq % 10000) / 1000;
-    int digit4 = (freq % 1000) / 100;
-    int digit5 = (freq % 100) / 10;
-    int digit6 = freq % 10;
-
-    int yPos = y * scaleFactor;
-    int width = 32 * scaleFactor;
-    int height = 50 * scaleFactor;
-
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit1, 0, 32, 50, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit2, 0, 32, 50, (x + 32) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit3, 0, 32, 50, (x + 64) * scaleFactor, yPos, width, height, 0);
-    // Decimal point already drawn
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit4, 0, 32, 50, (x + 128) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit5, 0, 32, 50, (x + 160) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit6, 0, 32, 50, (x + 192) * scaleFactor, yPos, width, height, 0);
+    digits.draw(x, y, "%03d.%03d", freq / 1000, freq % 1000);
 }
 
 /// <summary>
@@ -180,12 +165,11 @@ void comSavageCub::updateKnobs()
             globals.simVars->write(KEY_COM1_STBY_RADIO_SET_HZ, newVal);
             prevAdjustVal = val;
         }
-        time(&lastAdjust);
+        lastAdjust = globals.frameTime;
     }
     else if (lastAdjust != 0) {
         // Reset digit set selection if more than 5 seconds since last adjustment
-        time(&now);
-        if (now - lastAdjust > 5) {
+        if (globals.frameTime - lastAdjust > 5) {
             adjustSetSel = 0;
             lastAdjust = 0;
         }
@@ -3,12 +3,14 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "numericDisplay.h"
 
 class comSavageCub : public instrument
 {
 private:
     SimVars* simVars;
     float scaleFactor;
+    numericDisplay digits;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
     int adjustSetSel = 0;
@@ -23,8 +25,7 @@ private:
     int prevSelPush = 0;
     int prevAdjustVal = 0;
     int prevAdjustPush = 0;
-    time_t lastAdjust = 0;
-    time_t now;
+    double lastAdjust = 0;
 
 public:
     comSavageCub(int xPos, int yPos, int size);
@@ -3,6 +3,9 @@
 #include <math.h>
 #include "xpdrSavageCub.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(xpdrSavageCub, "XPDR Savage Cub", 25, 350, 50, 300);
 
 xpdrSavageCub::xpdrSavageCub(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -41,10 +44,8 @@ void xpdrSavageCub::resize()
     addBitmap(bmp);
 
     // 3 = Digits
-    bmp = al_create_bitmap(320, 50);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 0, 400, 320, 50, 0, 0, 0);
-    addBitmap(bmp);
+    digits.setDigits(0, 400, 32, 50, 32);
+    addBitmap(digits.createAtlas(orig, scaleFactor, scaleFactor));
 
     al_set_target_backbuffer(globals.display);
 }
@@ -65,14 +66,14 @@ void xpdrSavageCub::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add squawk
     addSquawk(simVars->transponderCode, 198, 120);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.avionics) {
         dimInstrument();
@@ -84,22 +85,8 @@ void xpdrSavageCub::render()
 /// </summary>
 void xpdrSavageCub::addSquawk(int code, int x, int y)
 {
-    // Transponder code is in BCO16
-    int digit1 = code / 4096;
-    code -= digit1 * 4096;
-    int digit2 = code / 256;
-    code -= digit2 * 256;
-    int digit3 = code / 16;
-    int digit4 = code - digit3 * 16;
-
-    int yPos = y * scaleFactor;
-    int width = 32 * scaleFactor;
-    int height = 50 * scaleFactor;
-
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit1, 0, 32, 50, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit2, 0, 32, 50, (x + 32) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit3, 0, 32, 50, (x + 64) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[3], 32 * digit4, 0, 32, 50, (x + 96) * scaleFactor, yPos, width, height, 0);
+    // Transponder code is in BCO16 so each hex digit is one octal digit
+    digits.draw(x, y, "%04x", code & 0xffff);
 }
 
 /// <summary>
@@ -158,12 +145,11 @@ void xpdrSavageCub::updateKnobs()
             globals.simVars->write(KEY_XPNDR_SET, newVal);
             prevAdjustVal = val;
         }
-        time(&lastAdjust);
+        lastAdjust = globals.frameTime;
     }
     else if (lastAdjust != 0) {
         // Reset digit set selection if more than 5 seconds since last adjustment
-        time(&now);
-        if (now - lastAdjust > 5) {
+        if (globals.frameTime - lastAdjust > 5) {
             adjustSetSel = 0;
             lastAdjust = 0;
         }
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <math.h>
 #include "asiSpitfire.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(asiSpitfire, "ASI Spitfire", "ASI", 0, 0, 0, 0);
 
 asiSpitfire::asiSpitfire(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -71,14 +74,14 @@ void asiSpitfire::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 25, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 25, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <math.h>
 #include "rpmSpitfire.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(rpmSpitfire, "RPM Spitfire", "RPM", 0, 0, 0, 0);
 
 rpmSpitfire::rpmSpitfire(int xPos, int yPos, int size, const char* parentName) : instrument(xPos, yPos, size)
 {
@@ -71,14 +74,14 @@ void rpmSpitfire::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <math.h>
 #include "vsiSpitfire.h"
+#include "instrumentFactory.h"
+
+REGISTER_VARIANT(vsiSpitfire, "VSI Spitfire", "VSI", 0, 0, 0, 0);
 
 vsiSpitfire::vsiSpitfire(int xPos, int yPos, int size, const char *parentName) : instrument(xPos, yPos, size)
 {
@@ -71,14 +74,14 @@ void vsiSpitfire::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, (angle - 90) * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, (angle - 90) * DegreesToRadians, 0);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -115,29 +118,7 @@ void vsiSpitfire::update()
         targetAngle = -targetAngle;
     }
 
-    double diff = abs(targetAngle - angle);
-
-    if (diff > 40.0) {
-        if (angle < targetAngle) angle += 20.0; else angle -= 20.0;
-    }
-    else if (diff > 20.0) {
-        if (angle < targetAngle) angle += 10.0; else angle -= 10.0;
-    }
-    else if (diff > 10.0) {
-        if (angle < targetAngle) angle += 5.0; else angle -= 5.0;
-    }
-    else if (diff > 5.0) {
-        if (angle < targetAngle) angle += 2.5; else angle -= 2.5;
-    }
-    else if (diff > 2.5) {
-        if (angle < targetAngle) angle += 1.25; else angle -= 1.25;
-    }
-    else if (diff > 0.625) {
-        if (angle < targetAngle) angle += 0.625; else angle -= 0.625;
-    }
-    else {
-        angle = targetAngle;
-    }
+    needleSmooth.update(angle, targetAngle);
 }
 
 /// <summary>
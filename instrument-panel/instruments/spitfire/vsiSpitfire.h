@@ -3,6 +3,7 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class vsiSpitfire : public instrument
 {
@@ -14,6 +15,7 @@ private:
     double vertSpeed;
     double angle = 0;
     double targetAngle;
+    smoother needleSmooth{ 0.15, 600, 0.625 };
 
 public:
     vsiSpitfire(int xPos, int yPos, int size, const char *parentName = NULL);
@@ -2,9 +2,13 @@
 #include <stdlib.h>
 #include "tc.h"
 #include "simvars.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(tc, "TC", 5, 300, 400, 300);
 
 tc::tc(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
+    secondary = true;
     setName("TC");
     addVars();
     simVars = &globals.simVars->simVars;
@@ -82,31 +86,31 @@ void tc::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add ball at offscreen centre 400, -550 (-651 orig)
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 1100, 74, 400 * scaleFactor, -452 * scaleFactor, scaleFactor, scaleFactor, ballAngle * AngleFactor, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[5], 1100, 74, 400 * scaleFactor, -452 * scaleFactor, scaleFactor, scaleFactor, ballAngle * AngleFactor, 0);
 
     // Add outer case
-    al_draw_bitmap(bitmaps[6], 0, 494 * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[6], 0, 494 * scaleFactor);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add plane shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 150, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 400, 150, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add plane
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 150, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 150, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
 
         // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -143,26 +147,7 @@ void tc::update()
     // Need to turn ball by -90 degrees = -64
     targetAngle = (-simVars->tcBall * 9) - 64.0;
 
-    double diff = abs(targetAngle - ballAngle);
-
-    if (diff > 20.0) {
-        if (ballAngle < targetAngle) ballAngle += 4.0; else ballAngle -= 4.0;
-    }
-    else if (diff > 10.0) {
-        if (ballAngle < targetAngle) ballAngle += 2.0; else ballAngle -= 2.0;
-    }
-    else if (diff > 5.0) {
-        if (ballAngle < targetAngle) ballAngle += 1.0; else ballAngle -= 1.0;
-    }
-    else if (diff > 2.5) {
-        if (ballAngle < targetAngle) ballAngle += 0.5; else ballAngle -= 0.5;
-    }
-    else if (diff > 0.25) {
-        if (ballAngle < targetAngle) ballAngle += 0.25; else ballAngle -= 0.25;
-    }
-    else {
-        ballAngle = targetAngle;
-    }
+    ballSmooth.update(ballAngle, targetAngle);
 
     // Hard stop at edge
     if (ballAngle < -73.5) {
@@ -3,6 +3,7 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class tc : public instrument
 {
@@ -14,6 +15,7 @@ private:
     double planeAngle = 0;
     double ballAngle = -64;      // Need to turn -90 degrees
     double targetAngle;
+    smoother ballSmooth{ 0.2, 120, 0.25 };
 
 public:
     tc(int xPos, int yPos, int size);
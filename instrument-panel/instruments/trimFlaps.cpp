@@ -1,13 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "trimFlaps.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(trimFlaps, "Trim Flaps", 9, 700, 750, 300);
 
 trimFlaps::trimFlaps(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Trim Flaps");
     addVars();
     simVars = &globals.simVars->simVars;
+    alerts = &globals.simVars->alerts;
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -151,84 +156,84 @@ void trimFlaps::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main panel
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (gearUpWarning > 0 && gearUpWarning % 10 < 5) {
+    if (alerts->isShowing(ALERT_GEAR_UP)) {
         // Add warning flash
-        al_draw_bitmap(bitmaps[14], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[14], 0, 0);
     }
 
     // Add trim
-    al_draw_bitmap(bitmaps[3], 262 * scaleFactor, (301 + trimOffset) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[3], 262 * scaleFactor, (301 + trimOffset) * scaleFactor);
 
     // Add rudder trim
-    al_draw_bitmap(bitmaps[15], (270 + rudderTrimOffset) * scaleFactor, 481 * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[15], (270 + rudderTrimOffset) * scaleFactor, 481 * scaleFactor);
 
     // Add flaps target
-    al_draw_bitmap(bitmaps[5], 501 * scaleFactor, (161 + targetFlaps) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[5], 501 * scaleFactor, (161 + targetFlaps) * scaleFactor);
 
     // Add flaps
-    al_draw_bitmap(bitmaps[4], 501 * scaleFactor, (161 + flapsOffset) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[4], 501 * scaleFactor, (161 + flapsOffset) * scaleFactor);
 
     if (simVars->gearRetractable) {
         // Add landing gear
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 198, 44, 227 * scaleFactor, 535 * scaleFactor, 198 * scaleFactor, 44 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[6], 0, 0, 198, 44, 227 * scaleFactor, 535 * scaleFactor, 198 * scaleFactor, 44 * scaleFactor, 0);
 
         if (simVars->gearLeftPos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 223 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 223 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearLeftPos > 0) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 214 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 214 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
 
         if (simVars->gearCentrePos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 358 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 358 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearCentrePos > 0) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 350 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 350 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
 
         if (simVars->gearRightPos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 493 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 493 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearRightPos > 0) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 486 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 486 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
     }
 
     if (simVars->parkingBrakeOn) {
         // Add parking brake
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 252, 33, 277 * scaleFactor, 703 * scaleFactor, 252 * scaleFactor, 33 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[9], 0, 0, 252, 33, 277 * scaleFactor, 703 * scaleFactor, 252 * scaleFactor, 33 * scaleFactor, 0);
     }
     else if (simVars->brakeLeftPedal > 5 || simVars->brakeRightPedal > 5) {
         // Add brake
-        al_draw_scaled_bitmap(bitmaps[16], 0, 0, 130, 33, 340 * scaleFactor, 703 * scaleFactor, 130 * scaleFactor, 33 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[16], 0, 0, 130, 33, 340 * scaleFactor, 703 * scaleFactor, 130 * scaleFactor, 33 * scaleFactor, 0);
     }
     else if (simVars->pushbackState < 3) {
         // Add pushback
-        al_draw_scaled_bitmap(bitmaps[13], 0, 0, 192, 33, 307 * scaleFactor, 703 * scaleFactor, 192 * scaleFactor, 33 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[13], 0, 0, 192, 33, 307 * scaleFactor, 703 * scaleFactor, 192 * scaleFactor, 33 * scaleFactor, 0);
     }
     else if (simVars->tfAutoBrake > 1) {
         // Add auto brake
-        al_draw_scaled_bitmap(bitmaps[10], 0, 0, 198, 30, 289 * scaleFactor, 705 * scaleFactor, 198 * scaleFactor, 30 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 0, 0, 198, 30, 289 * scaleFactor, 705 * scaleFactor, 198 * scaleFactor, 30 * scaleFactor, 0);
 
         // Add auto brake setting
-        al_draw_scaled_bitmap(bitmaps[11], 33 * (simVars->tfAutoBrake - 2), 0, 33, 30, 487 * scaleFactor, 705 * scaleFactor, 33 * scaleFactor, 30 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[11], 33 * (simVars->tfAutoBrake - 2), 0, 33, 30, 487 * scaleFactor, 705 * scaleFactor, 33 * scaleFactor, 30 * scaleFactor, 0);
     }
 
     if (simVars->tfSpoilersPosition > 0) {
         // Add spoilers
-        al_draw_scaled_bitmap(bitmaps[12], 0, 0, 28, 260, 412 * scaleFactor, 221 * scaleFactor, 28 * scaleFactor, 260 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[12], 0, 0, 28, 260, 412 * scaleFactor, 221 * scaleFactor, 28 * scaleFactor, 260 * scaleFactor, 0);
     }
 
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -245,7 +250,7 @@ void trimFlaps::update()
     bool aircraftChanged = (loadedAircraft != globals.aircraft);
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
-        fastAircraft = (loadedAircraft != NO_AIRCRAFT && simVars->cruiseSpeed >= globals.FastAircraftSpeed);
+        fastAircraft = globals.aircraftTraits->isFast(simVars->cruiseSpeed);
         requestedTugHeading = simVars->hiHeadingTrue;
     }
 
@@ -284,17 +289,7 @@ void trimFlaps::update()
     else {
         targetFlaps = 345.0 * simVars->tfFlapsIndex / simVars->tfFlapsCount;
     }
-    double diff = abs(targetFlaps - flapsOffset);
-
-    if (diff > 5.0) {
-        if (flapsOffset < targetFlaps) flapsOffset += 2.5; else flapsOffset -= 2.5;
-    }
-    else if (diff > 1.25) {
-        if (flapsOffset < targetFlaps) flapsOffset += 1.25; else flapsOffset -= 1.25;
-    }
-    else {
-        flapsOffset = targetFlaps;
-    }
+    flapsSmooth.update(flapsOffset, targetFlaps);
 
     // If pushing back use rudder to steer
     if (simVars->pushbackState < 3) {
@@ -320,26 +315,6 @@ void trimFlaps::update()
             }
         }
     }
-
-    // Warn if low altitude and flaps down but gear is up
-    if (simVars->tfFlapsIndex > 0 && simVars->altAboveGround < 400 && simVars->altAboveGround > 30 && simVars->gearRetractable
-        && simVars->gearLeftPos < 20 && simVars->vsiVerticalSpeed < 0)
-    {
-        if (simVars->altAboveGround > 300) {
-            // Warning 1
-            gearUpWarning++;
-        }
-        else if (simVars->altAboveGround < 100) {
-            // Warning 2
-            gearUpWarning++;
-        }
-        else {
-            gearUpWarning = 0;
-        }
-    }
-    else {
-        gearUpWarning = 0;
-    }
 }
 
 void trimFlaps::writeTugHeading(double heading)
@@ -3,11 +3,13 @@
 
 #include "simvars.h"
 #include "instrument.h"
+#include "smoother.h"
 
 class trimFlaps : public instrument
 {
 private:
     SimVars* simVars;
+    alertEngine* alerts;
     Aircraft loadedAircraft = UNDEFINED;
     bool fastAircraft = false;
     float scaleFactor;
@@ -16,9 +18,9 @@ private:
     // Instrument values (calculated from variables and needed to draw the instrument)
     float trimOffset;
     float rudderTrimOffset;
-    float flapsOffset = 0;
-    float targetFlaps;
-    int gearUpWarning = 0;
+    double flapsOffset = 0;
+    double targetFlaps;
+    smoother flapsSmooth{ 0, 75, 1.25 };
     double requestedTugHeading = -1;
 
     // Hardware knobs
@@ -1,12 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "trimFlaps2.h"
+#include "aircraftRegistry.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(trimFlaps2, "Trim Flaps 2", 14, 50, 250, 200);
 
 trimFlaps2::trimFlaps2(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Trim Flaps 2");
     addVars();
     simVars = &globals.simVars->simVars;
+    alerts = &globals.simVars->alerts;
 
     resize();
 }
@@ -149,90 +154,90 @@ void trimFlaps2::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main panel
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (gearUpWarning > 0 && gearUpWarning % 10 < 5) {
+    if (alerts->isShowing(ALERT_GEAR_UP)) {
         // Add warning flash
-        al_draw_bitmap(bitmaps[11], 0, 0, 0);
+        softBlend::drawBitmap(bitmaps[11], 0, 0);
     }
 
     // Add trim
-    al_draw_bitmap(bitmaps[14], 48 * scaleFactor, (285 + trimOffset) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[14], 48 * scaleFactor, (285 + trimOffset) * scaleFactor);
 
     // Add rudder trim
-    al_draw_bitmap(bitmaps[17], (228 + rudderTrimOffset) * scaleFactor, 75 * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[17], (228 + rudderTrimOffset) * scaleFactor, 75 * scaleFactor);
 
     // Add flaps target
-    al_draw_bitmap(bitmaps[16], 506 * scaleFactor, (146 + targetFlaps) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[16], 506 * scaleFactor, (146 + targetFlaps) * scaleFactor);
 
     // Add flaps
-    al_draw_bitmap(bitmaps[15], 506 * scaleFactor, (146 + flapsOffset) * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[15], 506 * scaleFactor, (146 + flapsOffset) * scaleFactor);
 
     if (simVars->gearRetractable) {
         // Add landing gear
-        al_draw_scaled_bitmap(bitmaps[3], 0, 0, 200, 34, 111 * scaleFactor, 150 * scaleFactor, 200 * scaleFactor, 34 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[3], 0, 0, 200, 34, 111 * scaleFactor, 150 * scaleFactor, 200 * scaleFactor, 34 * scaleFactor, 0);
 
         if (simVars->gearLeftPos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[5], 0, 0, 88, 70, 111 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 88, 70, 111 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearLeftPos > 2) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[4], 0, 0, 104, 37, 102 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[4], 0, 0, 104, 37, 102 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
 
         if (simVars->gearCentrePos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[5], 0, 0, 88, 70, 246 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 88, 70, 246 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearCentrePos > 2) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[4], 0, 0, 104, 37, 237 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[4], 0, 0, 104, 37, 237 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
 
         if (simVars->gearRightPos > 99.99) {
             // Add gear down
-            al_draw_scaled_bitmap(bitmaps[5], 0, 0, 88, 70, 381 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[5], 0, 0, 88, 70, 381 * scaleFactor, 205 * scaleFactor, 88 * scaleFactor, 70 * scaleFactor, 0);
         }
         else if (simVars->gearRightPos > 2) {
             // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[4], 0, 0, 104, 37, 372 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            softBlend::drawScaledBitmap(bitmaps[4], 0, 0, 104, 37, 372 * scaleFactor, 217 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
         }
     }
 
     if (simVars->parkingBrakeOn) {
         // Add parking brake
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 252, 31, 164 * scaleFactor, 318 * scaleFactor, 252 * scaleFactor, 31 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[6], 0, 0, 252, 31, 164 * scaleFactor, 318 * scaleFactor, 252 * scaleFactor, 31 * scaleFactor, 0);
     }
     else if (simVars->brakeLeftPedal > 5 || simVars->brakeRightPedal > 5) {
         // Add brake
-        al_draw_scaled_bitmap(bitmaps[12], 0, 0, 131, 31, 225 * scaleFactor, 318 * scaleFactor, 131 * scaleFactor, 31 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[12], 0, 0, 131, 31, 225 * scaleFactor, 318 * scaleFactor, 131 * scaleFactor, 31 * scaleFactor, 0);
     }
 
     if (simVars->pushbackState < 3) {
         // Add pushback
-        al_draw_scaled_bitmap(bitmaps[10], 0, 0, 185, 27, 194 * scaleFactor, 384 * scaleFactor, 185 * scaleFactor, 27 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[10], 0, 0, 185, 27, 194 * scaleFactor, 384 * scaleFactor, 185 * scaleFactor, 27 * scaleFactor, 0);
     }
     else if (simVars->tfAutoBrake > 1) {
         // Add auto brake
-        al_draw_scaled_bitmap(bitmaps[7], 0, 0, 198, 31, 175 * scaleFactor, 384 * scaleFactor, 198 * scaleFactor, 31 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[7], 0, 0, 198, 31, 175 * scaleFactor, 384 * scaleFactor, 198 * scaleFactor, 31 * scaleFactor, 0);
 
         // Add auto brake setting
-        al_draw_scaled_bitmap(bitmaps[8], 33 * (simVars->tfAutoBrake - 2), 0, 33, 31, 373 * scaleFactor, 384 * scaleFactor, 33 * scaleFactor, 31 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[8], 33 * (simVars->tfAutoBrake - 2), 0, 33, 31, 373 * scaleFactor, 384 * scaleFactor, 33 * scaleFactor, 31 * scaleFactor, 0);
     }
 
     if (simVars->tfSpoilersPosition > 0) {
         // Add spoilers
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 25, 253, 555 * scaleFactor, 204 * scaleFactor, 25 * scaleFactor, 253 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[9], 0, 0, 25, 253, 555 * scaleFactor, 204 * scaleFactor, 25 * scaleFactor, 253 * scaleFactor, 0);
     }
 
     if (globals.electrics && simVars->seatBeltsSwitch > 0) {
         // Add seatbelts on
-        al_draw_scaled_bitmap(bitmaps[13], 0, 0, 384, 76, 97 * scaleFactor, 460 * scaleFactor, 384 * scaleFactor, 76 * scaleFactor, 0);
+        softBlend::drawScaledBitmap(bitmaps[13], 0, 0, 384, 76, 97 * scaleFactor, 460 * scaleFactor, 384 * scaleFactor, 76 * scaleFactor, 0);
     }
 
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -249,7 +254,7 @@ void trimFlaps2::update()
     bool aircraftChanged = (loadedAircraft != globals.aircraft);
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
-        fastAircraft = (loadedAircraft != NO_AIRCRAFT && simVars->cruiseSpeed >= globals.FastAircraftSpeed);
+        fastAircraft = globals.aircraftTraits->isFast(simVars->cruiseSpeed);
         requestedTugHeading = simVars->hiHeadingTrue;
     }
 
@@ -281,17 +286,7 @@ void trimFlaps2::update()
     else {
         targetFlaps = 345.0 * simVars->tfFlapsIndex / simVars->tfFlapsCount;
     }
-    double diff = abs(targetFlaps - flapsOffset);
-
-    if (diff > 5.0) {
-        if (flapsOffset < targetFlaps) flapsOffset += 2.5; else flapsOffset -= 2.5;
-    }
-    else if (diff > 1.25) {
-        if (flapsOffset < targetFlaps) flapsOffset += 1.25; else flapsOffset -= 1.25;
-    }
-    else {
-        flapsOffset = targetFlaps;
-    }
+    flapsSmooth.update(flapsOffset, targetFlaps);
 
     // If pushing back use rudder to steer
     if (simVars->pushbackState < 3) {
@@ -317,26 +312,6 @@ void trimFlaps2::update()
             }
         }
     }
-
-    // Warn if low altitude and flaps down but gear is up
-    if (simVars->tfFlapsIndex > 0 && simVars->altAboveGround < 400 && simVars->altAboveGround > 30 && simVars->gearRetractable
-        && simVars->gearLeftPos < 20 && simVars->vsiVerticalSpeed < 0)
-    {
-        if (simVars->altAboveGround > 300) {
-            // Warning 1
-            gearUpWarning++;
-        }
-        else if (simVars->altAboveGround < 100) {
-            // Warning 2
-            gearUpWarning++;
-        }
-        else {
-            gearUpWarning = 0;
-        }
-    }
-    else {
-        gearUpWarning = 0;
-    }
 }
 
 void trimFlaps2::writeTugHeading(double heading)
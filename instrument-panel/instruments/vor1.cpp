@@ -2,9 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include "vor1.h"
-#include "spitfire/boostSpitfire.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(vor1, "VOR1", 4, 1500, 50, 300);
 
 vor1::vor1(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -128,45 +131,45 @@ void vor1::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add back
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add glide slope on
     if (glideSlopeOn == 1) {
-        al_draw_bitmap(bitmaps[4], 490 * scaleFactor, 335 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[4], 490 * scaleFactor, 335 * scaleFactor);
     }
 
     // GPS drives NAV
     if (gpsControlsNavOn == 1) {
         // Add GPS flag over barber pole 
-        al_draw_bitmap(bitmaps[11], 350 * scaleFactor, 549 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[11], 350 * scaleFactor, 549 * scaleFactor);
     } 
     else {
         // Add to/from on
         if (toFromOn == 1) {
-            al_draw_bitmap(bitmaps[6], 350 * scaleFactor, 549 * scaleFactor, 0);
+            softBlend::drawBitmap(bitmaps[6], 350 * scaleFactor, 549 * scaleFactor);
         }
         else if (toFromOn == 2) {
-            al_draw_bitmap(bitmaps[5], 350 * scaleFactor, 549 * scaleFactor, 0);
+            softBlend::drawBitmap(bitmaps[5], 350 * scaleFactor, 549 * scaleFactor);
         }
     }
     // Add locator needle
-    al_draw_scaled_rotated_bitmap(bitmaps[7], 15, 140, 400 * scaleFactor, 140 * scaleFactor, scaleFactor, scaleFactor, locAngle, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[7], 15, 140, 400 * scaleFactor, 140 * scaleFactor, scaleFactor, scaleFactor, locAngle, 0);
 
     // Add glide slope needle
-    al_draw_scaled_rotated_bitmap(bitmaps[8], 140, 15, 140 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, slopeAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[8], 140, 15, 140 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, slopeAngle * DegreesToRadians, 0);
 
     // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
     // Add top guide
-    al_draw_bitmap(bitmaps[9], 365 * scaleFactor, 0, 0);
+    softBlend::drawBitmap(bitmaps[9], 365 * scaleFactor, 0);
 
     // Add bottom guide
-    al_draw_bitmap(bitmaps[10], 365 * scaleFactor, 620 * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[10], 365 * scaleFactor, 620 * scaleFactor);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -184,15 +187,8 @@ void vor1::update()
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (loadedAircraft == SUPERMARINE_SPITFIRE) {
-            customInstrument = new boostSpitfire(xPos, yPos, size, name);
-        }
+        // Use custom instrument for this aircraft if we have one
+        useVariant(globals.aircraftTraits->variant("VOR1"));
 
         prevVal = simVars->sbEncoder[1];
     }
@@ -358,11 +354,10 @@ void vor1::updateKnobs()
         else {
             prevVal = val;
         }
-        time(&lastObsAdjust);
+        lastObsAdjust = globals.frameTime;
     }
     else if (lastObsAdjust != 0) {
-        time(&now);
-        if (now - lastObsAdjust > 1) {
+        if (globals.frameTime - lastObsAdjust > 1) {
             lastObsAdjust = 0;
         }
     }
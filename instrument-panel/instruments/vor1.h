@@ -25,8 +25,7 @@ private:
     int prevVal = 0;
     int prevValSb = 0;
     double vor1Obs;
-    time_t lastObsAdjust = 0;
-    time_t now;
+    double lastObsAdjust = 0;
 
 public:
     vor1(int xPos, int yPos, int size);
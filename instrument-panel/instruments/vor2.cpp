@@ -3,6 +3,9 @@
 #include "vor2.h"
 #include "simvars.h"
 #include "knobs.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(vor2, "VOR2", 8, 1500, 400, 300);
 
 vor2::vor2(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
@@ -108,31 +111,31 @@ void vor2::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add back
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
     // Add to/from on
     if (toFromOn == 1) {
-        al_draw_bitmap(bitmaps[5], 478 * scaleFactor, 379 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[5], 478 * scaleFactor, 379 * scaleFactor);
     }
     else if (toFromOn == 2) {
-        al_draw_bitmap(bitmaps[4], 478 * scaleFactor, 379 * scaleFactor, 0);
+        softBlend::drawBitmap(bitmaps[4], 478 * scaleFactor, 379 * scaleFactor);
     }
 
     // Add locator needle
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 15, 125, 400 * scaleFactor, 125 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[6], 15, 125, 400 * scaleFactor, 125 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
 
     // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+    softBlend::drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
     // Add top guide
-    al_draw_bitmap(bitmaps[7], 365 * scaleFactor, 0, 0);
+    softBlend::drawBitmap(bitmaps[7], 365 * scaleFactor, 0);
 
     // Add bottom guide
-    al_draw_bitmap(bitmaps[8], 365 * scaleFactor, 620 * scaleFactor, 0);
+    softBlend::drawBitmap(bitmaps[8], 365 * scaleFactor, 620 * scaleFactor);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -149,18 +152,6 @@ void vor2::update()
     bool aircraftChanged = (loadedAircraft != globals.aircraft);
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
-
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (loadedAircraft == F15_EAGLE || loadedAircraft == F18_HORNET || loadedAircraft == HAWKER_HUNTER) {
-            // Moved to ADF
-            //customInstrument = new gForce(xPos, yPos, size, name);
-        }
-
         prevVal = simVars->sbEncoder[0];
     }
 
@@ -283,11 +274,10 @@ void vor2::updateKnobs()
         else {
             prevVal = val;
         }
-        time(&lastObsAdjust);
+        lastObsAdjust = globals.frameTime;
     }
     else if (lastObsAdjust != 0) {
-        time(&now);
-        if (now - lastObsAdjust > 1) {
+        if (globals.frameTime - lastObsAdjust > 1) {
             lastObsAdjust = 0;
         }
     }
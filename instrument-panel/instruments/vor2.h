@@ -21,8 +21,7 @@ private:
     int prevVal = 0;
     int prevValSb = 0;
     double vor2Obs;
-    time_t lastObsAdjust = 0;
-    time_t now;
+    double lastObsAdjust = 0;
 
 public:
     vor2(int xPos, int yPos, int size);
@@ -2,15 +2,24 @@
 #include <stdlib.h>
 #include <math.h>
 #include "vsi.h"
-#include "spitfire/vsiSpitfire.h"
-#include "alternate/vsiExtreme.h"
 #include "simvars.h"
+#include "aircraftRegistry.h"
+#include "calibrationTables.h"
+#include "instrumentFactory.h"
+
+REGISTER_INSTRUMENT(vsi, "VSI", 7, 1100, 400, 300);
 
 vsi::vsi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("VSI");
     addVars();
     simVars = &globals.simVars->simVars;
+
+    int steps = globals.simVars->getRotationSteps(name);
+    if (steps > 0) {
+        pointerCache.setSteps(steps);
+    }
+
     resize();
 }
 
@@ -78,25 +87,25 @@ void vsi::render()
     al_set_target_bitmap(bitmaps[1]);
 
     // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    softBlend::drawBitmap(bitmaps[2], 0, 0);
 
-    if (globals.enableShadows) {
+    if (showShadows()) {
         // Set blender to multiply (shades of grey darken, white has no effect)
         al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
 
         // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400,50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+        softBlend::drawScaledRotatedBitmap(bitmaps[4], 400,50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
         // Restore normal blender
         al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
     }
 
     // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+    pointerCache.draw(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians);
 
     // Position dest bitmap on screen
     al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+    softBlend::drawBitmap(bitmaps[1], xPos, yPos);
 
     if (!globals.electrics) {
         dimInstrument();
@@ -114,18 +123,8 @@ void vsi::update()
     if (aircraftChanged) {
         loadedAircraft = globals.aircraft;
 
-        // Load custom instrument for this aircraft if we have one
-        if (customInstrument) {
-            delete customInstrument;
-            customInstrument = NULL;
-        }
-
-        if (loadedAircraft == SUPERMARINE_SPITFIRE) {
-            customInstrument = new vsiSpitfire(xPos, yPos, size, name);
-        }
-        else if (loadedAircraft == F15_EAGLE || loadedAircraft == ORNITHOPTER) {
-            customInstrument = new vsiExtreme(xPos, yPos, size, name);
-        }
+        // Use custom instrument for this aircraft if we have one
+        useVariant(globals.aircraftTraits->variant("VSI"));
     }
 
     if (customInstrument) {
@@ -148,44 +147,13 @@ void vsi::update()
     vertSpeed = abs(simVars->vsiVerticalSpeed * 0.6);
 
     // Different scale after 10
-    if (vertSpeed > 10) {
-        targetAngle = 79.5 + (96.0 * (vertSpeed - 10.0)) / 20.0;
-
-        if (targetAngle > 175.5) {
-            targetAngle = 175.5;
-        }
-    }
-    else {
-        targetAngle = (79.5 * vertSpeed) / 10.0;
-    }
+    targetAngle = vsiVertSpeedScale.lookup(vertSpeed);
 
     if (simVars->vsiVerticalSpeed < 0) {
         targetAngle = -targetAngle;
     }
 
-    double diff = abs(targetAngle - angle);
-
-    if (diff > 40.0) {
-        if (angle < targetAngle) angle += 20.0; else angle -= 20.0;
-    }
-    else if (diff > 20.0) {
-        if (angle < targetAngle) angle += 10.0; else angle -= 10.0;
-    }
-    else if (diff > 10.0) {
-        if (angle < targetAngle) angle += 5.0; else angle -= 5.0;
-    }
-    else if (diff > 5.0) {
-        if (angle < targetAngle) angle += 2.5; else angle -= 2.5;
-    }
-    else if (diff > 2.5) {
-        if (angle < targetAngle) angle += 1.25; else angle -= 1.25;
-    }
-    else if (diff > 0.625) {
-        if (angle < targetAngle) angle += 0.625; else angle -= 0.625;
-    }
-    else {
-        angle = targetAngle;
-    }
+    needleSmooth.update(angle, targetAngle);
 }
 
 /// <summary>
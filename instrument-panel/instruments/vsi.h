@@ -3,6 +3,8 @@
 
 #include "simvarDefs.h"
 #include "instrument.h"
+#include "smoother.h"
+#include "rotationCache.h"
 
 class vsi : public instrument
 {
@@ -15,6 +17,10 @@ private:
     double vertSpeed;
     double angle = 0;
     double targetAngle;
+    smoother needleSmooth{ 0.15, 600, 0.625 };
+
+    // Pre-rotated pointer (0.25 degree steps)
+    rotationCache pointerCache{ 1440 };
 
 public:
     vsi(int xPos, int yPos, int size);
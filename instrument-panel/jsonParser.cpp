@@ -0,0 +1,422 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jsonParser.h"
+
+/// <summary>
+/// Parse the named JSON file
+/// </summary>
+bool jsonParser::parse(const char* filename, jsonHandler* handler)
+{
+    FILE* infile = fopen(filename, "r");
+    if (!infile) {
+        line = 0;
+        column = 0;
+        snprintf(error, sizeof(error), "File %s not found", filename);
+        return false;
+    }
+
+    bool success = parse(infile, handler);
+    fclose(infile);
+    return success;
+}
+
+/// <summary>
+/// Parse an open JSON file, passing each object, array and value
+/// to the handler as soon as it is read. Returns false and sets
+/// error, line and column if the file is not valid JSON.
+/// An empty file is valid and produces no callbacks.
+/// </summary>
+bool jsonParser::parse(FILE* infile, jsonHandler* handler)
+{
+    this->infile = infile;
+    bufLen = 0;
+    bufPos = 0;
+    pushedBack = false;
+    line = 1;
+    column = 0;
+    error[0] = '\0';
+    stack.clear();
+
+    // Skip UTF-8 byte order mark (added by some Windows editors)
+    int ch = nextChar();
+    if (ch == 0xef) {
+        if (nextChar() != 0xbb || nextChar() != 0xbf) {
+            return fail("Invalid byte order mark");
+        }
+        column = 0;
+    }
+    else {
+        pushBack();
+    }
+
+    if (skipSpace() == EOF) {
+        return true;
+    }
+    pushBack();
+
+    bool needValue = true;
+    while (true) {
+        if (!needValue) {
+            ch = skipSpace();
+            if (stack.empty()) {
+                if (ch != EOF) {
+                    return fail("Unexpected data after end of JSON");
+                }
+                return true;
+            }
+
+            Container* top = &stack.back();
+            if (ch == ',') {
+                top->count++;
+                needValue = true;
+            }
+            else if (ch == (top->isArray ? ']' : '}')) {
+                closeContainer(handler);
+            }
+            else if (top->isArray) {
+                return fail("Expected ',' or ']'");
+            }
+            else {
+                return fail("Expected ',' or '}'");
+            }
+            continue;
+        }
+
+        ch = skipSpace();
+        key.clear();
+
+        if (!stack.empty()) {
+            Container* top = &stack.back();
+            if (ch == (top->isArray ? ']' : '}') && top->count == 0) {
+                // Empty object or array
+                closeContainer(handler);
+                needValue = false;
+                continue;
+            }
+
+            if (!top->isArray) {
+                if (ch != '"') {
+                    return fail("Expected name in double quotes");
+                }
+                if (!readString(key)) {
+                    return false;
+                }
+                if (skipSpace() != ':') {
+                    return fail("Expected ':' after name");
+                }
+                ch = skipSpace();
+            }
+        }
+
+        int level = (int)stack.size();
+        if (ch == '{' || ch == '[') {
+            Container container;
+            container.isArray = (ch == '[');
+            container.count = 0;
+            container.key = key;
+            stack.push_back(container);
+
+            if (container.isArray) {
+                handler->startArray(level, key.c_str());
+            }
+            else {
+                handler->startObject(level, key.c_str());
+            }
+            continue;
+        }
+
+        JsonType type;
+        if (ch == '"') {
+            if (!readString(token)) {
+                return false;
+            }
+            type = JSON_STRING;
+        }
+        else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+            if (!readNumber(ch, token)) {
+                return false;
+            }
+            type = JSON_NUMBER;
+        }
+        else if (ch == EOF) {
+            return fail("Unexpected end of file");
+        }
+        else if (!readLiteral(ch, token, &type)) {
+            return false;
+        }
+
+        handler->value(level, key.c_str(), token.c_str(), type);
+        needValue = false;
+    }
+}
+
+/// <summary>
+/// Returns the next character from the file, reading a new chunk
+/// when the buffer is exhausted.
+/// </summary>
+int jsonParser::nextChar()
+{
+    if (pushedBack) {
+        pushedBack = false;
+        return lastCh;
+    }
+
+    if (bufPos == bufLen) {
+        bufLen = (int)fread(buf, 1, sizeof(buf), infile);
+        bufPos = 0;
+        if (bufLen <= 0) {
+            bufLen = 0;
+            lastCh = EOF;
+            return EOF;
+        }
+    }
+
+    lastCh = (unsigned char)buf[bufPos++];
+    if (lastCh == '\n') {
+        line++;
+        column = 0;
+    }
+    else {
+        column++;
+    }
+
+    return lastCh;
+}
+
+/// <summary>
+/// The next call to nextChar will return the last character again
+/// </summary>
+void jsonParser::pushBack()
+{
+    pushedBack = true;
+}
+
+int jsonParser::skipSpace()
+{
+    int ch;
+    do {
+        ch = nextChar();
+    } while (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n');
+
+    return ch;
+}
+
+/// <summary>
+/// Reads a string (opening quote already read) and decodes any escapes
+/// </summary>
+bool jsonParser::readString(std::string& str)
+{
+    str.clear();
+
+    while (true) {
+        int ch = nextChar();
+        if (ch == '"') {
+            return true;
+        }
+
+        if (ch == EOF || ch == '\n') {
+            return fail("Missing closing quote");
+        }
+
+        if (ch < 0x20) {
+            return fail("Control character in string (use an escape such as \\t)");
+        }
+
+        if (ch != '\\') {
+            str += (char)ch;
+            continue;
+        }
+
+        ch = nextChar();
+        switch (ch) {
+        case '"': str += '"'; break;
+        case '\\': str += '\\'; break;
+        case '/': str += '/'; break;
+        case 'b': str += '\b'; break;
+        case 'f': str += '\f'; break;
+        case 'n': str += '\n'; break;
+        case 'r': str += '\r'; break;
+        case 't': str += '\t'; break;
+        case 'u':
+        {
+            unsigned int code;
+            if (!readHex(&code)) {
+                return false;
+            }
+
+            if (code >= 0xdc00 && code <= 0xdfff) {
+                return fail("Unpaired surrogate in \\u escape");
+            }
+
+            if (code >= 0xd800 && code <= 0xdbff) {
+                // Characters above U+FFFF are a high surrogate followed by a low one
+                unsigned int low;
+                if (nextChar() != '\\' || nextChar() != 'u') {
+                    return fail("Unpaired surrogate in \\u escape");
+                }
+                if (!readHex(&low)) {
+                    return false;
+                }
+                if (low < 0xdc00 || low > 0xdfff) {
+                    return fail("Unpaired surrogate in \\u escape");
+                }
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            }
+
+            if (code == 0) {
+                // Values are passed on as C strings so would be cut short
+                return fail("\\u0000 is not allowed in strings");
+            }
+
+            // Encode as UTF-8
+            if (code < 0x80) {
+                str += (char)code;
+            }
+            else if (code < 0x800) {
+                str += (char)(0xc0 | (code >> 6));
+                str += (char)(0x80 | (code & 0x3f));
+            }
+            else if (code < 0x10000) {
+                str += (char)(0xe0 | (code >> 12));
+                str += (char)(0x80 | ((code >> 6) & 0x3f));
+                str += (char)(0x80 | (code & 0x3f));
+            }
+            else {
+                str += (char)(0xf0 | (code >> 18));
+                str += (char)(0x80 | ((code >> 12) & 0x3f));
+                str += (char)(0x80 | ((code >> 6) & 0x3f));
+                str += (char)(0x80 | (code & 0x3f));
+            }
+            break;
+        }
+        default:
+            return fail("Invalid escape character");
+        }
+    }
+}
+
+/// <summary>
+/// Reads the four hex digits of a \u escape
+/// </summary>
+bool jsonParser::readHex(unsigned int* code)
+{
+    *code = 0;
+    for (int i = 0; i < 4; i++) {
+        int ch = nextChar();
+        *code <<= 4;
+        if (ch >= '0' && ch <= '9') *code += ch - '0';
+        else if (ch >= 'a' && ch <= 'f') *code += ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F') *code += ch - 'A' + 10;
+        else return fail("Invalid \\u escape");
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Reads a number, validating it against the JSON number syntax
+/// </summary>
+bool jsonParser::readNumber(int ch, std::string& str)
+{
+    str.clear();
+
+    if (ch == '-') {
+        str += (char)ch;
+        ch = nextChar();
+    }
+
+    if (ch < '0' || ch > '9') {
+        return fail("Invalid number");
+    }
+
+    while (ch >= '0' && ch <= '9') {
+        str += (char)ch;
+        ch = nextChar();
+    }
+
+    if (ch == '.') {
+        str += (char)ch;
+        ch = nextChar();
+        if (ch < '0' || ch > '9') {
+            return fail("Invalid number");
+        }
+        while (ch >= '0' && ch <= '9') {
+            str += (char)ch;
+            ch = nextChar();
+        }
+    }
+
+    if (ch == 'e' || ch == 'E') {
+        str += (char)ch;
+        ch = nextChar();
+        if (ch == '+' || ch == '-') {
+            str += (char)ch;
+            ch = nextChar();
+        }
+        if (ch < '0' || ch > '9') {
+            return fail("Invalid number");
+        }
+        while (ch >= '0' && ch <= '9') {
+            str += (char)ch;
+            ch = nextChar();
+        }
+    }
+
+    // Went one character too far
+    if (ch != EOF) {
+        pushBack();
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Reads one of true, false or null
+/// </summary>
+bool jsonParser::readLiteral(int ch, std::string& str, JsonType* type)
+{
+    str.clear();
+
+    while (ch >= 'a' && ch <= 'z') {
+        str += (char)ch;
+        ch = nextChar();
+    }
+
+    if (ch != EOF) {
+        pushBack();
+    }
+
+    if (str == "true" || str == "false") {
+        *type = JSON_BOOL;
+        return true;
+    }
+
+    if (str == "null") {
+        *type = JSON_NULL;
+        return true;
+    }
+
+    return fail("Invalid value");
+}
+
+void jsonParser::closeContainer(jsonHandler* handler)
+{
+    Container container = stack.back();
+    stack.pop_back();
+
+    int level = (int)stack.size();
+    if (container.isArray) {
+        handler->endArray(level, container.key.c_str());
+    }
+    else {
+        handler->endObject(level, container.key.c_str());
+    }
+}
+
+bool jsonParser::fail(const char* msg)
+{
+    strncpy(error, msg, sizeof(error) - 1);
+    error[sizeof(error) - 1] = '\0';
+    return false;
+}
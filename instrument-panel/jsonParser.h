@@ -0,0 +1,74 @@
+#ifndef _JSONPARSER_H_
+#define _JSONPARSER_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum JsonType {
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_BOOL,
+    JSON_NULL
+};
+
+/// <summary>
+/// Receives the contents of a JSON file as it is parsed.
+/// Level is the nesting depth (1 = inside the outermost object).
+/// Key is the name of the member or "" for array elements.
+/// </summary>
+class jsonHandler
+{
+public:
+    virtual void startObject(int level, const char* key) {}
+    virtual void endObject(int level, const char* key) {}
+    virtual void startArray(int level, const char* key) {}
+    virtual void endArray(int level, const char* key) {}
+    virtual void value(int level, const char* key, const char* value, JsonType type) = 0;
+};
+
+/// <summary>
+/// Single-pass streaming JSON parser. The file is read in small
+/// chunks so there is no limit on file size or nesting depth.
+/// </summary>
+class jsonParser
+{
+private:
+    struct Container
+    {
+        bool isArray;
+        int count;
+        std::string key;
+    };
+
+    FILE* infile = NULL;
+    char buf[4096];
+    int bufLen = 0;
+    int bufPos = 0;
+    int lastCh = 0;
+    bool pushedBack = false;
+    std::vector<Container> stack;
+    std::string key;
+    std::string token;
+
+public:
+    int line = 1;
+    int column = 0;
+    char error[256] = { '\0' };
+
+    bool parse(const char* filename, jsonHandler* handler);
+    bool parse(FILE* infile, jsonHandler* handler);
+
+private:
+    int nextChar();
+    void pushBack();
+    int skipSpace();
+    bool readString(std::string& str);
+    bool readHex(unsigned int* code);
+    bool readNumber(int ch, std::string& str);
+    bool readLiteral(int ch, std::string& str, JsonType* type);
+    void closeContainer(jsonHandler* handler);
+    bool fail(const char* msg);
+};
+
+#endif // _JSONPARSER_H_
@@ -1,4 +1,8 @@
 #ifndef _WIN32
+#include <math.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #ifndef NoKnobs
 #ifdef NoGpiod
 #include <wiringPi.h>
@@ -7,16 +11,60 @@
 #endif
 #endif
 #include "knobs.h"
+#include "simvars.h"
+#include "latency.h"
+
+// Quadrature transitions indexed by (last state * 4 + new state).
+// Gives the direction of rotation or Illegal if both lines changed.
+const int Illegal = 2;
+const int QuadratureTable[16] = {
+     0, -1,  1,  Illegal,
+     1,  0,  Illegal, -1,
+    -1,  Illegal,  0,  1,
+     Illegal,  1, -1,  0
+};
+
+bool gpioUsed[MaxGpio];
 
 void watcher(knobs*);
+static void virtualWatcher(knobs* t);
+static void decodeChanges(knobs* t, unsigned int bits, double edgeTime);
+static void recordChanges(knobs* t, unsigned int bits, unsigned int changed, double edgeTime);
+static void decode(knobs* t, int num, int state, double edgeTime);
 
-#ifdef NoGpiod
+#if defined(NoKnobs)
+// No gpio library so only virtual knobs are available
+static void gpioInit()
+{
+}
+
+static bool gpioStart()
+{
+    return false;
+}
+
+static void gpioAdd(int gpioNum)
+{
+}
+
+static unsigned int gpioReadAll()
+{
+    return 0;
+}
+
+#elif defined(NoGpiod)
 static void gpioInit()
 {
     // Use BCM GPIO pin numbers
     wiringPiSetupGpio();
 }
 
+static bool gpioStart()
+{
+    // WiringPi doesn't support edge events so always poll
+    return false;
+}
+
 static void gpioAdd(int gpioNum)
 {
     // NOTE: pullUpDnControl does not work on RasPi4 so have
@@ -31,28 +79,36 @@ static void gpioAdd(int gpioNum)
     }
 }
 
-static void gpioReadAll()
+/// <summary>
+/// Returns the state of every used gpio as a bitmap
+/// </summary>
+static unsigned int gpioReadAll()
 {
-    // Nothing to do as states are read individually
-}
+    unsigned int bits = 0;
+    for (int i = 0; i < MaxGpio; i++) {
+        if (gpioUsed[i] && digitalRead(i)) {
+            bits |= 1u << i;
+        }
+    }
 
-static int gpioGetState(int gpioNum)
-{
-    return digitalRead(gpioNum);
+    return bits;
 }
 
 #else
 
-const int MaxGpio = 28;
+const int MaxEvents = 64;
 char chipName[16];
 struct gpiod_chip* gpioChip;
 struct gpiod_line_bulk gpioLines;
 int gpioValues[MaxGpio];
 
+struct GpioEvent {
+    int gpio;
+    struct gpiod_line_event event;
+};
+
 static void gpioInit()
 {
-    unsigned int offsets[MaxGpio];
-
     // Raspberry Pi 5 uses gpiochip4 rather than gpiochip0
     FILE* inf = fopen("/dev/gpiochip4", "r");
     if (inf) {
@@ -68,16 +124,47 @@ static void gpioInit()
         sprintf(globals.error, "Failed to open chip %s\n", chipName);
         return;
     }
+}
+
+static void gpioAdd(int gpioNum)
+{
+    // Nothing to do as all lines are requested when the watcher starts
+}
+
+/// <summary>
+/// Requests both-edge events on every line (not just the ones in use
+/// so knobs added later still see their edges) so the watcher can
+/// sleep until something changes. Returns false if the kernel or
+/// libgpiod can't do this, in which case all lines are requested as
+/// plain inputs and polled instead.
+/// </summary>
+static bool gpioStart()
+{
+    if (!gpioChip) {
+        return false;
+    }
 
+    unsigned int offsets[MaxGpio];
     for (int i = 0; i < MaxGpio; i++) {
         offsets[i] = i;
     }
 
     if (gpiod_chip_get_lines(gpioChip, offsets, MaxGpio, &gpioLines)) {
         sprintf(globals.error, "Failed to get chip %s lines", chipName);
-        return;
+        return false;
+    }
+
+    if (gpiod_line_request_bulk_both_edges_events_flags(&gpioLines,
+        "instrument-panel", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) == 0)
+    {
+        // Edge events only report changes so need the starting states
+        if (gpiod_line_get_value_bulk(&gpioLines, gpioValues) == 0) {
+            return true;
+        }
+        gpiod_line_release_bulk(&gpioLines);
     }
 
+    // Fall back to polling every line
     struct gpiod_line_request_config config;
     memset(&config, 0, sizeof(config));
     config.consumer = "instrument-panel";
@@ -86,36 +173,173 @@ static void gpioInit()
 
     if (gpiod_line_request_bulk(&gpioLines, &config, gpioValues)) {
         sprintf(globals.error, "Failed to bulk request chip %s lines", chipName);
-        return;
     }
-}
 
-static void gpioAdd(int gpioNum)
-{
-    // Nothing to do as all lines have been set to inputs and pulled-up
+    return false;
 }
 
-static void gpioReadAll()
+/// <summary>
+/// Returns the state of every gpio as a bitmap
+/// </summary>
+static unsigned int gpioReadAll()
 {
     // Just read every gpio state in a single call
     if (gpiod_line_get_value_bulk(&gpioLines, gpioValues)) {
         sprintf(globals.error, "Failed to get gpio values");
-        return;
+        return 0;
+    }
+
+    unsigned int bits = 0;
+    for (int i = 0; i < MaxGpio; i++) {
+        if (gpioValues[i]) {
+            bits |= 1u << i;
+        }
     }
+
+    return bits;
 }
 
-static int gpioGetState(int gpioNum)
+/// <summary>
+/// Kernel timestamp of a line event in seconds. Only comparable with
+/// other event timestamps, use eventClockOffset to convert it.
+/// </summary>
+static double eventTime(const struct gpiod_line_event* event)
 {
-    // States have already been read so just return the requested one
-    return gpioValues[gpioNum];
+    return event->ts.tv_sec + event->ts.tv_nsec / 1000000000.0;
+}
+
+/// <summary>
+/// Kernels since 5.7 stamp line events with CLOCK_MONOTONIC but older
+/// ones use CLOCK_REALTIME. Returns the offset that moves a kernel
+/// timestamp onto the panel clock (al_get_time), measured against
+/// whichever kernel clock the timestamp is closest to.
+/// </summary>
+static double eventClockOffset(double stamp)
+{
+    struct timespec mono;
+    struct timespec real;
+    double now = al_get_time();
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    clock_gettime(CLOCK_REALTIME, &real);
+
+    double monoNow = mono.tv_sec + mono.tv_nsec / 1000000000.0;
+    double realNow = real.tv_sec + real.tv_nsec / 1000000000.0;
+    return now - (fabs(stamp - monoNow) < fabs(stamp - realNow) ? monoNow : realNow);
+}
+
+/// <summary>
+/// Blocks until one or more lines change then decodes the edges in
+/// the order the kernel saw them. Events from the two lines of an
+/// encoder arrive on separate fds so must be merged by timestamp or
+/// fast rotations would be decoded in the wrong order.
+/// </summary>
+static void eventWatcher(knobs* t)
+{
+    struct pollfd fds[MaxGpio];
+    int fdGpio[MaxGpio];
+    int fdCount = gpioLines.num_lines;
+    GpioEvent events[MaxEvents];
+    struct gpiod_line_event lineEvents[MaxEvents];
+
+    for (int i = 0; i < fdCount; i++) {
+        struct gpiod_line* line = gpiod_line_bulk_get_line(&gpioLines, i);
+        fds[i].fd = gpiod_line_event_get_fd(line);
+        fds[i].events = POLLIN;
+        fdGpio[i] = gpiod_line_offset(line);
+    }
+
+    // Initialise states (and switch values) from the starting levels
+    unsigned int bits = 0;
+    for (int i = 0; i < fdCount; i++) {
+        if (gpioValues[fdGpio[i]]) {
+            bits |= 1u << fdGpio[i];
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(t->knobsMutex);
+        t->gpioBits = ~bits;
+        decodeChanges(t, bits, al_get_time());
+    }
+
+    while (!globals.quit) {
+        // Wake up occasionally to check for quit
+        int ready = poll(fds, fdCount, 100);
+
+        std::lock_guard<std::mutex> lock(t->knobsMutex);
+        if (t->newKnobs) {
+            // Knobs added since the last edge start from the current levels
+            decodeChanges(t, bits, al_get_time());
+        }
+
+        if (ready <= 0) {
+            continue;
+        }
+
+        int eventCount = 0;
+        for (int i = 0; i < fdCount && eventCount < MaxEvents; i++) {
+            if (!(fds[i].revents & POLLIN)) {
+                continue;
+            }
+
+            int count = gpiod_line_event_read_fd_multiple(fds[i].fd, lineEvents, MaxEvents - eventCount);
+            for (int j = 0; j < count; j++) {
+                // Insertion sort by timestamp (only a handful of events)
+                double time = eventTime(&lineEvents[j]);
+                int pos = eventCount;
+                while (pos > 0 && eventTime(&events[pos - 1].event) > time) {
+                    events[pos] = events[pos - 1];
+                    pos--;
+                }
+                events[pos].gpio = fdGpio[i];
+                events[pos].event = lineEvents[j];
+                eventCount++;
+            }
+        }
+
+        if (eventCount == 0) {
+            continue;
+        }
+
+        // Keep the kernel's spacing between edges (acceleration needs it)
+        // but move them onto the same clock as the rest of the panel
+        double offset = eventClockOffset(eventTime(&events[0].event));
+        for (int i = 0; i < eventCount; i++) {
+            if (events[i].event.event_type == GPIOD_LINE_EVENT_RISING_EDGE) {
+                bits |= 1u << events[i].gpio;
+            }
+            else {
+                bits &= ~(1u << events[i].gpio);
+            }
+            decodeChanges(t, bits, eventTime(&events[i].event) + offset);
+        }
+    }
+
+    gpiod_line_release_bulk(&gpioLines);
 }
 #endif
 
+/// <summary>
+/// Knobs are normally read from the gpio pins. If the Knobs settings
+/// have a Virtual source the gpio pins are ignored and all edges come
+/// from the source instead (see virtualWatcher).
+/// </summary>
 knobs::knobs()
 {
-#ifndef NoKnobs
-    gpioInit();
-#endif
+    isVirtual = (globals.virtualKnobs[0] != '\0');
+
+    if (globals.recordKnobs[0] != '\0') {
+        recordFile = fopen(globals.recordKnobs, "w");
+        if (recordFile) {
+            fprintf(recordFile, "# Knob session recorded by instrument-panel\n");
+        }
+        else {
+            sprintf(globals.error, "Failed to create knob recording %s", globals.recordKnobs);
+        }
+    }
+
+    if (!isVirtual) {
+        gpioInit();
+    }
 }
 
 knobs::~knobs()
@@ -124,6 +348,22 @@ knobs::~knobs()
         // Wait for thread to exit
         watcherThread->join();
     }
+
+    // Report any encoders that are dropping steps
+    if (droppedEvents > 0) {
+        printf("Knobs: %d events dropped\n", droppedEvents);
+    }
+
+    for (int num = 0; num < knobCount; num++) {
+        if (illegalSteps[num] > 0) {
+            printf("Knob %d, %d: %d valid steps, %d illegal transitions, %d inferred steps\n",
+                gpio[num][0], gpio[num][1], validSteps[num], illegalSteps[num], inferredSteps[num]);
+        }
+    }
+
+    if (recordFile) {
+        fclose(recordFile);
+    }
 }
 
 /// <summary>
@@ -137,6 +377,11 @@ int knobs::add(int gpio1, int gpio2, int minVal, int maxVal, int startVal)
         return -1;
     }
 
+    if (gpio1 < 0 || gpio1 >= MaxGpio || gpio2 < 0 || gpio2 >= MaxGpio) {
+        sprintf(globals.error, "Invalid gpio number for knob %d, %d", gpio1, gpio2);
+        return -1;
+    }
+
     if (gpio2 == 0) {
         printf("Add switch: %d\n", gpio1);
         fflush(stdout);
@@ -146,13 +391,23 @@ int knobs::add(int gpio1, int gpio2, int minVal, int maxVal, int startVal)
         fflush(stdout);
     }
 
-#ifndef NoKnobs
-    gpioAdd(gpio1);
+    if (!isVirtual) {
+        gpioAdd(gpio1);
+
+        if (gpio2 != 0) {
+            gpioAdd(gpio2);
+        }
+    }
+
+    // The watcher thread may already be decoding other knobs
+    std::unique_lock<std::mutex> lock(knobsMutex);
 
+    gpioUsed[gpio1] = true;
+    gpioKnobs[gpio1] |= 1u << knobCount;
     if (gpio2 != 0) {
-        gpioAdd(gpio2);
+        gpioUsed[gpio2] = true;
+        gpioKnobs[gpio2] |= 1u << knobCount;
     }
-#endif
 
     gpio[knobCount][0] = gpio1;
     gpio[knobCount][1] = gpio2;
@@ -160,14 +415,84 @@ int knobs::add(int gpio1, int gpio2, int minVal, int maxVal, int startVal)
     minValue[knobCount] = minVal;
     maxValue[knobCount] = maxVal;
     value[knobCount] = startVal;
+    position[knobCount] = startVal;
+    pressTime[knobCount] = 0;
+    eventTime[knobCount] = 0;
+    unreadTime[knobCount] = 0;
     lastValue[knobCount] = -1;
     lastState[knobCount] = -1;
     clockwise[knobCount] = true;
+    edgeTime[knobCount] = 0;
+    stepTime[knobCount] = 0;
+    accel[knobCount].points = 0;
+    validSteps[knobCount] = 0;
+    illegalSteps[knobCount] = 0;
+    inferredSteps[knobCount] = 0;
+    newKnobs |= 1u << knobCount;
 
     knobCount++;
+    lock.unlock();
+
+    if (gpio2 != 0 && globals.simVars) {
+        const char* curve = globals.simVars->getKnobCurve(gpio1, gpio2);
+        if (curve && !setAcceleration(knobCount - 1, curve)) {
+            sprintf(globals.error, "Knob %d,%d has an invalid acceleration curve: %s", gpio1, gpio2, curve);
+        }
+    }
+
     return knobCount - 1;
 }
 
+/// <summary>
+/// Sets how much a step is multiplied by when the knob is turned quickly.
+/// Curve is a list of speed:multiplier pairs in increasing order of
+/// speed, e.g. "10:2 25:5 50:10". Speed is in steps per second.
+/// </summary>
+bool knobs::setAcceleration(int knobNum, const char* curve)
+{
+    AccelCurve newCurve;
+    const char* pos = curve;
+
+    while (true) {
+        while (*pos == ' ' || *pos == ',') {
+            pos++;
+        }
+
+        if (*pos == '\0') {
+            break;
+        }
+
+        if (newCurve.points == MaxCurvePoints) {
+            return false;
+        }
+
+        char* end;
+        double speed = strtod(pos, &end);
+        if (end == pos || *end != ':' || speed <= 0) {
+            return false;
+        }
+
+        pos = end + 1;
+        long multiplier = strtol(pos, &end, 10);
+        if (end == pos || multiplier < 1) {
+            return false;
+        }
+
+        if (newCurve.points > 0 && speed <= newCurve.speed[newCurve.points - 1]) {
+            return false;
+        }
+
+        newCurve.speed[newCurve.points] = speed;
+        newCurve.multiplier[newCurve.points] = (int)multiplier;
+        newCurve.points++;
+        pos = end;
+    }
+
+    std::lock_guard<std::mutex> lock(knobsMutex);
+    accel[knobNum] = newCurve;
+    return true;
+}
+
 /// <summary>
 /// Returns INT_MIN if knob has not moved or new value if it has.
 /// </summary>
@@ -176,9 +501,12 @@ int knobs::read(int knobNum)
     int newVal = INT_MIN;
 
     if (watcherThread) {
+        receiveEvents();
         if (knobNum >= 0 && value[knobNum] != lastValue[knobNum]) {
             newVal = value[knobNum];
             lastValue[knobNum] = newVal;
+            latency::knobRead(unreadTime[knobNum]);
+            unreadTime[knobNum] = 0;
         }
     }
     else {
@@ -190,78 +518,123 @@ int knobs::read(int knobNum)
 }
 
 /// <summary>
-/// Need to monitor hardware knobs on a separate thread
-/// at constant small intervals so we don't miss any events.
-/// Need accurate readings to determine which way a knob is
-/// being rotated.
+/// Returns how long a switch has been held down in seconds
+/// or 0 if it isn't pressed. Measured in whole frames.
 /// </summary>
-void watcher(knobs *t)
+double knobs::pressDuration(int knobNum)
 {
-    int state = 0;
+    if (knobNum < 0 || pressTime[knobNum] == 0) {
+        return 0;
+    }
 
-    while (!globals.quit) {
-#ifndef NoKnobs
-        gpioReadAll();
-#endif
+    return globals.frameTime - pressTime[knobNum];
+}
 
-        for (int num = 0; num < t->knobCount; num++) {
-            bool isSwitch = (t->gpio[num][1] == 0);
+/// <summary>
+/// Returns the number of seconds since a knob was last turned or
+/// pressed or a large value if it hasn't been touched.
+/// </summary>
+double knobs::idleTime(int knobNum)
+{
+    if (knobNum < 0 || eventTime[knobNum] == 0) {
+        return 1e9;
+    }
 
-#ifndef NoKnobs
-            state = gpioGetState(t->gpio[num][0]);
-#endif
+    return globals.frameTime - eventTime[knobNum];
+}
 
-            if (!isSwitch) {
-#ifndef NoKnobs
-                state += gpioGetState(t->gpio[num][1]) * 2;
-#endif
-            }
+/// <summary>
+/// Called by the watcher thread to queue an event for the main thread.
+/// Returns false if the queue is full (main thread not reading).
+/// </summary>
+bool knobs::postEvent(int knobNum, KnobEventType type, int steps, double time)
+{
+    unsigned int head = eventHead.load(std::memory_order_relaxed);
+    if (head - eventTail.load(std::memory_order_acquire) == MaxKnobEvents) {
+        droppedEvents++;
+        return false;
+    }
 
-            if (state != t->lastState[num]) {
-                if (isSwitch) {
-                    // If pressed increment value to next even number
-                    // otherwise increment value to next odd number.
-                    // This ensures no presses can be 'lost'.
-                    if (state == 0) {
-                        if (t->value[num] % 2 == 1) t->value[num]++; else t->value[num] += 2;
-                    }
-                    else {
-                        if (t->value[num] % 2 == 0) t->value[num]++; else t->value[num] += 2;
-                    }
-                }
-                else if ((t->lastState[num] == 0 && state == 2) ||
-                    (t->lastState[num] == 2 && state == 3) ||
-                    (t->lastState[num] == 3 && state == 1) ||
-                    (t->lastState[num] == 1 && state == 0))
-                {
-                    // Rotating clockwise
-                    t->clockwise[num] = true;
-                    if (!t->limited[num] || t->value[num] < t->maxValue[num]) t->value[num]++;
-                }
-                else if ((t->lastState[num] == 0 && state == 1) ||
-                    (t->lastState[num] == 1 && state == 3) ||
-                    (t->lastState[num] == 3 && state == 2) ||
-                    (t->lastState[num] == 2 && state == 0))
-                {
-                    // Rotating anti-clockwise
-                    t->clockwise[num] = false;
-                    if (!t->limited[num] || t->value[num] > t->minValue[num]) t->value[num]--;
-                }
-                else if (t->lastState[num] != -1) {
-                    // Missed rotation so assume same direction as previous
-                    if (t->clockwise[num]) {
-                        if (!t->limited[num] || t->value[num] < t->maxValue[num]) t->value[num]++;
-                    }
-                    else {
-                        if (!t->limited[num] || t->value[num] > t->minValue[num]) t->value[num]--;
-                    }
-                }
+    KnobEvent* event = &events[head & (MaxKnobEvents - 1)];
+    event->knobNum = knobNum;
+    event->type = type;
+    event->steps = steps;
+    event->time = time;
 
-                t->lastState[num] = state;
-            }
+    eventHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/// <summary>
+/// Applies all queued events, in the order they happened, to the
+/// values seen by instruments. Press and idle times are stamped with
+/// the frame time so they can be compared without reading the clock.
+/// </summary>
+void knobs::receiveEvents()
+{
+    unsigned int tail = eventTail.load(std::memory_order_relaxed);
+    unsigned int head = eventHead.load(std::memory_order_acquire);
+
+    while (tail != head) {
+        const KnobEvent* event = &events[tail & (MaxKnobEvents - 1)];
+        int num = event->knobNum;
+
+        switch (event->type) {
+        case KNOB_STEP:
+            value[num] += event->steps;
+            break;
+        case KNOB_PRESS:
+            // If pressed increment value to next even number
+            // otherwise increment value to next odd number.
+            // This ensures no presses can be 'lost'.
+            if (value[num] % 2 == 1) value[num]++; else value[num] += 2;
+            pressTime[num] = globals.frameTime;
+            break;
+        case KNOB_RELEASE:
+            if (value[num] % 2 == 0) value[num]++; else value[num] += 2;
+            pressTime[num] = 0;
+            break;
+        }
+        eventTime[num] = globals.frameTime;
+        if (unreadTime[num] == 0) {
+            unreadTime[num] = event->time;
         }
 
+        tail++;
+    }
+
+    eventTail.store(tail, std::memory_order_release);
+}
+
+/// <summary>
+/// Need to monitor hardware knobs on a separate thread so we don't
+/// miss any events. Need accurate readings to determine which way a
+/// knob is being rotated. If the gpio lines support edge events the
+/// thread sleeps until a line changes, otherwise the lines are polled
+/// at constant small intervals.
+/// </summary>
+void watcher(knobs *t)
+{
+    if (t->isVirtual) {
+        virtualWatcher(t);
+        return;
+    }
+
+    if (gpioStart()) {
+#if !defined(NoKnobs) && !defined(NoGpiod)
+        eventWatcher(t);
+#endif
+        return;
+    }
+
 #ifndef NoKnobs
+    while (!globals.quit) {
+        {
+            // Knobs are all decoded on the first read as they are new
+            std::lock_guard<std::mutex> lock(t->knobsMutex);
+            decodeChanges(t, gpioReadAll(), al_get_time());
+        }
+
         // Sleep for 1 millisec
         struct timespec sleeper, dummy;
 
@@ -269,9 +642,327 @@ void watcher(knobs *t)
         sleeper.tv_nsec = 1000000;
 
         nanosleep(&sleeper, &dummy);
-#else
-	sleep(1000);
+    }
 #endif
+}
+
+/// <summary>
+/// Sleeps for the given number of milliseconds unless quitting
+/// </summary>
+static void virtualWait(int millis)
+{
+    double until = al_get_time() + millis / 1000.0;
+    while (!globals.quit) {
+        double remaining = until - al_get_time();
+        if (remaining <= 0) {
+            return;
+        }
+
+        // Wake up occasionally to check for quit
+        if (remaining > 0.1) {
+            remaining = 0.1;
+        }
+
+        struct timespec sleeper, dummy;
+        sleeper.tv_sec = 0;
+        sleeper.tv_nsec = (long)(remaining * 1000000000);
+        nanosleep(&sleeper, &dummy);
+    }
+}
+
+/// <summary>
+/// Sets a virtual gpio line to 0 or 1 and decodes the change
+/// </summary>
+static void virtualEdge(knobs* t, unsigned int* bits, int gpioNum, int level)
+{
+    if (gpioNum < 0 || gpioNum >= MaxGpio) {
+        return;
+    }
+
+    if (level) {
+        *bits |= 1u << gpioNum;
+    }
+    else {
+        *bits &= ~(1u << gpioNum);
+    }
+
+    std::lock_guard<std::mutex> lock(t->knobsMutex);
+    decodeChanges(t, *bits, al_get_time());
+}
+
+/// <summary>
+/// Executes one line of a virtual knob script:
+///   wait <millis>              pause
+///   <gpio> <0|1>               set a line level
+///   press <gpio>               pull a switch line low
+///   release <gpio>             let a switch line go high
+///   turn <gpio1> <gpio2> <n>   n steps clockwise (negative for anti-clockwise)
+/// Anything after a # is a comment.
+/// </summary>
+static void virtualCommand(knobs* t, unsigned int* bits, char* line)
+{
+    char* comment = strchr(line, '#');
+    if (comment) {
+        *comment = '\0';
+    }
+
+    char command[16];
+    int arg1, arg2, arg3;
+    int count = sscanf(line, "%15s %d %d %d", command, &arg1, &arg2, &arg3);
+    if (count < 1) {
+        return;
+    }
+
+    if (strcmp(command, "wait") == 0 && count == 2) {
+        virtualWait(arg1);
+    }
+    else if (strcmp(command, "press") == 0 && count == 2) {
+        virtualEdge(t, bits, arg1, 0);
+    }
+    else if (strcmp(command, "release") == 0 && count == 2) {
+        virtualEdge(t, bits, arg1, 1);
+    }
+    else if (strcmp(command, "turn") == 0 && count == 4) {
+        // Clockwise is 0 -> 2 -> 3 -> 1 -> 0 (see QuadratureTable)
+        const int nextCw[4] = { 2, 0, 3, 1 };
+        const int nextCcw[4] = { 1, 3, 0, 2 };
+        int steps = abs(arg3);
+        for (int i = 0; i < steps && !globals.quit; i++) {
+            int state = ((*bits >> arg1) & 1) + ((*bits >> arg2) & 1) * 2;
+            int next = (arg3 > 0) ? nextCw[state] : nextCcw[state];
+            if ((next ^ state) & 1) {
+                virtualEdge(t, bits, arg1, next & 1);
+            }
+            else {
+                virtualEdge(t, bits, arg2, next >> 1);
+            }
+            virtualWait(1);
+        }
+    }
+    else if (count == 2 && command[0] >= '0' && command[0] <= '9') {
+        virtualEdge(t, bits, atoi(command), arg1);
+    }
+    else {
+        printf("Virtual knobs: Bad command: %s\n", line);
+    }
+}
+
+/// <summary>
+/// Reads knob edges from a script file, a FIFO or the keyboard (stdin)
+/// instead of the gpio pins. A script is replayed once, in real time,
+/// so recorded sessions can be played back. A FIFO or the keyboard
+/// accepts commands as they are written.
+/// </summary>
+static void virtualWatcher(knobs* t)
+{
+    int fd;
+    if (strcmp(globals.virtualKnobs, "stdin") == 0) {
+        fd = 0;
+    }
+    else {
+        // Open FIFO read/write so it doesn't hit EOF when a writer closes it
+        struct stat info;
+        bool isFifo = (stat(globals.virtualKnobs, &info) == 0 && S_ISFIFO(info.st_mode));
+        fd = open(globals.virtualKnobs, isFifo ? O_RDWR : O_RDONLY);
+        if (fd == -1) {
+            sprintf(globals.error, "Failed to open virtual knobs %s", globals.virtualKnobs);
+            return;
+        }
+    }
+
+    // Lines start high as they would be pulled up
+    unsigned int bits = (1u << MaxGpio) - 1;
+    std::unique_lock<std::mutex> lock(t->knobsMutex);
+    t->gpioBits = ~bits;
+    decodeChanges(t, bits, al_get_time());
+    lock.unlock();
+
+    char line[256];
+    int lineLen = 0;
+    bool eof = false;
+
+    while (!globals.quit && !eof) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        int ready = poll(&pfd, 1, 100);
+
+        lock.lock();
+        if (t->newKnobs) {
+            // Knobs added since the last edge start from the current levels
+            decodeChanges(t, bits, al_get_time());
+        }
+        lock.unlock();
+
+        if (ready <= 0) {
+            continue;
+        }
+
+        char buf[256];
+        int bytes = read(fd, buf, sizeof(buf));
+        if (bytes <= 0) {
+            eof = true;
+            bytes = 0;
+        }
+
+        for (int i = 0; i < bytes && !globals.quit; i++) {
+            if (buf[i] != '\n' && lineLen < (int)sizeof(line) - 1) {
+                line[lineLen++] = buf[i];
+                continue;
+            }
+
+            if (buf[i] == '\n') {
+                line[lineLen] = '\0';
+                virtualCommand(t, &bits, line);
+                lineLen = 0;
+            }
+        }
+    }
+
+    if (eof && lineLen > 0) {
+        line[lineLen] = '\0';
+        virtualCommand(t, &bits, line);
+    }
+
+    if (fd != 0) {
+        close(fd);
+    }
+}
+
+/// <summary>
+/// Compares the new gpio bitmap with the previous one and only
+/// decodes the knobs that use a line that has changed (and any
+/// that have just been added). Caller must hold knobsMutex.
+/// </summary>
+static void decodeChanges(knobs* t, unsigned int bits, double edgeTime)
+{
+    unsigned int changed = (bits ^ t->gpioBits) & ((1u << MaxGpio) - 1);
+    t->gpioBits = bits;
+
+    if (t->recordFile) {
+        recordChanges(t, bits, changed, edgeTime);
+    }
+
+    unsigned int knobMask = t->newKnobs;
+    t->newKnobs = 0;
+    while (changed) {
+        knobMask |= t->gpioKnobs[__builtin_ctz(changed)];
+        changed &= changed - 1;
+    }
+
+    while (knobMask) {
+        int num = __builtin_ctz(knobMask);
+        knobMask &= knobMask - 1;
+
+        int state = (bits >> t->gpio[num][0]) & 1;
+        if (t->gpio[num][1] != 0) {
+            state += ((bits >> t->gpio[num][1]) & 1) * 2;
+        }
+        decode(t, num, state, edgeTime);
+    }
+}
+
+/// <summary>
+/// Writes changed lines of used gpios to the recording in the same
+/// format that virtual knobs read so a session can be replayed.
+/// </summary>
+static void recordChanges(knobs* t, unsigned int bits, unsigned int changed, double edgeTime)
+{
+    bool first = true;
+    for (int i = 0; i < MaxGpio; i++) {
+        if (!gpioUsed[i] || !(changed & (1u << i))) {
+            continue;
+        }
+
+        if (first) {
+            if (t->recordTime > 0) {
+                int millis = (int)((edgeTime - t->recordTime) * 1000 + 0.5);
+                if (millis > 0) {
+                    fprintf(t->recordFile, "wait %d\n", millis);
+                }
+            }
+            t->recordTime = edgeTime;
+            first = false;
+        }
+
+        fprintf(t->recordFile, "%d %d\n", i, (bits >> i) & 1);
+    }
+}
+
+/// <summary>
+/// Returns the step multiplier for how fast the knob is being turned
+/// </summary>
+static int acceleration(knobs* t, int num, int steps, double edgeTime)
+{
+    const AccelCurve* curve = &t->accel[num];
+    double interval = edgeTime - t->stepTime[num];
+    if (curve->points == 0 || t->stepTime[num] == 0 || interval <= 0) {
+        return 1;
+    }
+
+    double speed = steps / interval;
+    int multiplier = 1;
+    for (int i = 0; i < curve->points && speed >= curve->speed[i]; i++) {
+        multiplier = curve->multiplier[i];
+    }
+
+    return multiplier;
+}
+
+/// <summary>
+/// Updates a knob's value from the new state of its gpio lines.
+/// Edge time is in seconds.
+/// </summary>
+static void decode(knobs* t, int num, int state, double edgeTime)
+{
+    int lastState = t->lastState[num];
+    if (state == lastState) {
+        return;
+    }
+
+    t->lastState[num] = state;
+    t->edgeTime[num] = edgeTime;
+
+    if (t->gpio[num][1] == 0) {
+        // Switches are pulled up so pressed is 0
+        t->postEvent(num, state == 0 ? KNOB_PRESS : KNOB_RELEASE, 0, edgeTime);
+        return;
+    }
+
+    if (lastState == -1) {
+        // First reading
+        return;
+    }
+
+    int step = QuadratureTable[lastState * 4 + state];
+    if (step == Illegal) {
+        // Missed a state so assume two steps in the same direction as previous
+        t->illegalSteps[num]++;
+        t->inferredSteps[num] += 2;
+        step = t->clockwise[num] ? 2 : -2;
+    }
+    else {
+        t->validSteps[num]++;
+        if (t->clockwise[num] != (step > 0)) {
+            // Changed direction so don't accelerate
+            t->clockwise[num] = (step > 0);
+            t->stepTime[num] = 0;
+        }
+    }
+
+    step *= acceleration(t, num, abs(step), edgeTime);
+
+    int newPos = t->position[num] + step;
+    if (t->limited[num]) {
+        if (newPos > t->maxValue[num]) newPos = t->maxValue[num];
+        if (newPos < t->minValue[num]) newPos = t->minValue[num];
+    }
+
+    // Only move on if the main thread will see the step, otherwise
+    // the two positions would drift apart when the queue is full
+    if (newPos != t->position[num] && t->postEvent(num, KNOB_STEP, newPos - t->position[num], edgeTime)) {
+        t->position[num] = newPos;
+        t->stepTime[num] = edgeTime;
     }
 }
 
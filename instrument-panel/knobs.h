@@ -3,33 +3,108 @@
 
 #include <cstdio>
 #include <thread>
+#include <atomic>
+#include <mutex>
 #include "globals.h"
 
 extern globalVars globals;
 
-// Set maximum number of knobs
+// Set maximum number of knobs (must fit in a bitmask)
 const int MaxKnobs = 20;
+const int MaxGpio = 28;
+const int MaxCurvePoints = 8;
+
+// Size of event queue (must be a power of 2)
+const int MaxKnobEvents = 256;
+
+enum KnobEventType {
+    KNOB_STEP,
+    KNOB_PRESS,
+    KNOB_RELEASE
+};
+
+/// <summary>
+/// Passed from the watcher thread to the main thread for every
+/// change. Time is when the edge was seen (seconds, monotonic).
+/// </summary>
+struct KnobEvent
+{
+    int knobNum;
+    KnobEventType type;
+    int steps;
+    double time;
+};
+
+/// <summary>
+/// Knob turned at or above speed (steps per second) multiplies
+/// each step by multiplier.
+/// </summary>
+struct AccelCurve
+{
+    int points = 0;
+    double speed[MaxCurvePoints];
+    int multiplier[MaxCurvePoints];
+};
 
 class knobs
 {
 private:
     std::thread *watcherThread = NULL;
 
+    // Lock-free queue with a single producer (watcher thread)
+    // and a single consumer (main thread).
+    KnobEvent events[MaxKnobEvents];
+    std::atomic<unsigned int> eventHead{ 0 };
+    std::atomic<unsigned int> eventTail{ 0 };
+
 public:
+    bool isVirtual = false;
+    FILE* recordFile = NULL;
+    double recordTime = 0;
     int knobCount = 0;
     int gpio[MaxKnobs][2];
     bool limited[MaxKnobs];
     int minValue[MaxKnobs];
     int maxValue[MaxKnobs];
+
+    // Only used by the main thread
     int value[MaxKnobs];
     int lastValue[MaxKnobs];
+    double pressTime[MaxKnobs];
+    double eventTime[MaxKnobs];
+    double unreadTime[MaxKnobs];
+
+    // Only used by the watcher thread
+    int position[MaxKnobs];
     int lastState[MaxKnobs];
     bool clockwise[MaxKnobs];
+    double edgeTime[MaxKnobs];
+    double stepTime[MaxKnobs];
+    AccelCurve accel[MaxKnobs];
+    unsigned int gpioKnobs[MaxGpio] = {};  // Bitmask of knobs using each gpio
+    unsigned int gpioBits = 0;              // Last state of every gpio
+    unsigned int newKnobs = 0;              // Knobs not decoded since being added
+
+    // Held by add() and while the watcher thread decodes
+    std::mutex knobsMutex;
+
+    // Diagnostics
+    int validSteps[MaxKnobs];
+    int illegalSteps[MaxKnobs];
+    int inferredSteps[MaxKnobs];
+    int droppedEvents = 0;
 
     knobs();
     ~knobs();
     int add(int gpio1, int gpio2, int minValue, int maxValue, int startValue);
     int read(int knobNum);
+    bool setAcceleration(int knobNum, const char* curve);
+    double pressDuration(int knobNum);
+    double idleTime(int knobNum);
+    bool postEvent(int knobNum, KnobEventType type, int steps, double time);
+
+private:
+    void receiveEvents();
 };
 
 #endif // _KNOB_H_
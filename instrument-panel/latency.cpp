@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <allegro5/allegro.h>
+#include "latency.h"
+
+const char* LatencyStageNames[] = {
+    "Edge to knob read",
+    "Edge to event write",
+    "Edge to next sim data"
+};
+
+std::mutex latency::statsMutex;
+latency::Histogram latency::stats[LatencyStages];
+double latency::readEdge = 0;
+double latency::writeEdge = 0;
+
+/// <summary>
+/// An instrument has read a knob that changed. Edge time is
+/// when the first unread change happened.
+/// </summary>
+void latency::knobRead(double edgeTime)
+{
+    if (edgeTime <= 0) {
+        return;
+    }
+
+    add(EDGE_TO_READ, al_get_time() - edgeTime);
+
+    // Keep the earliest edge if several knobs are read in one frame
+    if (readEdge == 0 || edgeTime < readEdge) {
+        readEdge = edgeTime;
+    }
+}
+
+/// <summary>
+/// An event has been sent to the sim. If a knob was read this
+/// frame the event is assumed to be the result of it.
+/// </summary>
+void latency::eventWritten()
+{
+    if (readEdge == 0) {
+        return;
+    }
+
+    add(EDGE_TO_WRITE, al_get_time() - readEdge);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    if (writeEdge == 0) {
+        writeEdge = readEdge;
+    }
+    readEdge = 0;
+}
+
+/// <summary>
+/// Called by the data link thread when new data has been received.
+/// The first data after a write is taken as the sim's response.
+/// </summary>
+void latency::dataReceived()
+{
+    double edgeTime;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        edgeTime = writeEdge;
+        writeEdge = 0;
+    }
+
+    if (edgeTime > 0) {
+        add(EDGE_TO_DATA, al_get_time() - edgeTime);
+    }
+}
+
+/// <summary>
+/// A knob read that didn't cause a write (e.g. changing a selection)
+/// must not be blamed for a later write.
+/// </summary>
+void latency::frameDone()
+{
+    readEdge = 0;
+}
+
+void latency::add(LatencyStage stage, double seconds)
+{
+    double millis = seconds * 1000;
+    if (millis < 0) {
+        millis = 0;
+    }
+
+    int bucket = 0;
+    double limit = 0.125;
+    while (millis >= limit && bucket < LatencyBuckets - 1) {
+        limit *= 2;
+        bucket++;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    Histogram* hist = &stats[stage];
+    if (hist->count == 0 || millis < hist->min) {
+        hist->min = millis;
+    }
+    if (millis > hist->max) {
+        hist->max = millis;
+    }
+    hist->count++;
+    hist->total += millis;
+    hist->buckets[bucket]++;
+}
+
+/// <summary>
+/// Writes a histogram of each stage in milliseconds
+/// </summary>
+void latency::dump(FILE* outfile)
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    fprintf(outfile, "Knob latency (ms)\n");
+    for (int stage = 0; stage < LatencyStages; stage++) {
+        Histogram* hist = &stats[stage];
+        if (hist->count == 0) {
+            fprintf(outfile, "  %s: no samples\n", LatencyStageNames[stage]);
+            continue;
+        }
+
+        fprintf(outfile, "  %s: %d samples, mean %.2f, min %.2f, max %.2f\n", LatencyStageNames[stage],
+            hist->count, hist->total / hist->count, hist->min, hist->max);
+
+        double limit = 0.125;
+        for (int i = 0; i < LatencyBuckets; i++) {
+            if (hist->buckets[i] > 0) {
+                if (i == LatencyBuckets - 1) {
+                    fprintf(outfile, "    >= %8.3f: %d\n", limit / 2, hist->buckets[i]);
+                }
+                else {
+                    fprintf(outfile, "    <  %8.3f: %d\n", limit, hist->buckets[i]);
+                }
+            }
+            limit *= 2;
+        }
+    }
+
+    fflush(outfile);
+}
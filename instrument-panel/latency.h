@@ -0,0 +1,52 @@
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#include <cstdio>
+#include <mutex>
+
+enum LatencyStage {
+    EDGE_TO_READ,
+    EDGE_TO_WRITE,
+    EDGE_TO_DATA,
+    LatencyStages
+};
+
+// Histogram buckets double in size from 0.125 ms upwards
+const int LatencyBuckets = 16;
+
+/// <summary>
+/// Measures how long a knob takes to have an effect. Each stage is
+/// timed from the gpio edge: when an instrument reads the new knob
+/// value, when the resulting event is sent to the sim and when the
+/// next data from the sim arrives. Times are from the monotonic clock
+/// used for knob edge timestamps.
+/// </summary>
+class latency
+{
+private:
+    struct Histogram
+    {
+        int count = 0;
+        double total = 0;
+        double min = 0;
+        double max = 0;
+        int buckets[LatencyBuckets] = {};
+    };
+
+    static std::mutex statsMutex;
+    static Histogram stats[LatencyStages];
+    static double readEdge;
+    static double writeEdge;
+
+public:
+    static void knobRead(double edgeTime);
+    static void eventWritten();
+    static void dataReceived();
+    static void frameDone();
+    static void dump(FILE* outfile);
+
+private:
+    static void add(LatencyStage stage, double seconds);
+};
+
+#endif // _LATENCY_H_
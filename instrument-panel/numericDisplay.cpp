@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include "numericDisplay.h"
+#include "softBlend.h"
+
+/// <summary>
+/// Clears all glyphs and sets 0-9 from a strip of equal sized digits
+/// in the original bitmap.
+/// </summary>
+void numericDisplay::setDigits(int srcX, int srcY, int width, int height, int advance)
+{
+    for (int i = 0; i < MaxGlyphs; i++) {
+        glyphs[i].defined = false;
+    }
+
+    for (int i = 0; i < 10; i++) {
+        addGlyph('0' + i, srcX + width * i, srcY, width, height, advance);
+    }
+
+    addSpace(' ', advance);
+}
+
+/// <summary>
+/// Adds (or replaces) a glyph. Its top is drawn yOffset below the
+/// top of the line.
+/// </summary>
+void numericDisplay::addGlyph(char ch, int srcX, int srcY, int width, int height, int advance, int yOffset)
+{
+    Glyph* glyph = &glyphs[ch & 0x7f];
+
+    glyph->defined = true;
+    glyph->srcX = srcX;
+    glyph->srcY = srcY;
+    glyph->width = width;
+    glyph->height = height;
+    glyph->advance = advance;
+    glyph->yOffset = yOffset;
+}
+
+/// <summary>
+/// Adds a character that is not drawn but moves the next glyph along
+/// </summary>
+void numericDisplay::addSpace(char ch, int advance)
+{
+    addGlyph(ch, 0, 0, 0, 0, advance);
+}
+
+/// <summary>
+/// Copies every glyph from the original bitmap into a single bitmap,
+/// scaled to the instrument size. The instrument owns the returned
+/// bitmap (add it with addBitmap) and must call this again after a
+/// resize. Glyphs are padded by a pixel so linear filtering doesn't
+/// pick up their neighbours.
+/// </summary>
+ALLEGRO_BITMAP* numericDisplay::createAtlas(ALLEGRO_BITMAP* orig, float scaleX, float scaleY)
+{
+    this->scaleX = scaleX;
+    this->scaleY = scaleY;
+
+    int atlasWidth = 0;
+    int atlasHeight = 1;
+    for (int i = 0; i < MaxGlyphs; i++) {
+        Glyph* glyph = &glyphs[i];
+        if (glyph->defined && glyph->width > 0) {
+            glyph->atlasX = (float)atlasWidth;
+            atlasWidth += (int)ceil(glyph->width * scaleX) + 1;
+
+            int height = (int)ceil(glyph->height * scaleY);
+            if (atlasHeight < height) {
+                atlasHeight = height;
+            }
+        }
+    }
+
+    atlas = al_create_bitmap(atlasWidth > 0 ? atlasWidth : 1, atlasHeight);
+    al_set_target_bitmap(atlas);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+    for (int i = 0; i < MaxGlyphs; i++) {
+        Glyph* glyph = &glyphs[i];
+        if (glyph->defined && glyph->width > 0) {
+            al_draw_scaled_bitmap(orig, glyph->srcX, glyph->srcY, glyph->width, glyph->height,
+                glyph->atlasX, 0, glyph->width * scaleX, glyph->height * scaleY, 0);
+        }
+    }
+
+    return atlas;
+}
+
+/// <summary>
+/// Returns the unscaled width of the text. Characters without a glyph
+/// take no space.
+/// </summary>
+int numericDisplay::textWidth(const char* text)
+{
+    int width = 0;
+    for (const char* ch = text; *ch != '\0'; ch++) {
+        Glyph* glyph = &glyphs[*ch & 0x7f];
+        if (glyph->defined) {
+            width += glyph->advance;
+        }
+    }
+
+    return width;
+}
+
+/// <summary>
+/// Formats the text with printf and draws it onto the current target
+/// with its top left at x, y (unscaled instrument coordinates).
+/// </summary>
+void numericDisplay::draw(int x, int y, const char* format, ...)
+{
+    if (atlas == NULL) {
+        return;
+    }
+
+    char text[32];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    // Caller may already be holding drawing for a bigger batch
+    bool wasHeld = al_is_bitmap_drawing_held();
+    al_hold_bitmap_drawing(true);
+
+    for (const char* ch = text; *ch != '\0'; ch++) {
+        Glyph* glyph = &glyphs[*ch & 0x7f];
+        if (!glyph->defined) {
+            continue;
+        }
+
+        if (glyph->width > 0) {
+            softBlend::drawBitmapRegion(atlas, glyph->atlasX, 0, glyph->width * scaleX, glyph->height * scaleY,
+                x * scaleX, (y + glyph->yOffset) * scaleY, 0);
+        }
+        x += glyph->advance;
+    }
+
+    if (!wasHeld) {
+        al_hold_bitmap_drawing(false);
+    }
+}
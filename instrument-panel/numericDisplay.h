@@ -0,0 +1,47 @@
+#ifndef _NUMERIC_DISPLAY_H_
+#define _NUMERIC_DISPLAY_H_
+
+#include <allegro5/allegro.h>
+
+/// <summary>
+/// Draws numbers on a digital display (radio frequencies, squawk,
+/// autopilot settings, clock) from a glyph atlas that is scaled once
+/// when the instrument is resized. Each call to draw formats a line
+/// with printf and submits all of its glyphs as one batch.
+///
+/// Glyphs are placed one after another using their advance so a blank
+/// glyph (e.g. '.' where the panel already has a decimal point) just
+/// leaves a gap. Space is always a blank the width of a digit.
+/// </summary>
+class numericDisplay
+{
+private:
+    struct Glyph
+    {
+        bool defined = false;
+        int srcX;
+        int srcY;
+        int width;
+        int height;
+        int advance;
+        int yOffset;
+        float atlasX;
+    };
+
+    static const int MaxGlyphs = 128;
+
+    Glyph glyphs[MaxGlyphs];
+    ALLEGRO_BITMAP* atlas = NULL;
+    float scaleX = 1;
+    float scaleY = 1;
+
+public:
+    void setDigits(int srcX, int srcY, int width, int height, int advance);
+    void addGlyph(char ch, int srcX, int srcY, int width, int height, int advance, int yOffset = 0);
+    void addSpace(char ch, int advance);
+    ALLEGRO_BITMAP* createAtlas(ALLEGRO_BITMAP* orig, float scaleX, float scaleY);
+    int textWidth(const char* text);
+    void draw(int x, int y, const char* format, ...);
+};
+
+#endif // _NUMERIC_DISPLAY_H_
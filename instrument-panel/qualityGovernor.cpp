@@ -0,0 +1,98 @@
+#include <allegro5/allegro.h>
+#include <stdio.h>
+#include "qualityGovernor.h"
+
+extern globalVars globals;
+
+// Weight of the latest frame in the smoothed times
+const double Smoothing = 0.05;
+
+// Fractions of the frame budget
+const double BusyPressure = 0.8;
+const double BusyHeadroom = 0.5;
+const double IntervalPressure = 1.1;
+const double IntervalHeadroom = 1.05;
+
+// Seconds a condition must last before the level changes
+const double DegradeTime = 1;
+const double RestoreTime = 10;
+
+static const char* QualityNames[] = {
+    "Full",
+    "Fewer shadows",
+    "Reduced rate",
+    "No shadows"
+};
+
+/// <summary>
+/// Called at the start of every update. Only the first update
+/// since the last frame was drawn starts the frame.
+/// </summary>
+void qualityGovernor::startFrame()
+{
+    if (frameStart == 0) {
+        frameStart = al_get_time();
+    }
+}
+
+/// <summary>
+/// Called after the frame has been flipped with the time
+/// rendering finished (before the flip).
+/// </summary>
+void qualityGovernor::endFrame(double renderEnd)
+{
+    double now = al_get_time();
+    double budget = 1.0 / globals.dataRateFps;
+
+    if (frameStart == 0 || lastFlip == 0) {
+        // Nothing to measure yet
+        busyTime = budget * BusyHeadroom;
+        interval = budget;
+    }
+    else {
+        busyTime += (renderEnd - frameStart - busyTime) * Smoothing;
+        interval += (now - lastFlip - interval) * Smoothing;
+    }
+
+    frameStart = 0;
+    lastFlip = now;
+
+    bool pressure = busyTime > budget * BusyPressure || interval > budget * IntervalPressure;
+    bool headroom = busyTime < budget * BusyHeadroom && interval < budget * IntervalHeadroom;
+
+    if (!pressure) {
+        pressureSince = 0;
+    }
+    else if (pressureSince == 0) {
+        pressureSince = now;
+    }
+    else if (now - pressureSince >= DegradeTime && globals.quality < QUALITY_NO_SHADOWS) {
+        changeLevel(1);
+    }
+
+    if (!headroom) {
+        headroomSince = 0;
+    }
+    else if (headroomSince == 0) {
+        headroomSince = now;
+    }
+    else if (now - headroomSince >= RestoreTime && globals.quality > QUALITY_FULL) {
+        changeLevel(-1);
+    }
+}
+
+/// <summary>
+/// Give the new level time to take effect before judging it
+/// </summary>
+void qualityGovernor::changeLevel(int change)
+{
+    globals.quality = (QualityLevel)(globals.quality + change);
+    pressureSince = 0;
+    headroomSince = 0;
+}
+
+void qualityGovernor::getStats(char* text, int maxLen)
+{
+    double fps = (interval > 0) ? 1.0 / interval : 0;
+    snprintf(text, maxLen, "%.0f fps  %.1f ms  Quality %d: %s", fps, busyTime * 1000, globals.quality, QualityNames[globals.quality]);
+}
@@ -0,0 +1,36 @@
+#ifndef _QUALITY_GOVERNOR_H_
+#define _QUALITY_GOVERNOR_H_
+
+#include "globals.h"
+
+/// <summary>
+/// Watches how long each frame takes and lowers globals.quality one
+/// level at a time while the panel can't keep up with the frame rate,
+/// e.g. when the Raspberry Pi GPU throttles. Quality is raised again
+/// one level at a time once there has been plenty of headroom for a
+/// while.
+///
+/// Busy time is from the first update of a frame until the frame has
+/// been drawn (before the flip so waiting for vsync isn't counted).
+/// Interval is the time between flips and shows frames being dropped.
+/// </summary>
+class qualityGovernor
+{
+private:
+    double frameStart = 0;
+    double lastFlip = 0;
+    double busyTime = 0;
+    double interval = 0;
+    double pressureSince = 0;
+    double headroomSince = 0;
+
+public:
+    void startFrame();
+    void endFrame(double renderEnd);
+    void getStats(char* text, int maxLen);
+
+private:
+    void changeLevel(int change);
+};
+
+#endif // _QUALITY_GOVERNOR_H_
@@ -0,0 +1,219 @@
+#include <math.h>
+#include <algorithm>
+#include "rotationCache.h"
+#include "globals.h"
+
+extern globalVars globals;
+
+// Frames from all caches, most recently used first
+static std::list<RotatedFrame> usedFrames;
+static size_t usedBytes = 0;
+
+rotationCache::rotationCache(int steps)
+{
+    this->steps = steps;
+    frames.assign(steps, usedFrames.end());
+}
+
+rotationCache::~rotationCache()
+{
+    clear();
+}
+
+/// <summary>
+/// Changes the number of steps in a turn, throwing away any frames
+/// </summary>
+void rotationCache::setSteps(int steps)
+{
+    clear();
+    this->steps = steps;
+    frames.assign(steps, usedFrames.end());
+}
+
+/// <summary>
+/// Same as al_draw_scaled_rotated_bitmap but draws the frame
+/// nearest to the angle if there is a memory budget.
+/// </summary>
+void rotationCache::draw(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle)
+{
+    if (globals.rotationCacheMB <= 0) {
+        softBlend::drawScaledRotatedBitmap(bitmap, cx, cy, dx, dy, xscale, yscale, angle, 0);
+        return;
+    }
+
+    // Frames line up with the pixels they will be drawn on
+    float fracX = dx - floor(dx);
+    float fracY = dy - floor(dy);
+
+    if (bitmap != sprite || cx != centreX || cy != centreY || xscale != xScale || yscale != yScale || fracX != subPixelX || fracY != subPixelY) {
+        clear();
+        sprite = bitmap;
+        centreX = cx;
+        centreY = cy;
+        xScale = xscale;
+        yScale = yscale;
+        subPixelX = fracX;
+        subPixelY = fracY;
+    }
+
+    // Nearest step (angle can be any number of turns either way)
+    double turns = angle / (2 * ALLEGRO_PI);
+    int step = (int)floor((turns - floor(turns)) * steps + 0.5) % steps;
+
+    RotatedFrame* frame = getFrame(step);
+    if (frame == NULL) {
+        // Too big for the budget
+        softBlend::drawScaledRotatedBitmap(bitmap, cx, cy, dx, dy, xscale, yscale, angle, 0);
+        return;
+    }
+
+    softBlend::drawBitmap(frame->bitmap, dx - frame->originX, dy - frame->originY);
+}
+
+/// <summary>
+/// Returns the frame for the step, rendering it first if it
+/// isn't cached, or NULL if it can't fit in the budget.
+/// </summary>
+RotatedFrame* rotationCache::getFrame(int step)
+{
+    if (frames[step] != usedFrames.end()) {
+        // Move to front as most recently used
+        usedFrames.splice(usedFrames.begin(), usedFrames, frames[step]);
+        frames[step]->lastUsed = globals.frameTime;
+        return &*frames[step];
+    }
+
+    // Bounding box of the scaled sprite rotated about its centre
+    double angle = step * 2 * ALLEGRO_PI / steps;
+    double cosAngle = cos(angle);
+    double sinAngle = sin(angle);
+    float width = al_get_bitmap_width(sprite);
+    float height = al_get_bitmap_height(sprite);
+    float cornerX[] = { 0, width, 0, width };
+    float cornerY[] = { 0, 0, height, height };
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+    for (int i = 0; i < 4; i++) {
+        double x = (cornerX[i] - centreX) * xScale;
+        double y = (cornerY[i] - centreY) * yScale;
+        float rotX = x * cosAngle - y * sinAngle;
+        float rotY = x * sinAngle + y * cosAngle;
+        if (i == 0 || rotX < minX) minX = rotX;
+        if (i == 0 || rotX > maxX) maxX = rotX;
+        if (i == 0 || rotY < minY) minY = rotY;
+        if (i == 0 || rotY > maxY) maxY = rotY;
+    }
+
+    // Leave a pixel spare all round for rounding
+    int frameWidth = (int)ceil(maxX - minX) + 3;
+    int frameHeight = (int)ceil(maxY - minY) + 3;
+    size_t bytes = (size_t)frameWidth * frameHeight * 4;
+    size_t budget = (size_t)globals.rotationCacheMB * 1024 * 1024;
+
+    if (bytes > budget) {
+        return NULL;
+    }
+
+    if (usedBytes + bytes > budget && !usedFrames.empty() && usedFrames.back().lastUsed == globals.frameTime) {
+        // Every cached frame has been drawn this frame so they don't all
+        // fit. Rendering this one would only throw out a frame that is
+        // needed again next time, so rotate directly instead.
+        return NULL;
+    }
+
+    RotatedFrame newFrame;
+    newFrame.owner = this;
+    newFrame.step = step;
+    newFrame.bitmap = evict(budget - bytes, frameWidth, frameHeight);
+    newFrame.originX = ceil(1 - minX) + subPixelX;
+    newFrame.originY = ceil(1 - minY) + subPixelY;
+    newFrame.bytes = bytes;
+    newFrame.lastUsed = globals.frameTime;
+
+    if (newFrame.bitmap == NULL) {
+        newFrame.bitmap = al_create_bitmap(frameWidth, frameHeight);
+    }
+
+    if (newFrame.bitmap == NULL) {
+        return NULL;
+    }
+
+    // Copy the rotated pixels exactly so drawing the frame looks the same as drawing the sprite
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    int op, src, dst;
+    al_get_blender(&op, &src, &dst);
+
+    al_set_target_bitmap(newFrame.bitmap);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    softBlend::drawScaledRotatedBitmap(sprite, centreX, centreY, newFrame.originX, newFrame.originY, xScale, yScale, angle, 0);
+
+    al_set_blender(op, src, dst);
+    al_set_target_bitmap(target);
+
+    usedFrames.push_front(newFrame);
+    usedBytes += bytes;
+    frames[step] = usedFrames.begin();
+
+    return &usedFrames.front();
+}
+
+/// <summary>
+/// Throw away least recently used frames (from any cache) until no
+/// more than maxBytes are in use. Returns the bitmap of a thrown away
+/// frame with the given size so it can be reused, or NULL if none.
+/// </summary>
+ALLEGRO_BITMAP* rotationCache::evict(size_t maxBytes, int width, int height)
+{
+    ALLEGRO_BITMAP* reuse = NULL;
+
+    while (usedBytes > maxBytes && !usedFrames.empty()) {
+        RotatedFrame* oldest = &usedFrames.back();
+        oldest->owner->frames[oldest->step] = usedFrames.end();
+        usedBytes -= oldest->bytes;
+        if (reuse == NULL && al_get_bitmap_width(oldest->bitmap) == width && al_get_bitmap_height(oldest->bitmap) == height) {
+            reuse = oldest->bitmap;
+        }
+        else {
+            al_destroy_bitmap(oldest->bitmap);
+        }
+        usedFrames.pop_back();
+    }
+
+    return reuse;
+}
+
+/// <summary>
+/// Throw away all frames in this cache
+/// </summary>
+void rotationCache::clear()
+{
+    for (auto& frame : frames) {
+        if (frame != usedFrames.end()) {
+            usedBytes -= frame->bytes;
+            al_destroy_bitmap(frame->bitmap);
+            usedFrames.erase(frame);
+            frame = usedFrames.end();
+        }
+    }
+
+    sprite = NULL;
+}
+
+/// <summary>
+/// Throw away all frames rotated from the bitmap as it is about to be
+/// destroyed and a new bitmap could be given the same address.
+/// </summary>
+void rotationCache::release(ALLEGRO_BITMAP* bitmap)
+{
+    std::vector<rotationCache*> owners;
+    for (auto& frame : usedFrames) {
+        if (frame.owner->sprite == bitmap && std::find(owners.begin(), owners.end(), frame.owner) == owners.end()) {
+            owners.push_back(frame.owner);
+        }
+    }
+
+    for (auto owner : owners) {
+        owner->clear();
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef _ROTATION_CACHE_H_
+#define _ROTATION_CACHE_H_
+
+#include <allegro5/allegro.h>
+#include <list>
+#include <vector>
+#include "softBlend.h"
+
+class rotationCache;
+
+struct RotatedFrame
+{
+    rotationCache* owner;
+    int step;
+    ALLEGRO_BITMAP* bitmap;
+    float originX;
+    float originY;
+    size_t bytes;
+    double lastUsed;
+};
+
+/// <summary>
+/// Drawing rotated bitmaps is slow without hardware GL (e.g. Raspberry Pi)
+/// so a needle or card can be drawn from frames that have already been
+/// rotated instead. The circle is split into the given number of steps
+/// and each frame is only rendered the first time its angle is needed.
+///
+/// All caches share the memory budget set in the settings file and the
+/// least recently used frames are thrown away when it runs out. With no
+/// budget, or if the frames drawn each frame don't fit in it, the sprite
+/// is simply rotated as normal.
+///
+/// The number of steps defaults to what suits each sprite but can be
+/// changed with "Rotation Steps" in the instrument's settings.
+///
+/// Use one cache per sprite (it starts again if the sprite, scale, centre
+/// or position changes, e.g. on resize) and only for sprites drawn with
+/// the normal blender as frames have transparent corners. Sprites must be
+/// released before they are destroyed (instrument::destroyBitmaps does this).
+/// </summary>
+class rotationCache
+{
+private:
+    int steps;
+    std::vector<std::list<RotatedFrame>::iterator> frames;
+    ALLEGRO_BITMAP* sprite = NULL;
+    float centreX = 0;
+    float centreY = 0;
+    float xScale = 0;
+    float yScale = 0;
+    float subPixelX = 0;
+    float subPixelY = 0;
+
+public:
+    rotationCache(int steps);
+    ~rotationCache();
+    void setSteps(int steps);
+    void draw(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle);
+    void clear();
+    static void release(ALLEGRO_BITMAP* bitmap);
+
+private:
+    RotatedFrame* getFrame(int step);
+    ALLEGRO_BITMAP* evict(size_t maxBytes, int width, int height);
+};
+
+#endif // _ROTATION_CACHE_H_
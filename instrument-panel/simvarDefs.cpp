@@ -1,191 +1,333 @@
 #include <stdio.h>
+#include <string.h>
+#include <stddef.h>
 #include "simvarDefs.h"
 
 const char* versionString = "v2.0.5";
 
-const char* SimVarDefs[][2] = {
+// Each entry maps a SimVar name to the SimVars member that holds it.
+// Entries must be in the same order as struct SimVars (checked below).
+#define SIMVAR(field, name, units) { name, units, (int)offsetof(SimVars, field), (int)sizeof(((SimVars*)0)->field) }
+
+static constexpr SimVarDef SimVarDefs[] = {
     // Vars for Jetbridge (must come first)
-    { "Apu Master Sw", "jetbridge" },
-    { "Apu Bleed", "jetbridge" },
-    { "Elec Bat1", "jetbridge" },
-    { "Elec Bat2", "jetbridge" },
-    { "Autopilot Managed Speed", "jetbridge" },
-    { "Autopilot Managed Heading", "jetbridge" },
-    { "Autopilot Managed Altitude", "jetbridge" },
-    { "Lateral Mode", "jetbridge" },
-    { "Vertical Mode", "jetbridge" },
-    { "Loc Mode", "jetbridge" },
-    { "Appr Mode", "jetbridge" },
-    { "Autothrust Mode", "jetbridge" },
-    { "Show Mach", "jetbridge" },
-    { "Autobrake Armed", "jetbridge" },
-    { "Pitch Trim", "jetbridge" },
-    { "Tcas Mode", "jetbridge" },
-    { "SwitchBox Encoder 1", "jetbridge" },
-    { "SwitchBox Encoder 2", "jetbridge" },
-    { "SwitchBox Encoder 3", "jetbridge" },
-    { "SwitchBox Encoder 4", "jetbridge" },
-    { "SwitchBox Button 1", "jetbridge" },
-    { "SwitchBox Button 2", "jetbridge" },
-    { "SwitchBox Button 3", "jetbridge" },
-    { "SwitchBox Button 4", "jetbridge" },
-    { "SwitchBox Button 5", "jetbridge" },
-    { "SwitchBox Button 6", "jetbridge" },
-    { "SwitchBox Button 7", "jetbridge" },
-    { "SwitchBox Mode", "jetbridge" },
-    { "SwitchBox Park Brake", "jetbridge" },
+    SIMVAR(apuMasterSw, "Apu Master Sw", "jetbridge"),
+    SIMVAR(apuBleed, "Apu Bleed", "jetbridge"),
+    SIMVAR(elecBat1, "Elec Bat1", "jetbridge"),
+    SIMVAR(elecBat2, "Elec Bat2", "jetbridge"),
+    SIMVAR(jbManagedSpeed, "Autopilot Managed Speed", "jetbridge"),
+    SIMVAR(jbManagedHeading, "Autopilot Managed Heading", "jetbridge"),
+    SIMVAR(jbManagedAltitude, "Autopilot Managed Altitude", "jetbridge"),
+    SIMVAR(jbLateralMode, "Lateral Mode", "jetbridge"),
+    SIMVAR(jbVerticalMode, "Vertical Mode", "jetbridge"),
+    SIMVAR(jbLocMode, "Loc Mode", "jetbridge"),
+    SIMVAR(jbApprMode, "Appr Mode", "jetbridge"),
+    SIMVAR(jbAutothrustMode, "Autothrust Mode", "jetbridge"),
+    SIMVAR(jbShowMach, "Show Mach", "jetbridge"),
+    SIMVAR(jbAutobrake, "Autobrake Armed", "jetbridge"),
+    SIMVAR(jbPitchTrim, "Pitch Trim", "jetbridge"),
+    SIMVAR(jbTcasMode, "Tcas Mode", "jetbridge"),
+    SIMVAR(sbEncoder[0], "SwitchBox Encoder 1", "jetbridge"),
+    SIMVAR(sbEncoder[1], "SwitchBox Encoder 2", "jetbridge"),
+    SIMVAR(sbEncoder[2], "SwitchBox Encoder 3", "jetbridge"),
+    SIMVAR(sbEncoder[3], "SwitchBox Encoder 4", "jetbridge"),
+    SIMVAR(sbButton[0], "SwitchBox Button 1", "jetbridge"),
+    SIMVAR(sbButton[1], "SwitchBox Button 2", "jetbridge"),
+    SIMVAR(sbButton[2], "SwitchBox Button 3", "jetbridge"),
+    SIMVAR(sbButton[3], "SwitchBox Button 4", "jetbridge"),
+    SIMVAR(sbButton[4], "SwitchBox Button 5", "jetbridge"),
+    SIMVAR(sbButton[5], "SwitchBox Button 6", "jetbridge"),
+    SIMVAR(sbButton[6], "SwitchBox Button 7", "jetbridge"),
+    SIMVAR(sbMode, "SwitchBox Mode", "jetbridge"),
+    SIMVAR(sbParkBrake, "SwitchBox Park Brake", "jetbridge"),
 
     // Vars required for all panels (screensaver, aircraft identification etc.)
-    { "Title", "string32" },
-    { "Estimated Cruise Speed", "knots" },
-    { "Electrical Main Bus Voltage", "volts" },
-    { "Electrical Battery Load", "amperes" },
+    SIMVAR(aircraft, "Title", "string32"),
+    SIMVAR(cruiseSpeed, "Estimated Cruise Speed", "knots"),
+    SIMVAR(dcVolts, "Electrical Main Bus Voltage", "volts"),
+    SIMVAR(batteryLoad, "Electrical Battery Load", "amperes"),
 
     // Vars for Power/Lights panel
-    { "Light On States", "mask" },
-    { "Flaps Num Handle Positions", "number" },
-    { "Flaps Handle Index", "number" },
-    { "Brake Parking Position", "bool" },
-    { "Pushback State", "enum" },
-    { "Apu Switch", "bool" },
-    { "Apu Pct Rpm", "percent" },
+    SIMVAR(lightStates, "Light On States", "mask"),
+    SIMVAR(tfFlapsCount, "Flaps Num Handle Positions", "number"),
+    SIMVAR(tfFlapsIndex, "Flaps Handle Index", "number"),
+    SIMVAR(parkingBrakeOn, "Brake Parking Position", "bool"),
+    SIMVAR(pushbackState, "Pushback State", "enum"),
+    SIMVAR(apuStartSwitch, "Apu Switch", "bool"),
+    SIMVAR(apuPercentRpm, "Apu Pct Rpm", "percent"),
 
     // Vars for Radio panel
-    { "Com Status:1", "enum" },
-    { "Com Transmit:1", "bool" },
-    { "Com Active Frequency:1", "mhz" },
-    { "Com Standby Frequency:1", "mhz" },
-    { "Nav Active Frequency:1", "mhz" },
-    { "Nav Standby Frequency:1", "mhz" },
-    { "Com Status:2", "enum" },
-    { "Com Transmit:2", "bool" },
-    { "Com Active Frequency:2", "mhz" },
-    { "Com Standby Frequency:2", "mhz" },
-    { "Nav Active Frequency:2", "mhz" },
-    { "Nav Standby Frequency:2", "mhz" },
-    { "Com Receive:1", "bool" },
-    { "Com Receive:2", "bool" },
-    { "Adf Active Frequency:1", "khz" },
-    { "Adf Standby Frequency:1", "khz" },
-    { "Com Volume:1", "percent" },
-    { "Com Volume:2", "percent" },
-    { "Cabin Seatbelts Alert Switch", "bool" },
-    { "Transponder State:1", "enum" },
-    { "Transponder Code:1", "bco16" },
+    SIMVAR(com1Status, "Com Status:1", "enum"),
+    SIMVAR(com1Transmit, "Com Transmit:1", "bool"),
+    SIMVAR(com1Freq, "Com Active Frequency:1", "mhz"),
+    SIMVAR(com1Standby, "Com Standby Frequency:1", "mhz"),
+    SIMVAR(nav1Freq, "Nav Active Frequency:1", "mhz"),
+    SIMVAR(nav1Standby, "Nav Standby Frequency:1", "mhz"),
+    SIMVAR(com2Status, "Com Status:2", "enum"),
+    SIMVAR(com2Transmit, "Com Transmit:2", "bool"),
+    SIMVAR(com2Freq, "Com Active Frequency:2", "mhz"),
+    SIMVAR(com2Standby, "Com Standby Frequency:2", "mhz"),
+    SIMVAR(nav2Freq, "Nav Active Frequency:2", "mhz"),
+    SIMVAR(nav2Standby, "Nav Standby Frequency:2", "mhz"),
+    SIMVAR(com1Receive, "Com Receive:1", "bool"),
+    SIMVAR(com2Receive, "Com Receive:2", "bool"),
+    SIMVAR(adfFreq, "Adf Active Frequency:1", "khz"),
+    SIMVAR(adfStandby, "Adf Standby Frequency:1", "khz"),
+    SIMVAR(com1Volume, "Com Volume:1", "percent"),
+    SIMVAR(com2Volume, "Com Volume:2", "percent"),
+    SIMVAR(seatBeltsSwitch, "Cabin Seatbelts Alert Switch", "bool"),
+    SIMVAR(transponderState, "Transponder State:1", "enum"),
+    SIMVAR(transponderCode, "Transponder Code:1", "bco16"),
 
     // Vars for Autopilot panel
-    { "Indicated Altitude", "feet" },
-    { "Airspeed Indicated", "knots" },
-    { "Airspeed Mach", "mach" },
-    { "Plane Heading Degrees Magnetic", "degrees" },
-    { "Vertical Speed", "feet per second" },
-    { "Autopilot Available", "bool" },
-    { "Autopilot Master", "bool" },
-    { "Autopilot Flight Director Active", "bool" },
-    { "Autopilot Heading Lock Dir", "degrees" },
-    { "Autopilot Heading Lock", "bool" },
-    { "Autopilot Heading Slot Index", "number" },
-    { "Autopilot Wing Leveler", "bool" },
-    { "Autopilot Altitude Lock Var", "feet" },
-    { "Autopilot Altitude Lock Var:3", "feet" },
-    { "Autopilot Altitude Lock", "bool" },
-    { "Autopilot Nav1 Lock", "bool" },
-    { "Gps Drives Nav1", "bool" },
-    { "Autopilot Pitch Hold", "bool" },
-    { "Autopilot Vertical Hold Var", "feet/minute" },
-    { "Autopilot Vertical Hold", "bool" },
-    { "Autopilot VS Slot Index", "number" },
-    { "Autopilot Airspeed Hold Var", "knots" },
-    { "Autopilot Mach Hold Var", "number" },
-    { "Autopilot Airspeed Hold", "bool" },
-    { "Autopilot Approach Hold", "bool" },
-    { "Autopilot Glideslope Hold", "bool" },
-    { "General Eng Throttle Lever Position:1", "percent" },
-    { "Autothrottle Active", "bool" },
+    SIMVAR(altAltitude, "Indicated Altitude", "feet"),
+    SIMVAR(asiAirspeed, "Airspeed Indicated", "knots"),
+    SIMVAR(asiMachSpeed, "Airspeed Mach", "mach"),
+    SIMVAR(hiHeading, "Plane Heading Degrees Magnetic", "degrees"),
+    SIMVAR(vsiVerticalSpeed, "Vertical Speed", "feet per second"),
+    SIMVAR(autopilotAvailable, "Autopilot Available", "bool"),
+    SIMVAR(autopilotEngaged, "Autopilot Master", "bool"),
+    SIMVAR(flightDirectorActive, "Autopilot Flight Director Active", "bool"),
+    SIMVAR(autopilotHeading, "Autopilot Heading Lock Dir", "degrees"),
+    SIMVAR(autopilotHeadingLock, "Autopilot Heading Lock", "bool"),
+    SIMVAR(autopilotHeadingSlotIndex, "Autopilot Heading Slot Index", "number"),
+    SIMVAR(autopilotLevel, "Autopilot Wing Leveler", "bool"),
+    SIMVAR(autopilotAltitude, "Autopilot Altitude Lock Var", "feet"),
+    SIMVAR(autopilotAltitude3, "Autopilot Altitude Lock Var:3", "feet"),
+    SIMVAR(autopilotAltLock, "Autopilot Altitude Lock", "bool"),
+    SIMVAR(autopilotNav1Lock, "Autopilot Nav1 Lock", "bool"),
+    SIMVAR(gpsDrivesNav1, "Gps Drives Nav1", "bool"),
+    SIMVAR(autopilotPitchHold, "Autopilot Pitch Hold", "bool"),
+    SIMVAR(autopilotVerticalSpeed, "Autopilot Vertical Hold Var", "feet/minute"),
+    SIMVAR(autopilotVerticalHold, "Autopilot Vertical Hold", "bool"),
+    SIMVAR(autopilotVsSlotIndex, "Autopilot VS Slot Index", "number"),
+    SIMVAR(autopilotAirspeed, "Autopilot Airspeed Hold Var", "knots"),
+    SIMVAR(autopilotMach, "Autopilot Mach Hold Var", "number"),
+    SIMVAR(autopilotAirspeedHold, "Autopilot Airspeed Hold", "bool"),
+    SIMVAR(autopilotApproachHold, "Autopilot Approach Hold", "bool"),
+    SIMVAR(autopilotGlideslopeHold, "Autopilot Glideslope Hold", "bool"),
+    SIMVAR(throttlePosition, "General Eng Throttle Lever Position:1", "percent"),
+    SIMVAR(autothrottleActive, "Autothrottle Active", "bool"),
 
     // Remaining vars for Instrument panel
-    { "Kohlsman Setting Hg", "inHg" },
-    { "Attitude Indicator Pitch Degrees", "degrees" },
-    { "Attitude Indicator Bank Degrees", "degrees" },
-    { "Airspeed True", "knots" },
-    { "Airspeed True Calibrate", "degrees" },
-    { "Plane Heading Degrees True", "degrees" },
-    { "Plane Alt Above Ground", "feet" },
-    { "Turn Indicator Rate", "degrees per second" },
-    { "Turn Coordinator Ball", "position" },
-    { "Elevator Trim Position", "degrees" },
-    { "Rudder Trim Pct", "percent" },
-    { "Spoilers Handle Position", "percent" },
-    { "Auto Brake Switch Cb", "number" },
-    { "Zulu Time", "seconds" },
-    { "Local Time", "seconds" },
-    { "Absolute Time", "seconds" },
-    { "Ambient Temperature", "celsius" },
-    { "Number Of Engines", "number" },
-    { "General Eng Rpm:1", "rpm" },
-    { "Eng Rpm Animation Percent:1", "percent" },
-    { "General Eng Elapsed Time:1", "hours" },
-    { "Fuel Total Capacity", "gallons" },
-    { "Fuel Total Quantity", "gallons" },
-    { "Fuel Tank Left Main Level", "percent" },
-    { "Fuel Tank Right Main Level", "percent" },
-    { "Nav Obs:1", "degrees" },
-    { "Nav Radial Error:1", "degrees" },
-    { "Nav Glide Slope Error:1", "degrees" },
-    { "Nav ToFrom:1", "enum" },
-    { "Nav Gs Flag:1", "bool" },
-    { "Nav Obs:2", "degrees" },
-    { "Nav Radial Error:2", "degrees" },
-    { "Nav ToFrom:2", "enum" },
-    { "Nav Has Localizer:1", "bool" },
-    { "Nav Localizer:1", "degrees" },
-    { "Gps Wp Cross Trk", "meters" },
-    { "Adf Radial:1", "degrees" },
-    { "Adf Card", "degrees" },
-    { "Is Gear Retractable", "bool" },
-    { "Gear Left Position", "percent" },
-    { "Gear Center Position", "percent" },
-    { "Gear Right Position", "percent" },
-    { "Rudder Position", "position" },
-    { "Brake Left Position", "percent" },
-    { "Brake Right Position", "percent" },
-    { "General Eng Oil Temperature:1", "fahrenheit" },
-    { "General Eng Oil Temperature:2", "fahrenheit" },
-    { "General Eng Oil Temperature:3", "fahrenheit" },
-    { "General Eng Oil Temperature:4", "fahrenheit" },
-    { "General Eng Oil Pressure:1", "psi" },
-    { "General Eng Oil Pressure:2", "psi" },
-    { "General Eng Oil Pressure:3", "psi" },
-    { "General Eng Oil Pressure:4", "psi" },
-    { "General Eng Exhaust Gas Temperature:1", "celsius" },
-    { "General Eng Exhaust Gas Temperature:2", "celsius" },
-    { "General Eng Exhaust Gas Temperature:3", "celsius" },
-    { "General Eng Exhaust Gas Temperature:4", "celsius" },
-    { "Engine Type", "enum" },
-    { "Max Rated Engine RPM", "rpm" },
-    { "Turb Eng N1:1", "percent" },
-    { "Turb Eng N1:2", "percent" },
-    { "Turb Eng N1:3", "percent" },
-    { "Turb Eng N1:4", "percent" },
-    { "Prop RPM:1", "rpm" },
-    { "Eng Manifold Pressure:1", "inches of mercury" },
-    { "Eng Fuel Flow GPH:1", "gallons per hour" },
-    { "Eng Fuel Flow GPH:2", "gallons per hour" },
-    { "Eng Fuel Flow GPH:3", "gallons per hour" },
-    { "Eng Fuel Flow GPH:4", "gallons per hour" },
-    { "Suction Pressure", "inches of mercury" },
-    { "Sim On Ground", "bool" },
-    { "G Force", "gforce"},
-    { "Atc Id", "string32" },
-    { "Atc Airline", "string32" },
-    { "Atc Flight Number", "string32" },
-    { "Atc Heavy", "bool" },
+    SIMVAR(altKollsman, "Kohlsman Setting Hg", "inHg"),
+    SIMVAR(adiPitch, "Attitude Indicator Pitch Degrees", "degrees"),
+    SIMVAR(adiBank, "Attitude Indicator Bank Degrees", "degrees"),
+    SIMVAR(asiTrueSpeed, "Airspeed True", "knots"),
+    SIMVAR(asiAirspeedCal, "Airspeed True Calibrate", "degrees"),
+    SIMVAR(hiHeadingTrue, "Plane Heading Degrees True", "degrees"),
+    SIMVAR(altAboveGround, "Plane Alt Above Ground", "feet"),
+    SIMVAR(tcRate, "Turn Indicator Rate", "degrees per second"),
+    SIMVAR(tcBall, "Turn Coordinator Ball", "position"),
+    SIMVAR(tfElevatorTrim, "Elevator Trim Position", "degrees"),
+    SIMVAR(tfRudderTrim, "Rudder Trim Pct", "percent"),
+    SIMVAR(tfSpoilersPosition, "Spoilers Handle Position", "percent"),
+    SIMVAR(tfAutoBrake, "Auto Brake Switch Cb", "number"),
+    SIMVAR(dcUtcSeconds, "Zulu Time", "seconds"),
+    SIMVAR(dcLocalSeconds, "Local Time", "seconds"),
+    SIMVAR(dcFlightSeconds, "Absolute Time", "seconds"),
+    SIMVAR(dcTempC, "Ambient Temperature", "celsius"),
+    SIMVAR(numberOfEngines, "Number Of Engines", "number"),
+    SIMVAR(rpmEngine, "General Eng Rpm:1", "rpm"),
+    SIMVAR(rpmPercent, "Eng Rpm Animation Percent:1", "percent"),
+    SIMVAR(rpmElapsedTime, "General Eng Elapsed Time:1", "hours"),
+    SIMVAR(fuelCapacity, "Fuel Total Capacity", "gallons"),
+    SIMVAR(fuelQuantity, "Fuel Total Quantity", "gallons"),
+    SIMVAR(fuelLeftPercent, "Fuel Tank Left Main Level", "percent"),
+    SIMVAR(fuelRightPercent, "Fuel Tank Right Main Level", "percent"),
+    SIMVAR(vor1Obs, "Nav Obs:1", "degrees"),
+    SIMVAR(vor1RadialError, "Nav Radial Error:1", "degrees"),
+    SIMVAR(vor1GlideSlopeError, "Nav Glide Slope Error:1", "degrees"),
+    SIMVAR(vor1ToFrom, "Nav ToFrom:1", "enum"),
+    SIMVAR(vor1GlideSlopeFlag, "Nav Gs Flag:1", "bool"),
+    SIMVAR(vor2Obs, "Nav Obs:2", "degrees"),
+    SIMVAR(vor2RadialError, "Nav Radial Error:2", "degrees"),
+    SIMVAR(vor2ToFrom, "Nav ToFrom:2", "enum"),
+    SIMVAR(navHasLocalizer, "Nav Has Localizer:1", "bool"),
+    SIMVAR(navLocalizer, "Nav Localizer:1", "degrees"),
+    SIMVAR(gpsWpCrossTrk, "Gps Wp Cross Trk", "meters"),
+    SIMVAR(adfRadial, "Adf Radial:1", "degrees"),
+    SIMVAR(adfCard, "Adf Card", "degrees"),
+    SIMVAR(gearRetractable, "Is Gear Retractable", "bool"),
+    SIMVAR(gearLeftPos, "Gear Left Position", "percent"),
+    SIMVAR(gearCentrePos, "Gear Center Position", "percent"),
+    SIMVAR(gearRightPos, "Gear Right Position", "percent"),
+    SIMVAR(rudderPosition, "Rudder Position", "position"),
+    SIMVAR(brakeLeftPedal, "Brake Left Position", "percent"),
+    SIMVAR(brakeRightPedal, "Brake Right Position", "percent"),
+    SIMVAR(oilTemp1, "General Eng Oil Temperature:1", "fahrenheit"),
+    SIMVAR(oilTemp2, "General Eng Oil Temperature:2", "fahrenheit"),
+    SIMVAR(oilTemp3, "General Eng Oil Temperature:3", "fahrenheit"),
+    SIMVAR(oilTemp4, "General Eng Oil Temperature:4", "fahrenheit"),
+    SIMVAR(oilPressure1, "General Eng Oil Pressure:1", "psi"),
+    SIMVAR(oilPressure2, "General Eng Oil Pressure:2", "psi"),
+    SIMVAR(oilPressure3, "General Eng Oil Pressure:3", "psi"),
+    SIMVAR(oilPressure4, "General Eng Oil Pressure:4", "psi"),
+    SIMVAR(exhaustGasTemp1, "General Eng Exhaust Gas Temperature:1", "celsius"),
+    SIMVAR(exhaustGasTemp2, "General Eng Exhaust Gas Temperature:2", "celsius"),
+    SIMVAR(exhaustGasTemp3, "General Eng Exhaust Gas Temperature:3", "celsius"),
+    SIMVAR(exhaustGasTemp4, "General Eng Exhaust Gas Temperature:4", "celsius"),
+    SIMVAR(engineType, "Engine Type", "enum"),
+    SIMVAR(engineMaxRpm, "Max Rated Engine RPM", "rpm"),
+    SIMVAR(turbineEngine1N1, "Turb Eng N1:1", "percent"),
+    SIMVAR(turbineEngine2N1, "Turb Eng N1:2", "percent"),
+    SIMVAR(turbineEngine3N1, "Turb Eng N1:3", "percent"),
+    SIMVAR(turbineEngine4N1, "Turb Eng N1:4", "percent"),
+    SIMVAR(propRpm, "Prop RPM:1", "rpm"),
+    SIMVAR(engineManifoldPressure, "Eng Manifold Pressure:1", "inches of mercury"),
+    SIMVAR(engineFuelFlow1, "Eng Fuel Flow GPH:1", "gallons per hour"),
+    SIMVAR(engineFuelFlow2, "Eng Fuel Flow GPH:2", "gallons per hour"),
+    SIMVAR(engineFuelFlow3, "Eng Fuel Flow GPH:3", "gallons per hour"),
+    SIMVAR(engineFuelFlow4, "Eng Fuel Flow GPH:4", "gallons per hour"),
+    SIMVAR(suctionPressure, "Suction Pressure", "inches of mercury"),
+    SIMVAR(onGround, "Sim On Ground", "bool"),
+    SIMVAR(gForce, "G Force", "gforce"),
+    SIMVAR(atcTailNumber, "Atc Id", "string32"),
+    SIMVAR(atcCallSign, "Atc Airline", "string32"),
+    SIMVAR(atcFlightNumber, "Atc Flight Number", "string32"),
+    SIMVAR(atcHeavy, "Atc Heavy", "bool"),
     // Internal variables must come last
-    { "Landing Rate", "internal" },
-    { "Skytrack State", "internal" },
-    { NULL, NULL }
+    SIMVAR(landingRate, "Landing Rate", "internal"),
+    SIMVAR(skytrackState, "Skytrack State", "internal")
+};
+
+static constexpr int SimVarCount = sizeof(SimVarDefs) / sizeof(SimVarDefs[0]);
+static constexpr int HashSize = 512;    // Power of 2 and at least twice SimVarCount
+
+enum SlotType {
+    SLOT_NONE,
+    SLOT_DOUBLE,
+    SLOT_STRING
 };
 
+struct NameIndex
+{
+    short entry[HashSize];
+    int duplicates;
+};
+
+struct SlotMap
+{
+    unsigned char type[SimVarSlots];
+};
+
+static constexpr bool sameName(const char* name1, const char* name2)
+{
+    while (*name1 && *name1 == *name2) {
+        name1++;
+        name2++;
+    }
+    return *name1 == *name2;
+}
+
+static constexpr unsigned int hashName(const char* name)
+{
+    // FNV-1a
+    unsigned int hash = 2166136261u;
+    while (*name) {
+        hash = (hash ^ (unsigned char)*name++) * 16777619u;
+    }
+    return hash;
+}
+
+/// <summary>
+/// Returns the index of the first entry that doesn't follow on from the
+/// previous one in struct SimVars, SimVarCount if the last entry doesn't
+/// finish at the end of the struct or -1 if the whole table is good.
+/// </summary>
+static constexpr int firstLayoutError()
+{
+    int expected = sizeof(double);  // connected
+    for (int i = 0; i < SimVarCount; i++) {
+        int size = sameName(SimVarDefs[i].units, "string32") ? 32 : sizeof(double);
+        if (SimVarDefs[i].offset != expected || SimVarDefs[i].size != size) {
+            return i;
+        }
+        expected += size;
+    }
+
+    return expected == sizeof(SimVars) ? -1 : SimVarCount;
+}
+
+/// <summary>
+/// Builds an open addressing hash table of SimVar names
+/// </summary>
+static constexpr NameIndex buildNameIndex()
+{
+    NameIndex index = {};
+    for (int i = 0; i < HashSize; i++) {
+        index.entry[i] = -1;
+    }
+
+    for (int i = 0; i < SimVarCount; i++) {
+        unsigned int pos = hashName(SimVarDefs[i].name) & (HashSize - 1);
+        while (index.entry[pos] != -1) {
+            if (sameName(SimVarDefs[index.entry[pos]].name, SimVarDefs[i].name)) {
+                index.duplicates++;
+            }
+            pos = (pos + 1) & (HashSize - 1);
+        }
+        index.entry[pos] = (short)i;
+    }
+
+    return index;
+}
+
+/// <summary>
+/// Records what each double sized slot of struct SimVars holds so
+/// that offsets received from the server can be validated.
+/// </summary>
+static constexpr SlotMap buildSlotMap()
+{
+    SlotMap slots = {};
+    slots.type[0] = SLOT_DOUBLE;    // connected
+
+    for (int i = 0; i < SimVarCount; i++) {
+        int slot = SimVarDefs[i].offset / sizeof(double);
+        slots.type[slot] = SimVarDefs[i].size == sizeof(double) ? SLOT_DOUBLE : SLOT_STRING;
+    }
+
+    return slots;
+}
+
+static_assert(HashSize >= SimVarCount * 2, "HashSize must be increased");
+static_assert(firstLayoutError() == -1, "SimVarDefs must be in the same order as struct SimVars and cover every member");
+
+static constexpr NameIndex nameIndex = buildNameIndex();
+static_assert(nameIndex.duplicates == 0, "SimVarDefs contains a duplicate name");
+
+static constexpr SlotMap slotMap = buildSlotMap();
+
+/// <summary>
+/// Returns the definition of the named SimVar or NULL if it doesn't exist
+/// </summary>
+const SimVarDef* findSimVar(const char* name)
+{
+    unsigned int pos = hashName(name) & (HashSize - 1);
+    while (nameIndex.entry[pos] != -1) {
+        const SimVarDef* def = &SimVarDefs[nameIndex.entry[pos]];
+        if (strcmp(def->name, name) == 0) {
+            return def;
+        }
+        pos = (pos + 1) & (HashSize - 1);
+    }
+
+    return NULL;
+}
+
+/// <summary>
+/// Returns true if a delta received from the server refers to the
+/// start of a SimVar of the correct type. Offset is in bytes.
+/// </summary>
+bool isValidDelta(int offset, bool isString)
+{
+    if (offset < 0 || offset % sizeof(double) != 0 || offset / sizeof(double) >= SimVarSlots) {
+        return false;
+    }
+
+    return slotMap.type[offset / sizeof(double)] == (isString ? SLOT_STRING : SLOT_DOUBLE);
+}
+
 WriteEvent WriteEvents[] = {
     { SIM_START, "DUMMY" },
     { KEY_CABIN_SEATBELTS_ALERT_SWITCH_TOGGLE, "CABIN_SEATBELTS_ALERT_SWITCH_TOGGLE" },
@@ -424,4 +424,17 @@ struct DeltaString {
     char data[32];
 };
 
+struct SimVarDef {
+    const char* name;
+    const char* units;
+    int offset;     // Bytes from start of SimVars
+    int size;       // Bytes (strings are 32)
+};
+
+// Number of doubles in SimVars (a string32 takes 4)
+const int SimVarSlots = sizeof(SimVars) / sizeof(double);
+
+const SimVarDef* findSimVar(const char* name);
+bool isValidDelta(int offset, bool isString);
+
 #endif // _SIMVARDEFS_H_
@@ -1,11 +1,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <allegro5/allegro.h>
 #ifdef _WIN32
 #include <WS2tcpip.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
 #endif
 #include "simvars.h"
+#include "jsonParser.h"
+#include "latency.h"
+#include "aircraftRegistry.h"
 
 const char *DataLinkGroup = "Data Link";
 const char *DataLinkHost = "Host";
@@ -18,8 +26,16 @@ const char* MonitorWidth = "Width";
 const char* MonitorHeight = "Height";
 const char* MonitorPositionX = "PositionX";
 const char* MonitorPositionY = "PositionY";
+const char* MonitorRotationCache = "Rotation Cache MB";
+const char* MonitorSoftwareCompositing = "Software Compositing";
+const int MaxRotationCacheMB = 1024;
+const char* RotationSteps = "Rotation Steps";
+const int MaxRotationSteps = 3600;
+const char* KnobsGroup = "Knobs";
+const char* KnobsVirtual = "Virtual";
+const char* KnobsRecord = "Record";
+const char* ProfilesGroup = "Profiles";
 
-extern const char* SimVarDefs[][2];
 bool prevConnected = false;
 int dataSize;
 Request request;
@@ -27,6 +43,7 @@ char deltaData[8192];
 int nextFull = 0;
 
 void dataLink(simvars*);
+void settingsWatcher(simvars*);
 void identifyAircraft(char* aircraft);
 void receiveDelta(char* deltaData, int deltaSize, char* simVarsPtr);
 void showError(const char* msg);
@@ -48,11 +65,19 @@ simvars::simvars(const char *customSettings)
 
     // Start data link thread
     dataLinkThread = new std::thread(dataLink, this);
+
+    // Start settings file watcher thread
+    settingsWatcherThread = new std::thread(settingsWatcher, this);
 }
 
 simvars::~simvars()
 {
-    if (strlen(globals.error) == 0) {
+    if (settingsWatcherThread) {
+        // Wait for thread to exit so saving settings doesn't trigger a reload
+        settingsWatcherThread->join();
+    }
+
+    if (strlen(globals.error) == 0 && settingsValid) {
         saveSettings();
     }
 
@@ -62,150 +87,604 @@ simvars::~simvars()
     }
 }
 
+/// <summary>
+/// Collects the position, size and enabled state of each instrument.
+/// Instruments in the base layout are at level 1 and instruments in
+/// a profile are at level 3, i.e. "Profiles": { "name": { ... } }
+/// </summary>
+class layoutHandler : public jsonHandler
+{
+private:
+    simvars* thisPtr;
+    std::vector<LayoutSetting>* layout;
+    std::vector<LayoutProfile>* profiles;
+    LayoutSetting setting;
+    bool inProfiles = false;
+    bool inGroup = false;
+    int found = 0;
+
+public:
+    layoutHandler(simvars* thisPtr, std::vector<LayoutSetting>* layout, std::vector<LayoutProfile>* profiles)
+    {
+        this->thisPtr = thisPtr;
+        this->layout = layout;
+        this->profiles = profiles;
+    }
+
+    void startObject(int level, const char* key)
+    {
+        if (level == 1 && _stricmp(key, ProfilesGroup) == 0) {
+            inProfiles = true;
+            return;
+        }
+
+        if (inProfiles && level == 2) {
+            LayoutProfile profile;
+            strncpy(profile.name, key, 255);
+            profile.name[255] = '\0';
+            profiles->push_back(profile);
+            return;
+        }
+
+        if (level == groupLevel()) {
+            memset(&setting, 0, sizeof(setting));
+            strncpy(setting.name, key, 255);
+            inGroup = inProfiles || (layout != NULL && _stricmp(key, DataLinkGroup) != 0 &&
+                _stricmp(key, MonitorGroup) != 0 && _stricmp(key, KnobsGroup) != 0);
+            found = 0;
+        }
+    }
+
+    void endObject(int level, const char* key)
+    {
+        if (inProfiles && level == 1) {
+            inProfiles = false;
+            return;
+        }
+
+        if (inGroup && level == groupLevel()) {
+            // Only use position if all of it is supplied
+            setting.hasPosition = (found == 7);
+            if (inProfiles) {
+                profiles->back().layout.push_back(setting);
+            }
+            else {
+                layout->push_back(setting);
+            }
+            inGroup = false;
+        }
+    }
+
+    void value(int level, const char* key, const char* value, JsonType type)
+    {
+        if (!inGroup || level != groupLevel() + 1) {
+            return;
+        }
+
+        switch (thisPtr->settingIndex(key)) {
+        case 0:
+            setting.x = thisPtr->settingValue(value);
+            found |= 1;
+            break;
+        case 1:
+            setting.y = thisPtr->settingValue(value);
+            found |= 2;
+            break;
+        case 2:
+            setting.size = thisPtr->settingValue(value);
+            found |= 4;
+            break;
+        case 3:
+            setting.enabled = (thisPtr->settingValue(value) == 1);
+            break;
+        }
+    }
+
+private:
+    int groupLevel()
+    {
+        return inProfiles ? 3 : 1;
+    }
+};
+
+/// <summary>
+/// Passes each setting to simvars as it is parsed from the JSON file.
+/// Groups are at level 1 and their settings at level 2. Profiles are
+/// passed to a layout handler.
+/// </summary>
+class settingsHandler : public jsonHandler
+{
+private:
+    simvars* thisPtr;
+    layoutHandler profileHandler;
+    bool inProfiles = false;
+    char group[256] = { '\0' };
+
+public:
+    settingsHandler(simvars* thisPtr) : profileHandler(thisPtr, NULL, &thisPtr->profiles)
+    {
+        this->thisPtr = thisPtr;
+    }
+
+    void startObject(int level, const char* key)
+    {
+        if (level == 1 && _stricmp(key, ProfilesGroup) == 0) {
+            inProfiles = true;
+        }
+
+        if (inProfiles) {
+            profileHandler.startObject(level, key);
+        }
+        else if (level == 1) {
+            strncpy(group, key, 255);
+            group[255] = '\0';
+        }
+    }
+
+    void endObject(int level, const char* key)
+    {
+        if (inProfiles) {
+            profileHandler.endObject(level, key);
+            inProfiles = (level > 1);
+        }
+        else if (level == 1) {
+            group[0] = '\0';
+        }
+    }
+
+    void value(int level, const char* key, const char* value, JsonType type)
+    {
+        if (inProfiles) {
+            profileHandler.value(level, key, value, type);
+        }
+        else if (level == 2 && group[0] != '\0') {
+            thisPtr->loadSetting(group, key, value);
+        }
+    }
+};
+
+/// <summary>
+/// Describes where the settings file failed to parse. The path is left
+/// out if the message would be too long to show.
+/// </summary>
+static void parseError(char* msg, int size, const char* settingsFile, const jsonParser* parser)
+{
+    int len = snprintf(msg, size, "Settings file %s line %d column %d: %s", settingsFile, parser->line, parser->column, parser->error);
+    if (len < 0 || len >= size) {
+        // Drop the path rather than what is wrong
+        snprintf(msg, size, "Settings file line %d column %d: %.180s", parser->line, parser->column, parser->error);
+    }
+}
+
 void simvars::loadSettings()
 {
     // Load settings from JSON file
-    static char buf[16384] = { '\0' };
+    groupCount = 0;
+    profiles.clear();
+    knobSettings.clear();
+    rotationSteps.clear();
 
-    // Read file in a single chunk
     FILE* infile = fopen(settingsFile, "r");
-    if (infile) {
-        int bytes = (int)fread(buf, 1, 16384, infile);
-        buf[bytes] = '\0';
-        fclose(infile);
+    if (!infile) {
+        printf("Settings file %s not found\n", settingsFile);
+        return;
+    }
+
+    jsonParser parser;
+    settingsHandler handler(this);
+    if (!parser.parse(infile, &handler)) {
+        // Don't overwrite the user's file with partial settings on exit
+        settingsValid = false;
+
+        char msg[256];
+        parseError(msg, sizeof(msg), settingsFile, &parser);
+        showError(msg);
+    }
+
+    fclose(infile);
+}
+
+/// <summary>
+/// Store a single setting read from the settings file
+/// </summary>
+void simvars::loadSetting(const char* group, const char* name, const char* value)
+{
+    if (name[0] == '\0' || value[0] == '\0' || strcmp(name, "Centre") == 0) {
+        return;
+    }
+
+    if (strlen(value) > 63) {
+        snprintf(globals.error, sizeof(globals.error), "Settings file group %s attribute %s value is too long", group, name);
+        return;
+    }
+
+    if (_stricmp(group, DataLinkGroup) == 0) {
+        if (_stricmp(name, DataLinkHost) == 0) {
+            strcpy(globals.dataLinkHost, value);
+        }
+        else if (_stricmp(name, DataLinkPort) == 0) {
+            globals.dataLinkPort = settingValue(value);
+        }
+        else if (_stricmp(name, DataRateFps) == 0) {
+            globals.dataRateFps = settingValue(value);
+        }
+    }
+    else if (_stricmp(group, MonitorGroup) == 0) {
+        if (_stricmp(name, MonitorStartOn) == 0) {
+            globals.startOnMonitor = atoi(value);
+        }
+        else if (_stricmp(name, MonitorFullscreen) == 0) {
+            globals.monitorFullscreen = settingValue(value);
+        }
+        else if (_stricmp(name, MonitorWidth) == 0) {
+            globals.monitorWidth = atoi(value);
+        }
+        else if (_stricmp(name, MonitorHeight) == 0) {
+            globals.monitorHeight = atoi(value);
+        }
+        else if (_stricmp(name, MonitorPositionX) == 0) {
+            globals.monitorPositionX = atoi(value);
+        }
+        else if (_stricmp(name, MonitorPositionY) == 0) {
+            globals.monitorPositionY = atoi(value);
+        }
+        else if (_stricmp(name, MonitorRotationCache) == 0) {
+            // Cache sizes are counted in bytes so keep them well within range
+            globals.rotationCacheMB = atoi(value);
+            if (globals.rotationCacheMB > MaxRotationCacheMB) {
+                globals.rotationCacheMB = MaxRotationCacheMB;
+            }
+        }
+        else if (_stricmp(name, MonitorSoftwareCompositing) == 0) {
+            globals.softwareCompositing = settingValue(value);
+        }
+    }
+    else if (_stricmp(group, KnobsGroup) == 0 && _stricmp(name, KnobsVirtual) == 0) {
+        strcpy(globals.virtualKnobs, value);
+    }
+    else if (_stricmp(group, KnobsGroup) == 0 && _stricmp(name, KnobsRecord) == 0) {
+        strcpy(globals.recordKnobs, value);
+    }
+    else if (_stricmp(group, KnobsGroup) == 0) {
+        KnobSetting knobSetting;
+        strncpy(knobSetting.gpios, name, sizeof(knobSetting.gpios) - 1);
+        knobSetting.gpios[sizeof(knobSetting.gpios) - 1] = '\0';
+        strcpy(knobSetting.curve, value);
+        knobSettings.push_back(knobSetting);
+    }
+    else if (_stricmp(name, RotationSteps) == 0) {
+        // Not part of the layout so kept apart from the group
+        RotationStepsSetting stepsSetting;
+        strcpy(stepsSetting.group, group);
+        stepsSetting.steps = atoi(value);
+        if (stepsSetting.steps < 1 || stepsSetting.steps > MaxRotationSteps) {
+            snprintf(globals.error, sizeof(globals.error), "Settings file group %s %s must be from 1 to %d", group, name, MaxRotationSteps);
+            return;
+        }
+        rotationSteps.push_back(stepsSetting);
+    }
+    else if (groupCount == 0 || strcmp(groups[groupCount - 1].name, group) != 0) {
+        // New group
+        if (groupCount >= MaxGroups) {
+            snprintf(globals.error, sizeof(globals.error), "Settings file has too many groups, %s ignored", group);
+            return;
+        }
+
+        int idx = settingIndex(name);
+        if (idx == -1) {
+            snprintf(globals.error, sizeof(globals.error), "Settings file group %s contains unknown attribute %s", group, name);
+        }
+        else {
+            strcpy(groups[groupCount].name, group);
+            strcpy(groups[groupCount].settingName[idx], name);
+            groups[groupCount].settingVal[idx] = settingValue(value);
+            groups[groupCount].settingsCount = 1;
+            groupCount++;
+        }
     }
     else {
-        printf("Settings file %s not found\n", settingsFile);
+        // Existing group
+        int idx = settingIndex(name);
+        if (idx == -1) {
+            snprintf(globals.error, sizeof(globals.error), "Settings file group %s contains unknown attribute %s", group, name);
+        }
+        else {
+            strcpy(groups[groupCount - 1].settingName[idx], name);
+            groups[groupCount - 1].settingVal[idx] = settingValue(value);
+            groups[groupCount - 1].settingsCount++;
+        }
     }
+}
 
-    groupCount = 0;
-    int level = 0;
-    bool readingName = false;
-    bool readingValue = false;
-    char group[256];
-    char name[256];
-    char value[256];
-
-    group[0] = '\0';
-    int pos = 0;
-    char ch;
-    while ((ch = buf[pos]) != '\0') {
-        if (ch == '{' && !readingName && !readingValue) {
-            level++;
-        }
-        else if (ch == '}' && !readingName && !readingValue) {
-            group[0] = 0;
-            level--;
-        }
-        else if (ch == '"' && !readingValue) {
-            if (readingName) {
-                if (level == 1) {
-                    strcpy(group, name);
-                    name[0] = '\0';
-                }
-                else if (strcmp(name, "Centre") == 0) {
-                    // Ignore "Centre"
-                    while (buf[pos++] != '\n');
+/// <summary>
+/// Re-read the settings file after it has been edited. The new layout
+/// is handed to the main thread which applies any changes.
+/// </summary>
+bool simvars::reloadSettings()
+{
+    std::vector<LayoutSetting> layout;
+    std::vector<LayoutProfile> newProfiles;
+    jsonParser parser;
+    layoutHandler handler(this, &layout, &newProfiles);
+
+    if (!parser.parse(settingsFile, &handler)) {
+        // Runs on the watcher thread so the main thread shows the error
+        std::lock_guard<std::mutex> lock(reloadMutex);
+        parseError(reloadError, sizeof(reloadError), settingsFile, &parser);
+
+        // Don't overwrite the user's edits on exit
+        settingsValid = false;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    reloadedLayout.swap(layout);
+    reloadedProfiles.swap(newProfiles);
+    reloadPending = true;
+
+    // File is valid again so it is safe to save on exit
+    settingsValid = true;
+    return true;
+}
+
+/// <summary>
+/// Returns true if the settings file has been reloaded since the last
+/// call. The returned layout is the one for the current aircraft.
+/// Also shows any error from the last reload.
+/// </summary>
+bool simvars::getReloadedLayout(std::vector<LayoutSetting>* layout)
+{
+    std::lock_guard<std::mutex> lock(reloadMutex);
+
+    if (reloadError[0] != '\0') {
+        showError(reloadError);
+        reloadError[0] = '\0';
+    }
+
+    if (!reloadPending) {
+        return false;
+    }
+
+    // The file replaces everything including the live layout
+    baseLayout.swap(reloadedLayout);
+    profiles.swap(reloadedProfiles);
+    reloadedLayout.clear();
+    reloadedProfiles.clear();
+    reloadPending = false;
+
+    if (profileAircraft[0] == '\0') {
+        activeProfile = -1;
+    }
+    else {
+        activeProfile = findProfile(profileAircraft);
+    }
+    getActiveLayout(layout);
+    return true;
+}
+
+/// <summary>
+/// Returns true if the aircraft needs a different layout profile
+/// to the current one. The current layout is kept so it can be
+/// restored when switching back.
+/// </summary>
+bool simvars::getProfileLayout(const char* aircraft, std::vector<LayoutSetting>* layout)
+{
+    if (aircraft[0] == '\0') {
+        // Keep current layout while no aircraft is loaded
+        return false;
+    }
+
+    strncpy(profileAircraft, aircraft, sizeof(profileAircraft) - 1);
+    profileAircraft[sizeof(profileAircraft) - 1] = '\0';
+
+    int profile = findProfile(aircraft);
+    if (profile == activeProfile) {
+        return false;
+    }
+
+    if (activeProfile == -1) {
+        snapshotLayout(&baseLayout, true);
+    }
+    else {
+        snapshotLayout(&profiles[activeProfile].layout, false);
+    }
+
+    activeProfile = profile;
+    getActiveLayout(layout);
+    return true;
+}
+
+/// <summary>
+/// Returns the index of the first profile whose name the aircraft
+/// title starts with or -1 to use the base layout.
+/// </summary>
+int simvars::findProfile(const char* aircraft)
+{
+    for (int i = 0; i < (int)profiles.size(); i++) {
+        if (strncmp(aircraft, profiles[i].name, strlen(profiles[i].name)) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/// <summary>
+/// Returns the live layout of every group in the settings file
+/// </summary>
+void simvars::getLayout(std::vector<LayoutSetting>* layout)
+{
+    layout->clear();
+    snapshotLayout(layout, true);
+}
+
+void simvars::getActiveLayout(std::vector<LayoutSetting>* layout)
+{
+    if (activeProfile == -1) {
+        *layout = baseLayout;
+    }
+    else {
+        *layout = profiles[activeProfile].layout;
+    }
+}
+
+/// <summary>
+/// Captures the live layout including any changes made by arranging.
+/// Profiles only keep disabled instruments they already contain.
+/// </summary>
+void simvars::snapshotLayout(std::vector<LayoutSetting>* layout, bool allGroups)
+{
+    std::vector<LayoutSetting> prevLayout;
+    prevLayout.swap(*layout);
+
+    for (int groupNum = 0; groupNum < groupCount; groupNum++) {
+        if (!allGroups && groups[groupNum].settingVal[3] != 1) {
+            bool found = false;
+            for (auto const& prevSetting : prevLayout) {
+                if (strcmp(prevSetting.name, groups[groupNum].name) == 0) {
+                    found = true;
+                    break;
                 }
-                readingName = false;
             }
-            else {
-                name[0] = '\0';
-                readingName = true;
+
+            if (!found) {
+                continue;
             }
         }
-        else if (ch == ':' && !readingName && level == 2) {
-            value[0] = '\0';
-            readingValue = true;
-        }
-        else if ((ch == ',' || ch == '\n') && readingValue && level == 2) {
-            if (group[0] != '\0' && name[0] != '\0' && value[0] != '\0') {
-                if (_stricmp(group, DataLinkGroup) == 0) {
-                    if (_stricmp(name, DataLinkHost) == 0) {
-                        strcpy(globals.dataLinkHost, value);
-                    }
-                    else if (_stricmp(name, DataLinkPort) == 0) {
-                        globals.dataLinkPort = settingValue(value);
-                    }
-                    else if (_stricmp(name, DataRateFps) == 0) {
-                        globals.dataRateFps = settingValue(value);
-                    }
-                }
-                else if (_stricmp(group, MonitorGroup) == 0) {
-                    if (_stricmp(name, MonitorStartOn) == 0) {
-                        globals.startOnMonitor = atoi(value);
-                    }
-                    else if (_stricmp(name, MonitorFullscreen) == 0) {
-                        globals.monitorFullscreen = settingValue(value);
-                    }
-                    else if (_stricmp(name, MonitorWidth) == 0) {
-                        globals.monitorWidth = atoi(value);
-                    }
-                    else if (_stricmp(name, MonitorHeight) == 0) {
-                        globals.monitorHeight = atoi(value);
-                    }
-                    else if (_stricmp(name, MonitorPositionX) == 0) {
-                        globals.monitorPositionX = atoi(value);
-                    }
-                    else if (_stricmp(name, MonitorPositionY) == 0) {
-                        globals.monitorPositionY = atoi(value);
-                    }
-                }
-                else if (groupCount == 0 || strcmp(groups[groupCount - 1].name, group) != 0) {
-                    // New group
-                    strcpy(groups[groupCount].name, group);
-                    int idx = settingIndex(name);
-                    if (idx == -1) {
-                        sprintf(globals.error, "Settings file group %s contains unknown attribute %s", group, name);
-                    }
-                    else {
-                        strcpy(groups[groupCount].settingName[idx], name);
-                        groups[groupCount].settingVal[idx] = settingValue(value);
-                        groups[groupCount].settingsCount = 1;
-                        groupCount++;
-                    }
-                }
-                else {
-                    // Existing group
-                    int idx = settingIndex(name);
-                    if (idx == -1) {
-                        sprintf(globals.error, "Settings file group %s contains unknown attribute %s", group, name);
-                    }
-                    else {
-                        strcpy(groups[groupCount - 1].settingName[idx], name);
-                        groups[groupCount - 1].settingVal[idx] = settingValue(value);
-                        groups[groupCount - 1].settingsCount++;
+
+        LayoutSetting setting;
+        memset(&setting, 0, sizeof(setting));
+        strcpy(setting.name, groups[groupNum].name);
+        setting.enabled = (groups[groupNum].settingVal[3] == 1);
+        setting.hasPosition = (groups[groupNum].settingsCount == 4);
+        setting.x = groups[groupNum].settingVal[0];
+        setting.y = groups[groupNum].settingVal[1];
+        setting.size = groups[groupNum].settingVal[2];
+
+        if (setting.enabled) {
+            // Use live values (first match is the one the instrument uses)
+            int found = 0;
+            for (int idx = 0; idx < varCount && found != 7; idx++) {
+                if (varOffset[idx] < 0 && strcmp(varGroup[idx], setting.name) == 0) {
+                    int num = settingIndex(varName[idx]);
+                    if (num >= 0 && num < 3 && (found & (1 << num)) == 0) {
+                        int* val = (num == 0) ? &setting.x : (num == 1) ? &setting.y : &setting.size;
+                        *val = (int)varVal[idx];
+                        found |= 1 << num;
                     }
                 }
             }
-            readingValue = false;
-        }
-        else if (readingName) {
-            int len = (int)strlen(name);
-            name[len] = ch;
-            name[len + 1] = '\0';
-        }
-        else if (readingValue && ch != '"') {
-            int len = (int)strlen(value);
-            if (len != 0 || ch != ' ') {
-                value[len] = ch;
-                value[len + 1] = '\0';
+            setting.hasPosition = setting.hasPosition || found == 7;
+        }
+
+        layout->push_back(setting);
+    }
+}
+
+/// <summary>
+/// Updates the stored and live settings for an instrument from a
+/// reloaded settings file. Returns true if anything changed.
+/// </summary>
+bool simvars::applyLayout(const LayoutSetting* setting)
+{
+    int groupNum = 0;
+    while (groupNum < groupCount && strcmp(groups[groupNum].name, setting->name) != 0) {
+        groupNum++;
+    }
+
+    if (groupNum == groupCount) {
+        // New instrument added to the file
+        if (groupCount >= MaxGroups) {
+            return false;
+        }
+
+        memset(&groups[groupNum], 0, sizeof(SettingsGroup));
+        strcpy(groups[groupNum].name, setting->name);
+        groups[groupNum].settingsCount = 1;
+        groupCount++;
+    }
+
+    SettingsGroup* group = &groups[groupNum];
+    bool changed = false;
+
+    int enabled = setting->enabled ? 1 : 0;
+    if (group->settingVal[3] != enabled) {
+        group->settingVal[3] = enabled;
+        changed = true;
+    }
+    strcpy(group->settingName[3], "Enabled");
+
+    if (!setting->hasPosition) {
+        return changed;
+    }
+
+    int vals[3] = { setting->x, setting->y, setting->size };
+    const char* names[3] = { "Position X", "Position Y", "Size" };
+
+    for (int i = 0; i < 3; i++) {
+        if (group->settingVal[i] != vals[i]) {
+            group->settingVal[i] = vals[i];
+            changed = true;
+        }
+        strcpy(group->settingName[i], names[i]);
+    }
+    group->settingsCount = 4;
+
+    // Instruments pick up live values on their next update
+    for (int idx = 0; idx < varCount; idx++) {
+        if (varOffset[idx] < 0 && strcmp(varGroup[idx], setting->name) == 0) {
+            int num = settingIndex(varName[idx]);
+            if (num >= 0 && num < 3 && varVal[idx] != vals[num]) {
+                varVal[idx] = vals[num];
+                changed = true;
             }
         }
+    }
+
+    return changed;
+}
 
-        pos++;
+/// <summary>
+/// Writes a JSON string value, escaping characters that would end it
+/// early (e.g. backslashes in a Windows path)
+/// </summary>
+static void writeString(FILE* outfile, const char* str)
+{
+    fputc('"', outfile);
+    for (const char* ch = str; *ch != '\0'; ch++) {
+        if (*ch == '"' || *ch == '\\') {
+            fputc('\\', outfile);
+            fputc(*ch, outfile);
+        }
+        else if ((unsigned char)*ch < 0x20) {
+            fprintf(outfile, "\\u%04x", (unsigned char)*ch);
+        }
+        else {
+            fputc(*ch, outfile);
+        }
     }
+    fputc('"', outfile);
 }
 
 void simvars::saveSettings()
 {
+    // Live layout may have been changed by arranging
+    if (activeProfile == -1) {
+        snapshotLayout(&baseLayout, true);
+    }
+    else {
+        snapshotLayout(&profiles[activeProfile].layout, false);
+    }
+
     // Save settings to JSON file
     FILE* outfile = fopen(settingsFile, "w");
     if (outfile)
     {
         fprintf(outfile, "{\n");
         fprintf(outfile, "  \"%s\": {\n", DataLinkGroup);
-        fprintf(outfile, "    \"%s\": \"%s\",\n", DataLinkHost, globals.dataLinkHost);
+        fprintf(outfile, "    \"%s\": ", DataLinkHost);
+        writeString(outfile, globals.dataLinkHost);
+        fprintf(outfile, ",\n");
         fprintf(outfile, "    \"%s\": %d,\n", DataLinkPort, globals.dataLinkPort);
         fprintf(outfile, "    \"%s\": %d\n", DataRateFps, globals.dataRateFps);
         fprintf(outfile, "  },\n");
@@ -221,45 +700,103 @@ void simvars::saveSettings()
         fprintf(outfile, "    \"%s\": %d,\n", MonitorWidth, globals.monitorWidth);
         fprintf(outfile, "    \"%s\": %d,\n", MonitorHeight, globals.monitorHeight);
         fprintf(outfile, "    \"%s\": %d,\n", MonitorPositionX, globals.monitorPositionX);
-        fprintf(outfile, "    \"%s\": %d\n", MonitorPositionY, globals.monitorPositionY);
-        fprintf(outfile, "  },\n");
-
-        int idx = 0;
-        while (idx < groupCount)
-        {
-            if (idx > 0) {
-                // End of previous group
-                fprintf(outfile, ",\n");
+        fprintf(outfile, "    \"%s\": %d,\n", MonitorPositionY, globals.monitorPositionY);
+        fprintf(outfile, "    \"%s\": %d,\n", MonitorRotationCache, globals.rotationCacheMB);
+        if (globals.softwareCompositing) {
+            fprintf(outfile, "    \"%s\": true\n", MonitorSoftwareCompositing);
+        }
+        else {
+            fprintf(outfile, "    \"%s\": false\n", MonitorSoftwareCompositing);
+        }
+        fprintf(outfile, "  }");
+
+        if (!knobSettings.empty() || globals.virtualKnobs[0] != '\0' || globals.recordKnobs[0] != '\0') {
+            const char* separator = "";
+            fprintf(outfile, ",\n");
+            fprintf(outfile, "  \"%s\": {", KnobsGroup);
+            if (globals.virtualKnobs[0] != '\0') {
+                fprintf(outfile, "%s\n    \"%s\": ", separator, KnobsVirtual);
+                writeString(outfile, globals.virtualKnobs);
+                separator = ",";
             }
-
-            // If group is enabled save new (possibly modified) settings otherwise save orig settings
-            if (groups[idx].settingVal[3] == 1) {
-                saveGroup(outfile, groups[idx].name);
+            if (globals.recordKnobs[0] != '\0') {
+                fprintf(outfile, "%s\n    \"%s\": ", separator, KnobsRecord);
+                writeString(outfile, globals.recordKnobs);
+                separator = ",";
             }
-            else {
-                fprintf(outfile, "  \"%s\": {\n", groups[idx].name);
-                if (groups[idx].settingsCount == 4) {
-                    fprintf(outfile, "    \"Enabled\": false,\n");
-                    fprintf(outfile, "    \"%s\": %ld,\n", groups[idx].settingName[0], groups[idx].settingVal[0]);
-                    fprintf(outfile, "    \"%s\": %ld,\n", groups[idx].settingName[1], groups[idx].settingVal[1]);
-                    fprintf(outfile, "    \"%s\": %ld\n", groups[idx].settingName[2], groups[idx].settingVal[2]);
-                }
-                else {
-                    fprintf(outfile, "    \"Enabled\": false\n");
+            for (auto const& knobSetting : knobSettings) {
+                fprintf(outfile, "%s\n    ", separator);
+                writeString(outfile, knobSetting.gpios);
+                fprintf(outfile, ": ");
+                writeString(outfile, knobSetting.curve);
+                separator = ",";
+            }
+            fprintf(outfile, "\n");
+            fprintf(outfile, "  }");
+        }
+
+        saveLayout(outfile, &baseLayout, "  ", true);
+
+        if (!profiles.empty()) {
+            fprintf(outfile, ",\n");
+            fprintf(outfile, "  \"%s\": {", ProfilesGroup);
+
+            for (int i = 0; i < (int)profiles.size(); i++) {
+                if (i > 0) {
+                    fprintf(outfile, ",");
                 }
-                fprintf(outfile, "  }");
+                fprintf(outfile, "\n");
+                fprintf(outfile, "    ");
+                writeString(outfile, profiles[i].name);
+                fprintf(outfile, ": {");
+                saveLayout(outfile, &profiles[i].layout, "      ", false);
+                fprintf(outfile, "\n");
+                fprintf(outfile, "    }");
             }
 
-            idx++;
+            fprintf(outfile, "\n");
+            fprintf(outfile, "  }");
         }
 
-        // End of previous group
         fprintf(outfile, "\n");
         fprintf(outfile, "}\n");
         fclose(outfile);
     }
 }
 
+/// <summary>
+/// Returns the acceleration curve from the Knobs settings for the
+/// knob on the given gpio pins or NULL if it doesn't have one.
+/// </summary>
+const char* simvars::getKnobCurve(int gpio1, int gpio2)
+{
+    char gpios[32];
+    sprintf(gpios, "%d,%d", gpio1, gpio2);
+
+    for (auto const& knobSetting : knobSettings) {
+        if (strcmp(knobSetting.gpios, gpios) == 0) {
+            return knobSetting.curve;
+        }
+    }
+
+    return NULL;
+}
+
+/// <summary>
+/// Returns the number of rotation steps from the instrument's settings
+/// or 0 if it doesn't have any (use the instrument's own default).
+/// </summary>
+int simvars::getRotationSteps(const char* group)
+{
+    for (auto const& stepsSetting : rotationSteps) {
+        if (strcmp(stepsSetting.group, group) == 0) {
+            return stepsSetting.steps;
+        }
+    }
+
+    return 0;
+}
+
 int simvars::settingIndex(const char* attribName)
 {
     if (_stricmp(attribName, "Position X") == 0) {
@@ -310,38 +847,41 @@ void simvars::showCentre(FILE *outfile, const char *group, int x, int y, int siz
     fprintf(outfile, "    \"Centre\": \"cx%+.1fmm,cy%+.1fmm\"", mX, mY);
 }
 
-void simvars::saveGroup(FILE *outfile, const char* group)
+/// <summary>
+/// Writes each instrument in the layout. If the layout follows
+/// another group it needs a comma before its first group.
+/// </summary>
+void simvars::saveLayout(FILE *outfile, const std::vector<LayoutSetting>* layout, const char* indent, bool followsGroup)
 {
-    bool foundGroup = false;
-
-    int idx = 0;
-    while (idx <= varCount)
-    {
-        if (idx < varCount && strcmp(varGroup[idx], group) == 0) {
-            if (!foundGroup) {
-                // Start of group
-                foundGroup = true;
-                fprintf(outfile, "  \"%s\": {\n", group);
-                fprintf(outfile, "    \"Enabled\": true");
-            }
-
-            // Only settings (negative nums) should be saved to the file
-            if (varOffset[idx] < 0) {
-                if (_stricmp(varName[idx], "Position X") == 0) {
-                    //showCentre(outfile, group, varVal[idx], varVal[idx + 1], varVal[idx + 2]);
-                }
-                fprintf(outfile, ",\n");
-                fprintf(outfile, "    \"%s\": %.0f", varName[idx], varVal[idx]);
-            }
+    bool first = true;
+    for (auto const& setting : *layout) {
+        if (followsGroup || !first) {
+            fprintf(outfile, ",");
         }
-        else if (foundGroup) {
-            // End of group
-            fprintf(outfile, "\n");
-            fprintf(outfile, "  }");
-            return;
+        fprintf(outfile, "\n");
+        first = false;
+        fprintf(outfile, "%s", indent);
+        writeString(outfile, setting.name);
+        fprintf(outfile, ": {\n");
+        if (setting.hasPosition) {
+            fprintf(outfile, "%s  \"Enabled\": %s,\n", indent, setting.enabled ? "true" : "false");
+            fprintf(outfile, "%s  \"Position X\": %d,\n", indent, setting.x);
+            fprintf(outfile, "%s  \"Position Y\": %d,\n", indent, setting.y);
+            fprintf(outfile, "%s  \"Size\": %d", indent, setting.size);
+            //showCentre(outfile, setting.name, setting.x, setting.y, setting.size);
+        }
+        else {
+            fprintf(outfile, "%s  \"Enabled\": %s", indent, setting.enabled ? "true" : "false");
         }
 
-        idx++;
+        // Rotation steps belong to the instrument not the profile
+        int steps = (layout == &baseLayout) ? getRotationSteps(setting.name) : 0;
+        if (steps > 0) {
+            fprintf(outfile, ",\n");
+            fprintf(outfile, "%s  \"%s\": %d", indent, RotationSteps, steps);
+        }
+        fprintf(outfile, "\n");
+        fprintf(outfile, "%s}", indent);
     }
 }
 
@@ -530,24 +1070,12 @@ void simvars::doKeypress(int keycode)
 void simvars::addVar(const char* group, const char* name, bool isBool, double scaling, double val)
 {
     // Convert SimVar name to address offset (number of doubles)
-    int offset = 1;
-    for (int i = 0;; i++) {
-        if (SimVarDefs[i][0] == NULL) {
-            sprintf(globals.error, "Unknown SimVar name: %s - %s", group, name);
-            return;
-        }
-
-        if (strcmp(SimVarDefs[i][0], name) == 0) {
-            break;
-        }
-
-        if (strcmp(SimVarDefs[i][1], "string32") == 0) {
-            offset += 4;
-        }
-        else {
-            offset++;
-        }
+    const SimVarDef* def = findSimVar(name);
+    if (def == NULL) {
+        sprintf(globals.error, "Unknown SimVar name: %s - %s", group, name);
+        return;
     }
+    int offset = def->offset / sizeof(double);
 
     // Must not already be added
     int idx = getVarIdx(offset);
@@ -607,29 +1135,34 @@ void simvars::addSetting(const char* group, const char* name)
 /// </summary>
 bool simvars::isEnabled(const char* group)
 {
-    // Get value from loaded settings
-    int val = -1;
-    int groupNum = 0;
-    while (groupNum < groupCount)
-    {
+    for (int groupNum = 0; groupNum < groupCount; groupNum++) {
         if (strcmp(groups[groupNum].name, group) == 0) {
-            val = groups[groupNum].settingVal[3];
-            break;
+            return groups[groupNum].settingVal[3] == 1;
         }
+    }
 
-        groupNum++;
+    return false;
+}
+
+/// <summary>
+/// Adds the instrument to the settings file (disabled) if it isn't
+/// already there so it can be enabled by editing the file.
+/// </summary>
+void simvars::addGroup(const char* group)
+{
+    for (int groupNum = 0; groupNum < groupCount; groupNum++) {
+        if (strcmp(groups[groupNum].name, group) == 0) {
+            return;
+        }
     }
 
-    if (val == -1) {
-        // Add missing instrument to settings file
+    if (groupCount < MaxGroups) {
         strcpy(groups[groupCount].name, group);
         strcpy(groups[groupCount].settingName[0], "Enabled");
         groups[groupCount].settingVal[0] = settingValue("false");
         groups[groupCount].settingsCount = 1;
         groupCount++;
     }
-
-    return (val == 1);
 }
 
 /// <summary>
@@ -700,6 +1233,9 @@ void simvars::write(EVENT_ID eventId, double value)
     if (bytes <= 0) {
         sprintf(globals.error, "Failed to write event %d", eventId);
     }
+    else {
+        latency::eventWritten();
+    }
 }
 
 void resetConnection()
@@ -713,6 +1249,7 @@ void resetConnection()
 
     globals.dataLinked = false;
     globals.connected = false;
+    globals.aircraftTraits = globals.registry->none();
     globals.aircraft = NO_AIRCRAFT;
     strcpy(globals.lastAircraft, "");
 }
@@ -811,6 +1348,7 @@ void dataLink(simvars* thisPtr)
                     }
 
                     processData(thisPtr);
+                    latency::dataReceived();
                 }
                 else {
                     bytes = SOCKET_ERROR;
@@ -846,3 +1384,93 @@ void dataLink(simvars* thisPtr)
     WSACleanup();
 #endif
 }
+
+/// <summary>
+/// A separate thread watches the settings file and reloads it
+/// whenever it is saved so that layout changes can be applied
+/// without restarting.
+/// </summary>
+void settingsWatcher(simvars* thisPtr)
+{
+#ifdef _WIN32
+    // Check modification time every second
+    struct stat fileStat;
+    time_t lastModified = 0;
+    if (stat(thisPtr->settingsFile, &fileStat) == 0) {
+        lastModified = fileStat.st_mtime;
+    }
+
+    while (!globals.quit) {
+        Sleep(1000);
+
+        if (stat(thisPtr->settingsFile, &fileStat) == 0 && fileStat.st_mtime != lastModified) {
+            lastModified = fileStat.st_mtime;
+            thisPtr->reloadSettings();
+        }
+    }
+#else
+    // Watch the directory rather than the file as many editors
+    // save by writing a new file and renaming it.
+    char dir[256];
+    const char* filename = strrchr(thisPtr->settingsFile, '/');
+
+    if (filename == thisPtr->settingsFile) {
+        strcpy(dir, "/");
+        filename++;
+    }
+    else if (filename) {
+        int len = (int)(filename - thisPtr->settingsFile);
+        strncpy(dir, thisPtr->settingsFile, len);
+        dir[len] = '\0';
+        filename++;
+    }
+    else {
+        strcpy(dir, ".");
+        filename = thisPtr->settingsFile;
+    }
+
+    int fd = inotify_init1(IN_NONBLOCK);
+    if (fd == -1) {
+        printf("Settings file watcher not available\n");
+        return;
+    }
+
+    if (inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        printf("Failed to watch settings directory %s\n", dir);
+        close(fd);
+        return;
+    }
+
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd pollFd;
+    pollFd.fd = fd;
+    pollFd.events = POLLIN;
+    bool changed = false;
+
+    while (!globals.quit) {
+        // Wake up regularly to check for quit
+        int ready = poll(&pollFd, 1, changed ? 200 : 500);
+
+        if (ready > 0) {
+            int bytes;
+            while ((bytes = (int)read(fd, events, sizeof(events))) > 0) {
+                char* ptr = events;
+                while (ptr < events + bytes) {
+                    struct inotify_event* event = (struct inotify_event*)ptr;
+                    if (event->len > 0 && strcmp(event->name, filename) == 0) {
+                        changed = true;
+                    }
+                    ptr += sizeof(struct inotify_event) + event->len;
+                }
+            }
+        }
+        else if (ready == 0 && changed) {
+            // Editors can save in several steps so wait until things go quiet
+            changed = false;
+            thisPtr->reloadSettings();
+        }
+    }
+
+    close(fd);
+#endif
+}
@@ -2,6 +2,9 @@
 #define _SIMVARS_H_
 
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
 #ifdef _WIN32
 #include <Windows.h>
 #else
@@ -16,16 +19,73 @@ typedef int SOCKET;
 #endif
 #include "globals.h"
 #include "simvarDefs.h"
+#include "derivedVars.h"
+#include "alerts.h"
 
 extern globalVars globals;
 
+// Set maximum number of instrument groups in the settings file
+const int MaxGroups = 64;
+
+/// <summary>
+/// Position, size and state of an instrument as read from the
+/// settings file when it is reloaded or a profile is selected.
+/// </summary>
+struct LayoutSetting
+{
+    char name[256];
+    bool enabled;
+    bool hasPosition;
+    int x;
+    int y;
+    int size;
+};
+
+/// <summary>
+/// Acceleration curve for the knob on the named gpio pins, e.g.
+/// "20,21": "10:2 25:5 50:10" (steps per second : multiplier)
+/// </summary>
+struct KnobSetting
+{
+    char gpios[32];
+    char curve[64];
+};
+
+/// <summary>
+/// Number of pre-rotated frames in a turn for an instrument's
+/// rotation caches, e.g. "ASI": { "Rotation Steps": 720 }
+/// </summary>
+struct RotationStepsSetting
+{
+    char group[256];
+    int steps;
+};
+
+/// <summary>
+/// A complete instrument layout that is used when the
+/// aircraft title starts with the profile name.
+/// </summary>
+struct LayoutProfile
+{
+    char name[256];
+    std::vector<LayoutSetting> layout;
+};
+
 class simvars {
+    friend class settingsHandler;
+    friend class layoutHandler;
+    friend void settingsWatcher(simvars*);
+
 public:
     SimVars simVars;
+    derivedVars derived;
+    alertEngine alerts;
 
 private:
     std::thread* dataLinkThread = NULL;
+    std::thread* settingsWatcherThread = NULL;
     char settingsFile[256];
+    std::atomic<bool> settingsValid{ true };  // Written by the settings watcher thread
 
     SOCKET writeSockfd = INVALID_SOCKET;
     sockaddr_in writeAddr;
@@ -50,7 +110,21 @@ private:
     };
     
     int groupCount = 0;
-    struct SettingsGroup groups[64] = {};
+    struct SettingsGroup groups[MaxGroups] = {};
+
+    // Layout profiles. The layout that is not currently live is kept here.
+    std::vector<LayoutSetting> baseLayout;
+    std::vector<LayoutProfile> profiles;
+    std::vector<KnobSetting> knobSettings;
+    std::vector<RotationStepsSetting> rotationSteps;
+    int activeProfile = -1;
+    char profileAircraft[sizeof(globalVars::lastAircraft)] = "\0";
+
+    std::mutex reloadMutex;
+    bool reloadPending = false;
+    std::vector<LayoutSetting> reloadedLayout;
+    std::vector<LayoutProfile> reloadedProfiles;
+    char reloadError[256] = "\0";
     
 public:
     simvars(const char *settingsFile);
@@ -61,15 +135,27 @@ public:
     void addSetting(const char* group, const char* name);
     int* readSettings(const char* group, int defaultX, int defaultY, int defaultSize);
     bool isEnabled(const char* group);
+    void addGroup(const char* group);
     void write(EVENT_ID eventId, double value = 0);
+    bool getReloadedLayout(std::vector<LayoutSetting>* layout);
+    void getLayout(std::vector<LayoutSetting>* layout);
+    bool getProfileLayout(const char* aircraft, std::vector<LayoutSetting>* layout);
+    bool applyLayout(const LayoutSetting* setting);
+    const char* getKnobCurve(int gpio1, int gpio2);
+    int getRotationSteps(const char* group);
     
 private:
     void loadSettings();
+    void loadSetting(const char* group, const char* name, const char* value);
     void saveSettings();
+    bool reloadSettings();
     int settingIndex(const char* attribName);
     int settingValue(const char* value);
     void showCentre(FILE* outfile, const char* group, int x, int y, int size);
-    void saveGroup(FILE* outfile, const char* group);
+    void saveLayout(FILE* outfile, const std::vector<LayoutSetting>* layout, const char* indent, bool followsGroup);
+    void snapshotLayout(std::vector<LayoutSetting>* layout, bool allGroups);
+    int findProfile(const char* aircraft);
+    void getActiveLayout(std::vector<LayoutSetting>* layout);
     int getVarIdx(int num);
     bool isCorrectType(int idx);
     void getNextVar();
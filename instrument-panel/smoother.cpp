@@ -0,0 +1,98 @@
+#include <cmath>
+#include "smoother.h"
+#include "globals.h"
+
+extern globalVars globals;
+
+// Stop a long pause (e.g. dragging the window) from being treated as one big step
+const double MaxTimeStep = 0.5;
+
+smoother::smoother(double smoothTime, double maxRate, double snap, double period)
+{
+    this->smoothTime = smoothTime;
+    this->maxRate = maxRate;
+    this->snap = snap;
+    this->period = period;
+}
+
+/// <summary>
+/// Moves value towards target by the amount of time that has
+/// passed since the last update.
+/// </summary>
+void smoother::update(double& value, double target)
+{
+    double now = globals.frameTime;
+    double dt = 0;
+    if (lastTime != 0) {
+        dt = now - lastTime;
+        if (dt > MaxTimeStep) {
+            dt = MaxTimeStep;
+        }
+    }
+    lastTime = now;
+
+    // Stop instrument flipping by a whole turn
+    if (period != 0) {
+        double half = period / 2;
+        while (value - target > half) {
+            value -= period;
+        }
+        while (target - value > half) {
+            value += period;
+        }
+    }
+
+    if (smoothTime <= 0) {
+        double maxChange = maxRate * dt;
+        if (target - value > maxChange) {
+            value += maxChange;
+        }
+        else if (value - target > maxChange) {
+            value -= maxChange;
+        }
+        else {
+            value = target;
+        }
+    }
+    else {
+        // Critically damped spring (see Game Programming Gems 4, 1.10)
+        double omega = 2.0 / smoothTime;
+        double x = omega * dt;
+        double decay = 1.0 / (1.0 + x + 0.48 * x * x + 0.235 * x * x * x);
+
+        double change = value - target;
+        double maxChange = maxRate * smoothTime;
+        if (change > maxChange) {
+            change = maxChange;
+        }
+        else if (change < -maxChange) {
+            change = -maxChange;
+        }
+        double goal = value - change;
+
+        double temp = (velocity + omega * change) * dt;
+        velocity = (velocity - omega * temp) * decay;
+        double newValue = goal + (change + temp) * decay;
+
+        // Don't overshoot
+        if ((target > value) == (newValue > target)) {
+            newValue = target;
+            velocity = 0;
+        }
+        value = newValue;
+    }
+
+    if (fabs(target - value) <= snap) {
+        value = target;
+        velocity = 0;
+    }
+}
+
+/// <summary>
+/// Forget the current speed, e.g. after the value has been
+/// set directly.
+/// </summary>
+void smoother::reset()
+{
+    velocity = 0;
+}
@@ -0,0 +1,30 @@
+#ifndef _SMOOTHER_H_
+#define _SMOOTHER_H_
+
+/// <summary>
+/// Moves a needle towards its target in a way that looks the same
+/// whatever the frame rate. The needle follows a critically damped
+/// spring that settles in roughly smoothTime seconds without
+/// overshooting and never moves faster than maxRate units per second.
+/// A smoothTime of 0 gives a constant rate limit instead.
+/// Once within snap of the target the needle jumps onto it.
+/// If period is set (e.g. 360 for bank angle) the needle takes the
+/// short way round.
+/// </summary>
+class smoother
+{
+private:
+    double smoothTime;
+    double maxRate;
+    double snap;
+    double period;
+    double velocity = 0;
+    double lastTime = 0;
+
+public:
+    smoother(double smoothTime, double maxRate, double snap, double period = 0);
+    void update(double& value, double target);
+    void reset();
+};
+
+#endif // _SMOOTHER_H_
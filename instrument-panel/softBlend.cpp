@@ -0,0 +1,391 @@
+#include <string.h>
+#include <math.h>
+#include <map>
+#include "softBlend.h"
+#include "softBlendKernels.h"
+#include "globals.h"
+
+extern globalVars globals;
+
+struct Upload
+{
+    ALLEGRO_BITMAP* video;
+    int frame;
+};
+
+// Video copies of memory bitmaps that have been drawn onto the display
+static std::map<ALLEGRO_BITMAP*, Upload> uploads;
+
+/// <summary>
+/// Draw a bitmap at the given position with the current blender.
+/// Same as al_draw_bitmap but much quicker for memory bitmaps.
+/// </summary>
+void softBlend::drawBitmap(ALLEGRO_BITMAP* bitmap, float dx, float dy)
+{
+    drawBitmapRegion(bitmap, 0, 0, al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap), dx, dy, 0);
+}
+
+/// <summary>
+/// Same as al_draw_bitmap_region but much quicker for memory bitmaps.
+/// Like Allegro the source region is truncated to whole pixels.
+/// </summary>
+void softBlend::drawBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, int flags)
+{
+    int mode = blendMode(&bitmap, flags);
+
+    if (mode != -1) {
+        if (dx == (int)dx && dy == (int)dy) {
+            if (blend(bitmap, (BlendMode)mode, (int)sx, (int)sy, (int)sw, (int)sh, (int)dx, (int)dy)) {
+                return;
+            }
+        }
+        else {
+            Placement place = { 1, 0, dx, 0, 1, dy };
+            if (sample(bitmap, (BlendMode)mode, (int)sx, (int)sy, (int)sw, (int)sh, &place)) {
+                return;
+            }
+        }
+    }
+
+    al_draw_bitmap_region(bitmap, sx, sy, sw, sh, dx, dy, flags);
+}
+
+/// <summary>
+/// Same as al_draw_scaled_bitmap but much quicker for memory bitmaps
+/// </summary>
+void softBlend::drawScaledBitmap(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, int flags)
+{
+    int mode = blendMode(&bitmap, flags);
+
+    if (mode != -1 && sw != 0 && sh != 0) {
+        Placement place = { dw / sw, 0, dx, 0, dh / sh, dy };
+        if (sample(bitmap, (BlendMode)mode, (int)sx, (int)sy, (int)sw, (int)sh, &place)) {
+            return;
+        }
+    }
+
+    al_draw_scaled_bitmap(bitmap, sx, sy, sw, sh, dx, dy, dw, dh, flags);
+}
+
+/// <summary>
+/// Same as al_draw_rotated_bitmap but much quicker for memory bitmaps
+/// </summary>
+void softBlend::drawRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float angle, int flags)
+{
+    drawScaledRotatedBitmap(bitmap, cx, cy, dx, dy, 1, 1, angle, flags);
+}
+
+/// <summary>
+/// Same as al_draw_scaled_rotated_bitmap but much quicker for memory bitmaps
+/// </summary>
+void softBlend::drawScaledRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags)
+{
+    drawScaledRotatedBitmapRegion(bitmap, 0, 0, al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap), cx, cy, dx, dy, xscale, yscale, angle, flags);
+}
+
+/// <summary>
+/// Same as al_draw_tinted_scaled_rotated_bitmap_region with no tint (e.g.
+/// a needle from an atlas) but much quicker for memory bitmaps. The
+/// centre is relative to the region.
+/// </summary>
+void softBlend::drawScaledRotatedBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags)
+{
+    int mode = blendMode(&bitmap, flags);
+
+    if (mode != -1) {
+        // Scale about the centre, rotate then move the centre to dx, dy
+        double cosAngle = cos(angle);
+        double sinAngle = sin(angle);
+        Placement place;
+        place.xx = xscale * cosAngle;
+        place.xy = -yscale * sinAngle;
+        place.yx = xscale * sinAngle;
+        place.yy = yscale * cosAngle;
+        place.x = dx - place.xx * cx - place.xy * cy;
+        place.y = dy - place.yx * cx - place.yy * cy;
+
+        if (sample(bitmap, (BlendMode)mode, (int)sx, (int)sy, (int)sw, (int)sh, &place)) {
+            return;
+        }
+    }
+
+    al_draw_tinted_scaled_rotated_bitmap_region(bitmap, sx, sy, sw, sh, al_map_rgb(255, 255, 255), cx, cy, dx, dy, xscale, yscale, angle, flags);
+}
+
+/// <summary>
+/// Returns how the bitmap can be blended onto the target here or -1
+/// if it must be left to Allegro. A memory bitmap going onto the
+/// display is swapped for its video copy (and left to Allegro).
+/// </summary>
+int softBlend::blendMode(ALLEGRO_BITMAP** bitmap, int flags)
+{
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    int bitmapFlags = al_get_bitmap_flags(*bitmap);
+
+    if (!(bitmapFlags & ALLEGRO_MEMORY_BITMAP)) {
+        return -1;
+    }
+
+    if (!(al_get_bitmap_flags(target) & ALLEGRO_MEMORY_BITMAP)) {
+        ALLEGRO_BITMAP* video = upload(*bitmap);
+        if (video) {
+            *bitmap = video;
+        }
+        return -1;
+    }
+
+    // Only nearest sampling is done here
+    if (flags != 0 || (bitmapFlags & (ALLEGRO_MIN_LINEAR | ALLEGRO_MAG_LINEAR))) {
+        return -1;
+    }
+
+    if (*bitmap == target || al_get_bitmap_format(*bitmap) != al_get_bitmap_format(target)) {
+        return -1;
+    }
+
+    switch (al_get_bitmap_format(*bitmap)) {
+    case ALLEGRO_PIXEL_FORMAT_ARGB_8888:
+    case ALLEGRO_PIXEL_FORMAT_ABGR_8888:
+    case ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE:
+        break;
+    default:
+        return -1;
+    }
+
+    int op, src, dst, alphaOp, alphaSrc, alphaDst;
+    al_get_separate_blender(&op, &src, &dst, &alphaOp, &alphaSrc, &alphaDst);
+    if (op != ALLEGRO_ADD || alphaOp != op || alphaSrc != src || alphaDst != dst) {
+        return -1;
+    }
+
+    ALLEGRO_TRANSFORM identity;
+    al_identity_transform(&identity);
+    if (memcmp(al_get_current_transform(), &identity, sizeof(identity)) != 0) {
+        return -1;
+    }
+
+    if (src == ALLEGRO_ONE && dst == ALLEGRO_ZERO) {
+        return BLEND_COPY;
+    }
+    else if (src == ALLEGRO_ALPHA && dst == ALLEGRO_INVERSE_ALPHA) {
+        return BLEND_ALPHA;
+    }
+    else if (src == ALLEGRO_DEST_COLOR && dst == ALLEGRO_ZERO) {
+        return BLEND_MULTIPLY;
+    }
+
+    return -1;
+}
+
+/// <summary>
+/// Blend part of a memory bitmap onto the (memory) target bitmap
+/// without scaling. Returns false if it can't be done here so Allegro
+/// should do it.
+/// </summary>
+bool softBlend::blend(ALLEGRO_BITMAP* bitmap, BlendMode mode, int sx, int sy, int width, int height, int dx, int dy)
+{
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+
+    if (sx < 0 || sy < 0 || sx + width > al_get_bitmap_width(bitmap) || sy + height > al_get_bitmap_height(bitmap)) {
+        return false;
+    }
+
+    // Clip to the target's clipping rectangle
+    int clipX, clipY, clipWidth, clipHeight;
+    al_get_clipping_rectangle(&clipX, &clipY, &clipWidth, &clipHeight);
+
+    if (dx < clipX) {
+        sx += clipX - dx;
+        width -= clipX - dx;
+        dx = clipX;
+    }
+    if (dy < clipY) {
+        sy += clipY - dy;
+        height -= clipY - dy;
+        dy = clipY;
+    }
+    if (dx + width > clipX + clipWidth) {
+        width = clipX + clipWidth - dx;
+    }
+    if (dy + height > clipY + clipHeight) {
+        height = clipY + clipHeight - dy;
+    }
+    if (width <= 0 || height <= 0) {
+        return true;
+    }
+
+    ALLEGRO_LOCKED_REGION* srcRegion = al_lock_bitmap_region(bitmap, sx, sy, width, height, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READONLY);
+    if (!srcRegion) {
+        return false;
+    }
+
+    int lockMode = (mode == BLEND_COPY) ? ALLEGRO_LOCK_WRITEONLY : ALLEGRO_LOCK_READWRITE;
+    ALLEGRO_LOCKED_REGION* destRegion = al_lock_bitmap_region(target, dx, dy, width, height, ALLEGRO_PIXEL_FORMAT_ANY, lockMode);
+    if (!destRegion) {
+        al_unlock_bitmap(bitmap);
+        return false;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char* srcRow = (const unsigned char*)srcRegion->data + y * srcRegion->pitch;
+        unsigned char* destRow = (unsigned char*)destRegion->data + y * destRegion->pitch;
+        softBlendKernels::blendRow(mode, srcRow, destRow, width);
+    }
+
+    al_unlock_bitmap(target);
+    al_unlock_bitmap(bitmap);
+    return true;
+}
+
+/// <summary>
+/// Blend part of a memory bitmap onto the (memory) target bitmap
+/// scaled and/or rotated by place, which takes a point in the part
+/// (relative to its top left) to the target. Each target pixel is
+/// given the nearest source pixel to its centre. Returns false if it
+/// can't be done here so Allegro should do it.
+/// </summary>
+bool softBlend::sample(ALLEGRO_BITMAP* bitmap, BlendMode mode, int sx, int sy, int sw, int sh, const Placement* place)
+{
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+
+    if (sx < 0 || sy < 0 || sw <= 0 || sh <= 0 || sx + sw > al_get_bitmap_width(bitmap) || sy + sh > al_get_bitmap_height(bitmap)) {
+        return false;
+    }
+
+    double det = place->xx * place->yy - place->xy * place->yx;
+    if (fabs(det) < 1e-9) {
+        // Squashed flat so nothing to draw
+        return true;
+    }
+
+    // Pixels the placed part covers
+    double cornerX[] = { 0, (double)sw, 0, (double)sw };
+    double cornerY[] = { 0, 0, (double)sh, (double)sh };
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+    for (int i = 0; i < 4; i++) {
+        double x = place->xx * cornerX[i] + place->xy * cornerY[i] + place->x;
+        double y = place->yx * cornerX[i] + place->yy * cornerY[i] + place->y;
+        if (i == 0 || x < minX) minX = x;
+        if (i == 0 || x > maxX) maxX = x;
+        if (i == 0 || y < minY) minY = y;
+        if (i == 0 || y > maxY) maxY = y;
+    }
+
+    // Clip to the target's clipping rectangle
+    int clipX, clipY, clipWidth, clipHeight;
+    al_get_clipping_rectangle(&clipX, &clipY, &clipWidth, &clipHeight);
+
+    int dx = (int)fmax(floor(minX), clipX);
+    int dy = (int)fmax(floor(minY), clipY);
+    int width = (int)fmin(ceil(maxX), clipX + clipWidth) - dx;
+    int height = (int)fmin(ceil(maxY), clipY + clipHeight) - dy;
+    if (width <= 0 || height <= 0) {
+        return true;
+    }
+
+    ALLEGRO_LOCKED_REGION* srcRegion = al_lock_bitmap_region(bitmap, sx, sy, sw, sh, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READONLY);
+    if (!srcRegion) {
+        return false;
+    }
+
+    // Pixels that aren't covered must be kept so always read/write
+    ALLEGRO_LOCKED_REGION* destRegion = al_lock_bitmap_region(target, dx, dy, width, height, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READWRITE);
+    if (!destRegion) {
+        al_unlock_bitmap(bitmap);
+        return false;
+    }
+
+    // Reverse the placement to find where the centre of each target pixel is in the part
+    double x = dx + 0.5 - place->x;
+    double y = dy + 0.5 - place->y;
+    SampleMap map;
+    map.u0 = (place->yy * x - place->xy * y) / det;
+    map.v0 = (place->xx * y - place->yx * x) / det;
+    map.dudx = place->yy / det;
+    map.dvdx = -place->yx / det;
+    map.dudy = -place->xy / det;
+    map.dvdy = place->xx / det;
+
+    softBlendKernels::blendSampled(mode, (const unsigned char*)srcRegion->data, srcRegion->pitch, sw, sh,
+        (unsigned char*)destRegion->data, destRegion->pitch, width, height, &map);
+
+    al_unlock_bitmap(target);
+    al_unlock_bitmap(bitmap);
+    return true;
+}
+
+/// <summary>
+/// Copy a memory bitmap into its video bitmap (created on first use)
+/// so it can be drawn onto the display by the GPU. Bitmaps aren't
+/// changed once they are on the display so it is only copied once a
+/// frame however many times it is drawn.
+/// </summary>
+ALLEGRO_BITMAP* softBlend::upload(ALLEGRO_BITMAP* bitmap)
+{
+    int width = al_get_bitmap_width(bitmap);
+    int height = al_get_bitmap_height(bitmap);
+    ALLEGRO_BITMAP* video = NULL;
+
+    auto found = uploads.find(bitmap);
+    if (found != uploads.end()) {
+        video = found->second.video;
+        if (al_get_bitmap_width(video) != width || al_get_bitmap_height(video) != height) {
+            al_destroy_bitmap(video);
+            uploads.erase(found);
+            video = NULL;
+        }
+        else if (found->second.frame == globals.frameCount) {
+            return video;
+        }
+    }
+
+    if (video == NULL) {
+        int flags = al_get_new_bitmap_flags();
+        al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+        video = al_create_bitmap(width, height);
+        al_set_new_bitmap_flags(flags);
+
+        if (video == NULL) {
+            return NULL;
+        }
+
+        Upload upload;
+        upload.video = video;
+        upload.frame = -1;
+        uploads[bitmap] = upload;
+    }
+
+    ALLEGRO_LOCKED_REGION* srcRegion = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READONLY);
+    if (!srcRegion) {
+        return NULL;
+    }
+
+    ALLEGRO_LOCKED_REGION* destRegion = al_lock_bitmap(video, srcRegion->format, ALLEGRO_LOCK_WRITEONLY);
+    if (!destRegion) {
+        al_unlock_bitmap(bitmap);
+        return NULL;
+    }
+
+    for (int y = 0; y < height; y++) {
+        memcpy((char*)destRegion->data + y * destRegion->pitch, (const char*)srcRegion->data + y * srcRegion->pitch, width * srcRegion->pixel_size);
+    }
+
+    al_unlock_bitmap(video);
+    al_unlock_bitmap(bitmap);
+
+    uploads[bitmap].frame = globals.frameCount;
+    return video;
+}
+
+/// <summary>
+/// Free the video copy of a bitmap that is being destroyed
+/// </summary>
+void softBlend::release(ALLEGRO_BITMAP* bitmap)
+{
+    auto found = uploads.find(bitmap);
+    if (found != uploads.end()) {
+        al_destroy_bitmap(found->second.video);
+        uploads.erase(found);
+    }
+}
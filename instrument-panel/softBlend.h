@@ -0,0 +1,53 @@
+#ifndef _SOFT_BLEND_H_
+#define _SOFT_BLEND_H_
+
+#include <allegro5/allegro.h>
+#include "softBlendKernels.h"
+
+/// <summary>
+/// Where a bitmap goes on the target: point (u, v) in the bitmap is
+/// drawn at (xx * u + xy * v + x, yx * u + yy * v + y).
+/// </summary>
+struct Placement
+{
+    double xx;
+    double xy;
+    double x;
+    double yx;
+    double yy;
+    double y;
+};
+
+/// <summary>
+/// Software compositing for hosts without usable GL. Allegro draws
+/// memory bitmaps one pixel at a time through a generic blender (and
+/// scaled or rotated ones through its triangle filler) so the draws
+/// instruments make every frame are done here instead. Plain blits are
+/// blended with SSE2 or NEON a row at a time and scaled or rotated
+/// ones use nearest sampling at pixel centres, like GL, gathered a row
+/// at a time then blended the same way. Only the copy, normal (alpha)
+/// and multiply blenders are handled. Anything else, e.g. flipped or
+/// filtered bitmaps, is passed on to Allegro.
+///
+/// A memory bitmap drawn onto the display is uploaded into a video
+/// bitmap first as Allegro would otherwise read back the display.
+/// </summary>
+class softBlend
+{
+public:
+    static void drawBitmap(ALLEGRO_BITMAP* bitmap, float dx, float dy);
+    static void drawBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, int flags);
+    static void drawScaledBitmap(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, int flags);
+    static void drawRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float angle, int flags);
+    static void drawScaledRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags);
+    static void drawScaledRotatedBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags);
+    static void release(ALLEGRO_BITMAP* bitmap);
+
+private:
+    static int blendMode(ALLEGRO_BITMAP** bitmap, int flags);
+    static bool blend(ALLEGRO_BITMAP* bitmap, BlendMode mode, int sx, int sy, int width, int height, int dx, int dy);
+    static bool sample(ALLEGRO_BITMAP* bitmap, BlendMode mode, int sx, int sy, int sw, int sh, const Placement* place);
+    static ALLEGRO_BITMAP* upload(ALLEGRO_BITMAP* bitmap);
+};
+
+#endif // _SOFT_BLEND_H_
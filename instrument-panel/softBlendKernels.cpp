@@ -0,0 +1,245 @@
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "softBlendKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFT_BLEND_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SOFT_BLEND_NEON
+#endif
+
+/// <summary>
+/// x / 255 rounded to nearest for x up to 65025 (same as GL)
+/// </summary>
+static inline unsigned char div255(unsigned int x)
+{
+    x += 128;
+    return (unsigned char)((x + (x >> 8)) >> 8);
+}
+
+#ifdef SOFT_BLEND_SSE2
+
+static inline __m128i div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/// <summary>
+/// Blend 2 pixels (already unpacked to 16 bits per channel)
+/// </summary>
+static inline __m128i alpha2(__m128i src, __m128i dest)
+{
+    // Alpha is the top byte of each pixel in both supported formats
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i invAlpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return div255x8(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dest, invAlpha)));
+}
+
+#endif // SOFT_BLEND_SSE2
+
+/// <summary>
+/// Result = src * srcAlpha + dest * (1 - srcAlpha) for all four channels
+/// </summary>
+static void alphaRow(const unsigned char* src, unsigned char* dest, int pixels)
+{
+    int i = 0;
+
+#if defined(SOFT_BLEND_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i * 4));
+        __m128i lo = alpha2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        __m128i hi = alpha2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+        _mm_storeu_si128((__m128i*)(dest + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(SOFT_BLEND_NEON)
+    for (; i + 8 <= pixels; i += 8) {
+        uint8x8x4_t s = vld4_u8(src + i * 4);
+        uint8x8x4_t d = vld4_u8(dest + i * 4);
+        uint8x8_t alpha = s.val[3];
+        uint8x8_t invAlpha = vmvn_u8(alpha);
+        for (int c = 0; c < 4; c++) {
+            uint16x8_t t = vmlal_u8(vmull_u8(s.val[c], alpha), d.val[c], invAlpha);
+            d.val[c] = vraddhn_u16(t, vrshrq_n_u16(t, 8));
+        }
+        vst4_u8(dest + i * 4, d);
+    }
+#endif
+
+    for (; i < pixels; i++) {
+        const unsigned char* s = src + i * 4;
+        unsigned char* d = dest + i * 4;
+        unsigned int alpha = s[3];
+        for (int c = 0; c < 4; c++) {
+            d[c] = div255(s[c] * alpha + d[c] * (255 - alpha));
+        }
+    }
+}
+
+/// <summary>
+/// Result = src * dest for all four channels
+/// </summary>
+static void multiplyRow(const unsigned char* src, unsigned char* dest, int pixels)
+{
+    int i = 0;
+
+#if defined(SOFT_BLEND_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i * 4));
+        __m128i lo = div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero)));
+        __m128i hi = div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero)));
+        _mm_storeu_si128((__m128i*)(dest + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(SOFT_BLEND_NEON)
+    for (; i + 4 <= pixels; i += 4) {
+        uint8x16_t s = vld1q_u8(src + i * 4);
+        uint8x16_t d = vld1q_u8(dest + i * 4);
+        uint16x8_t lo = vmull_u8(vget_low_u8(s), vget_low_u8(d));
+        uint16x8_t hi = vmull_u8(vget_high_u8(s), vget_high_u8(d));
+        uint8x16_t result = vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+        vst1q_u8(dest + i * 4, result);
+    }
+#endif
+
+    for (int c = i * 4; c < pixels * 4; c++) {
+        dest[c] = div255(src[c] * dest[c]);
+    }
+}
+
+/// <summary>
+/// Blend a row of pixels onto the destination
+/// </summary>
+void softBlendKernels::blendRow(BlendMode mode, const unsigned char* src, unsigned char* dest, int pixels)
+{
+    switch (mode) {
+    case BLEND_COPY:
+        memcpy(dest, src, pixels * 4);
+        break;
+    case BLEND_ALPHA:
+        alphaRow(src, dest, pixels);
+        break;
+    case BLEND_MULTIPLY:
+        multiplyRow(src, dest, pixels);
+        break;
+    }
+}
+
+/// <summary>
+/// Returns true if destination pixel x samples inside the source.
+/// The source is a half-open rectangle so a pixel centre exactly on
+/// the right or bottom edge isn't drawn.
+/// </summary>
+static inline bool inside(double uRow, double vRow, const SampleMap* map, int srcWidth, int srcHeight, int x)
+{
+    double u = uRow + map->dudx * x;
+    double v = vRow + map->dvdx * x;
+    return u >= 0 && u < srcWidth && v >= 0 && v < srcHeight;
+}
+
+/// <summary>
+/// Narrows [*start, *end) to the pixels where pos + step * x is in
+/// [0, limit). Only needs to be roughly right as the caller trims the
+/// span exactly afterwards.
+/// </summary>
+static void narrowSpan(double pos, double step, int limit, int* start, int* end)
+{
+    if (step == 0) {
+        if (pos < 0 || pos >= limit) {
+            *end = *start;
+        }
+        return;
+    }
+
+    double x1 = -pos / step;
+    double x2 = (limit - pos) / step;
+    if (x1 > x2) {
+        double swap = x1;
+        x1 = x2;
+        x2 = swap;
+    }
+
+    // Clamp before converting so huge values can't overflow
+    x1 = fmin(fmax(x1, *start - 1.0), *end + 1.0);
+    x2 = fmin(fmax(x2, *start - 1.0), *end + 1.0);
+
+    int first = (int)ceil(x1);
+    int last = (int)ceil(x2);
+    if (first > *start) {
+        *start = first;
+    }
+    if (last < *end) {
+        *end = last;
+    }
+}
+
+/// <summary>
+/// Draws a scaled and/or rotated source onto the destination using
+/// nearest sampling at each destination pixel centre, i.e. what GL
+/// does with ALLEGRO_MIN/MAG_LINEAR off. Only pixels whose centre
+/// falls inside the source are drawn. Each row is worked out as one
+/// span, the source pixels for it gathered and then blended in one go.
+/// </summary>
+void softBlendKernels::blendSampled(BlendMode mode, const unsigned char* src, int srcPitch, int srcWidth, int srcHeight,
+    unsigned char* dest, int destPitch, int destWidth, int destHeight, const SampleMap* map)
+{
+    static std::vector<unsigned int> gathered;
+    if ((int)gathered.size() < destWidth) {
+        gathered.resize(destWidth);
+    }
+
+    for (int y = 0; y < destHeight; y++) {
+        double uRow = map->u0 + map->dudy * y;
+        double vRow = map->v0 + map->dvdy * y;
+
+        // Rough span first then made exact. Samples along a row move
+        // steadily in one direction so the pixels inside are one span.
+        int start = 0;
+        int end = destWidth;
+        narrowSpan(uRow, map->dudx, srcWidth, &start, &end);
+        narrowSpan(vRow, map->dvdx, srcHeight, &start, &end);
+        start = std::min(std::max(start, 0), destWidth);
+        end = std::min(std::max(end, start), destWidth);
+
+        while (start < end && !inside(uRow, vRow, map, srcWidth, srcHeight, start)) {
+            start++;
+        }
+        while (end > start && !inside(uRow, vRow, map, srcWidth, srcHeight, end - 1)) {
+            end--;
+        }
+        if (start == end) {
+            // Rounding can leave a single edge pixel just outside the rough span
+            if (start > 0 && inside(uRow, vRow, map, srcWidth, srcHeight, start - 1)) {
+                start--;
+            }
+            else if (end < destWidth && inside(uRow, vRow, map, srcWidth, srcHeight, end)) {
+                end++;
+            }
+            else {
+                continue;
+            }
+        }
+        while (start > 0 && inside(uRow, vRow, map, srcWidth, srcHeight, start - 1)) {
+            start--;
+        }
+        while (end < destWidth && inside(uRow, vRow, map, srcWidth, srcHeight, end)) {
+            end++;
+        }
+
+        for (int x = start; x < end; x++) {
+            // Clamped in case the compiler rounds this differently to inside()
+            int u = std::min((int)(uRow + map->dudx * x), srcWidth - 1);
+            int v = std::min((int)(vRow + map->dvdx * x), srcHeight - 1);
+            memcpy(&gathered[x - start], src + v * srcPitch + u * 4, 4);
+        }
+
+        blendRow(mode, (const unsigned char*)gathered.data(), dest + y * destPitch + start * 4, end - start);
+    }
+}
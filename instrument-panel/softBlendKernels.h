@@ -0,0 +1,39 @@
+#ifndef _SOFT_BLEND_KERNELS_H_
+#define _SOFT_BLEND_KERNELS_H_
+
+enum BlendMode {
+    BLEND_COPY,
+    BLEND_ALPHA,
+    BLEND_MULTIPLY
+};
+
+/// <summary>
+/// Where each destination pixel centre samples the source. Source
+/// position u of destination pixel (x, y) is (u0 + dudy * y) + dudx * x
+/// and the same for v. The nearest source pixel is used (no filtering).
+/// </summary>
+struct SampleMap
+{
+    double u0;
+    double v0;
+    double dudx;
+    double dvdx;
+    double dudy;
+    double dvdy;
+};
+
+/// <summary>
+/// Pixel kernels used by softBlend. They work on raw 32 bit pixels
+/// (alpha in the top byte) and know nothing about Allegro so they can
+/// be checked on their own (see checks/softBlendCheck.cpp).
+/// Results are rounded the same way as GL.
+/// </summary>
+class softBlendKernels
+{
+public:
+    static void blendRow(BlendMode mode, const unsigned char* src, unsigned char* dest, int pixels);
+    static void blendSampled(BlendMode mode, const unsigned char* src, int srcPitch, int srcWidth, int srcHeight,
+        unsigned char* dest, int destPitch, int destWidth, int destHeight, const SampleMap* map);
+};
+
+#endif // _SOFT_BLEND_KERNELS_H_
@@ -18,6 +18,20 @@ g++ -o instrument-panel -I . -I instruments \
     globals.cpp \
     knobs.cpp \
     instrument.cpp \
+    softBlend.cpp \
+    softBlendKernels.cpp \
+    rotationCache.cpp \
+    qualityGovernor.cpp \
+    instrumentFactory.cpp \
+    alerts.cpp \
+    derivedVars.cpp \
+    aircraftRegistry.cpp \
+    numericDisplay.cpp \
+    calibration.cpp \
+    calibrationTables.cpp \
+    smoother.cpp \
+    latency.cpp \
+    jsonParser.cpp \
     instruments/adf.cpp \
     instruments/adi.cpp \
     instruments/alt.cpp \
@@ -34,7 +48,7 @@ g++ -o instrument-panel -I . -I instruments \
     instruments/tc.cpp \
     instruments/trimFlaps.cpp \
     instruments/trimFlaps2.cpp \
-    instruments/vac.cpp \
+    instruments/gauge.cpp \
     instruments/vor1.cpp \
     instruments/vor2.cpp \
     instruments/vsi.cpp \
@@ -42,7 +56,6 @@ g++ -o instrument-panel -I . -I instruments \
     instruments/alternate/altFast.cpp \
     instruments/alternate/asiFast.cpp \
     instruments/alternate/asiSupersonic.cpp \
-    instruments/alternate/gForce.cpp \
     instruments/alternate/rpmPercent.cpp \
     instruments/alternate/vsiExtreme.cpp \
     instruments/learjet/adiLearjet.cpp \
@@ -59,4 +72,7 @@ g++ -o instrument-panel -I . -I instruments \
 strip instrument-panel
 echo fs-restart
 fs-restart
+echo Running checks
+g++ -o checks/softBlendCheck -I . checks/softBlendCheck.cpp softBlendKernels.cpp && checks/softBlendCheck || exit
+g++ -o checks/calibrationCheck -I . checks/calibrationCheck.cpp calibration.cpp calibrationTables.cpp && checks/calibrationCheck || exit
 echo Done
@@ -5,6 +5,7 @@ mkdir release/$rel
 cp instrument-panel/instrument-panel release/$rel
 cp -rp instrument-panel/bitmaps release/$rel
 cp -rp instrument-panel/settings release/$rel
+cp -rp instrument-panel/gauges release/$rel
 sudo chown pi:pi release/$rel/settings/*.json
 dos2unix release/$rel/settings/*.json
 cd release